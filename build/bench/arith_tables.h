@@ -0,0 +1,148 @@
+/* Generated by mp-gen from tools/bench/arith.mpg, do not edit. */
+
+#ifndef ARITH_TABLES_H
+# define ARITH_TABLES_H
+
+# include "lr_parser.h"
+
+/**
+ * @brief Token IDs.
+ */
+enum e_arith_token
+{
+	ARITH_TOK_NUM,
+	ARITH_TOK_PLUS,
+	ARITH_TOK_MINUS,
+	ARITH_TOK_STAR,
+	ARITH_TOK_SLASH,
+	ARITH_TOK_LPAREN,
+	ARITH_TOK_RPAREN,
+	ARITH_TOK_END,
+};
+
+/**
+ * @brief Production IDs.
+ */
+enum e_arith_prod
+{
+	ARITH_PROD_EXPR_0,	/**< expr : expr PLUS term */
+	ARITH_PROD_EXPR_1,	/**< expr : expr MINUS term */
+	ARITH_PROD_EXPR_2,	/**< expr : term */
+	ARITH_PROD_TERM_0,	/**< term : term STAR factor */
+	ARITH_PROD_TERM_1,	/**< term : term SLASH factor */
+	ARITH_PROD_TERM_2,	/**< term : factor */
+	ARITH_PROD_FACTOR_0,	/**< factor : LPAREN expr RPAREN */
+	ARITH_PROD_FACTOR_1,	/**< factor : MINUS factor */
+	ARITH_PROD_FACTOR_2,	/**< factor : NUM */
+};
+
+# define ARITH_TOKEN_COUNT	8
+# define ARITH_PROD_COUNT	9
+# define ARITH_STATE_COUNT	18
+
+# define ARITH_PROD_EXPR_0_SIZE	3
+# define ARITH_PROD_EXPR_1_SIZE	3
+# define ARITH_PROD_EXPR_2_SIZE	1
+# define ARITH_PROD_TERM_0_SIZE	3
+# define ARITH_PROD_TERM_1_SIZE	3
+# define ARITH_PROD_TERM_2_SIZE	1
+# define ARITH_PROD_FACTOR_0_SIZE	3
+# define ARITH_PROD_FACTOR_1_SIZE	2
+# define ARITH_PROD_FACTOR_2_SIZE	1
+
+# if (MP_ID_BITS == 8 && (ARITH_STATE_COUNT >= 255 \
+	|| ARITH_PROD_COUNT >= 255)) || (MP_ID_BITS == 16 \
+	&& (ARITH_STATE_COUNT >= 65535 || ARITH_PROD_COUNT >= 65535))
+#  error "arith tables need a larger MP_ID_BITS"
+# endif
+# if MP_ACTION_BITS == 16 && (ARITH_STATE_COUNT > 16384 \
+	|| ARITH_PROD_COUNT > 16384)
+#  error "arith tables need MP_ACTION_BITS == 32"
+# endif
+
+# define ARITH_SHIFT(id)	LR_PACK_ACTION(ACTION_SHIFT, id)
+# define ARITH_REDUCE(id)	LR_PACK_ACTION(ACTION_REDUCE, id)
+# define ARITH_ERROR	LR_PACK_ACTION(ACTION_ERROR, 0)
+# define ARITH_ACCEPT	LR_PACK_ACTION(ACTION_ACCEPT, 0)
+
+static const t_lr_prod_id	arith_default_reduce[] = {
+	LR_PROD_NONE, 8, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE,
+	5, 7, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE,
+	LR_PROD_NONE, 6, LR_PROD_NONE, LR_PROD_NONE, 3, 4,
+};
+
+static const size_t	arith_action_base[] = {
+	0, 1, 0, 0, 2, 3, 1, 1, 9, 0, 0, 0, 0, 1, 3, 3, 1, 1,
+};
+
+static const t_lr_packed_action	arith_action_next[] = {
+	ARITH_SHIFT(1), ARITH_ERROR, ARITH_SHIFT(2), ARITH_SHIFT(9),
+	ARITH_SHIFT(10), ARITH_SHIFT(3), ARITH_SHIFT(11), ARITH_SHIFT(12),
+	ARITH_ERROR, ARITH_ACCEPT, ARITH_SHIFT(9), ARITH_SHIFT(10), ARITH_ERROR,
+	ARITH_ERROR, ARITH_ERROR, ARITH_SHIFT(13), ARITH_ERROR,
+};
+
+static const t_lr_packed_action	arith_action_defaults[] = {
+	ARITH_ERROR, ARITH_REDUCE(8), ARITH_ERROR, ARITH_ERROR, ARITH_ERROR,
+	ARITH_REDUCE(2), ARITH_REDUCE(5), ARITH_REDUCE(7), ARITH_ERROR,
+	ARITH_ERROR, ARITH_ERROR, ARITH_ERROR, ARITH_ERROR, ARITH_REDUCE(6),
+	ARITH_REDUCE(0), ARITH_REDUCE(1), ARITH_REDUCE(3), ARITH_REDUCE(4),
+};
+
+static const t_lr_token_id	arith_action_check[] = {
+	0, -1, 2, 1, 2, 5, 3, 4, -1, 7, 1, 2, -1, -1, -1, 6, -1,
+};
+
+static const size_t	arith_goto_base[] = {
+	0, 0, 0, 1, 1, 1, 2, 2, 2,
+};
+
+static const t_lr_state_id	arith_goto_next[] = {
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 8, 7, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 14, 15,
+	LR_STATE_NONE, 16, 17, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE,
+};
+
+static const t_lr_state_id	arith_goto_defaults[] = {
+	4, 4, 4, 5, 5, 5, 6, 6, 6,
+};
+
+static const t_lr_state_id	arith_goto_check[] = {
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 3, 2, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 9, 10,
+	LR_STATE_NONE, 11, 12, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE,
+};
+
+static const t_lr_comb_action	arith_action_comb = {
+	arith_action_base, arith_action_next, arith_action_defaults,
+	arith_action_check, 17,
+};
+
+static const t_lr_comb_goto	arith_goto_comb = {
+	arith_goto_base, arith_goto_next, arith_goto_defaults,
+	arith_goto_check, 20,
+};
+
+/**
+ * @brief Initializer of the fields of a t_lr_grammar.
+ */
+# define ARITH_TABLES	.action_comb = &arith_action_comb, \
+	.goto_comb = &arith_goto_comb, \
+	.default_reduce = arith_default_reduce, \
+	.state_count = ARITH_STATE_COUNT, .token_count = ARITH_TOKEN_COUNT, \
+	.prod_count = ARITH_PROD_COUNT
+
+/**
+ * @brief Initializer of the t_lr_prod_cb of a production.
+ */
+# define ARITH_PROD(name, cb, free_cb)	\
+	[ARITH_PROD_ ## name] = {cb, ARITH_PROD_ ## name ## _SIZE, free_cb}
+
+# undef ARITH_SHIFT
+# undef ARITH_REDUCE
+# undef ARITH_ERROR
+# undef ARITH_ACCEPT
+
+#endif
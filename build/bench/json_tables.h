@@ -0,0 +1,180 @@
+/* Generated by mp-gen from tools/bench/json.mpg, do not edit. */
+
+#ifndef JSON_TABLES_H
+# define JSON_TABLES_H
+
+# include "lr_parser.h"
+
+/**
+ * @brief Token IDs.
+ */
+enum e_json_token
+{
+	JSON_TOK_LBRACE,
+	JSON_TOK_RBRACE,
+	JSON_TOK_LBRACKET,
+	JSON_TOK_RBRACKET,
+	JSON_TOK_COLON,
+	JSON_TOK_COMMA,
+	JSON_TOK_STRING,
+	JSON_TOK_NUMBER,
+	JSON_TOK_TRUE,
+	JSON_TOK_FALSE,
+	JSON_TOK_NULL,
+	JSON_TOK_END,
+};
+
+/**
+ * @brief Production IDs.
+ */
+enum e_json_prod
+{
+	JSON_PROD_VALUE_0,	/**< value : object */
+	JSON_PROD_VALUE_1,	/**< value : array */
+	JSON_PROD_VALUE_2,	/**< value : STRING */
+	JSON_PROD_VALUE_3,	/**< value : NUMBER */
+	JSON_PROD_VALUE_4,	/**< value : TRUE */
+	JSON_PROD_VALUE_5,	/**< value : FALSE */
+	JSON_PROD_VALUE_6,	/**< value : NULL */
+	JSON_PROD_OBJECT_0,	/**< object : LBRACE RBRACE */
+	JSON_PROD_OBJECT_1,	/**< object : LBRACE members RBRACE */
+	JSON_PROD_MEMBERS_0,	/**< members : pair */
+	JSON_PROD_MEMBERS_1,	/**< members : members COMMA pair */
+	JSON_PROD_PAIR_0,	/**< pair : STRING COLON value */
+	JSON_PROD_ARRAY_0,	/**< array : LBRACKET RBRACKET */
+	JSON_PROD_ARRAY_1,	/**< array : LBRACKET elements RBRACKET */
+	JSON_PROD_ELEMENTS_0,	/**< elements : value */
+	JSON_PROD_ELEMENTS_1,	/**< elements : elements COMMA value */
+};
+
+# define JSON_TOKEN_COUNT	12
+# define JSON_PROD_COUNT	16
+# define JSON_STATE_COUNT	26
+
+# define JSON_PROD_VALUE_0_SIZE	1
+# define JSON_PROD_VALUE_1_SIZE	1
+# define JSON_PROD_VALUE_2_SIZE	1
+# define JSON_PROD_VALUE_3_SIZE	1
+# define JSON_PROD_VALUE_4_SIZE	1
+# define JSON_PROD_VALUE_5_SIZE	1
+# define JSON_PROD_VALUE_6_SIZE	1
+# define JSON_PROD_OBJECT_0_SIZE	2
+# define JSON_PROD_OBJECT_1_SIZE	3
+# define JSON_PROD_MEMBERS_0_SIZE	1
+# define JSON_PROD_MEMBERS_1_SIZE	3
+# define JSON_PROD_PAIR_0_SIZE	3
+# define JSON_PROD_ARRAY_0_SIZE	2
+# define JSON_PROD_ARRAY_1_SIZE	3
+# define JSON_PROD_ELEMENTS_0_SIZE	1
+# define JSON_PROD_ELEMENTS_1_SIZE	3
+
+# if (MP_ID_BITS == 8 && (JSON_STATE_COUNT >= 255 \
+	|| JSON_PROD_COUNT >= 255)) || (MP_ID_BITS == 16 \
+	&& (JSON_STATE_COUNT >= 65535 || JSON_PROD_COUNT >= 65535))
+#  error "json tables need a larger MP_ID_BITS"
+# endif
+# if MP_ACTION_BITS == 16 && (JSON_STATE_COUNT > 16384 \
+	|| JSON_PROD_COUNT > 16384)
+#  error "json tables need MP_ACTION_BITS == 32"
+# endif
+
+# define JSON_SHIFT(id)	LR_PACK_ACTION(ACTION_SHIFT, id)
+# define JSON_REDUCE(id)	LR_PACK_ACTION(ACTION_REDUCE, id)
+# define JSON_ERROR	LR_PACK_ACTION(ACTION_ERROR, 0)
+# define JSON_ACCEPT	LR_PACK_ACTION(ACTION_ACCEPT, 0)
+
+static const t_lr_prod_id	json_default_reduce[] = {
+	LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE, 2, 3, 4, 5, 6, LR_PROD_NONE, 0,
+	1, 7, LR_PROD_NONE, LR_PROD_NONE, 9, 12, 14, LR_PROD_NONE, LR_PROD_NONE,
+	8, LR_PROD_NONE, 13, LR_PROD_NONE, 11, 10, 15,
+};
+
+static const size_t	json_action_base[] = {
+	0, 10, 12, 1, 1, 1, 1, 1, 2, 1, 1, 1, 13, 22, 1, 1, 1, 21, 0, 1, 19, 1,
+	0, 1, 1, 1,
+};
+
+static const t_lr_packed_action	json_action_next[] = {
+	JSON_SHIFT(1), JSON_ERROR, JSON_SHIFT(2), JSON_ERROR, JSON_ERROR,
+	JSON_ERROR, JSON_SHIFT(3), JSON_SHIFT(4), JSON_SHIFT(5), JSON_SHIFT(6),
+	JSON_SHIFT(7), JSON_SHIFT(11), JSON_SHIFT(1), JSON_ACCEPT, JSON_SHIFT(2),
+	JSON_SHIFT(15), JSON_SHIFT(12), JSON_SHIFT(18), JSON_SHIFT(3),
+	JSON_SHIFT(4), JSON_SHIFT(5), JSON_SHIFT(6), JSON_SHIFT(7),
+	JSON_SHIFT(19), JSON_SHIFT(21), JSON_SHIFT(12), JSON_SHIFT(22),
+	JSON_SHIFT(20), JSON_ERROR, JSON_ERROR, JSON_ERROR, JSON_ERROR,
+	JSON_ERROR, JSON_ERROR,
+};
+
+static const t_lr_packed_action	json_action_defaults[] = {
+	JSON_ERROR, JSON_ERROR, JSON_ERROR, JSON_REDUCE(2), JSON_REDUCE(3),
+	JSON_REDUCE(4), JSON_REDUCE(5), JSON_REDUCE(6), JSON_ERROR,
+	JSON_REDUCE(0), JSON_REDUCE(1), JSON_REDUCE(7), JSON_ERROR, JSON_ERROR,
+	JSON_REDUCE(9), JSON_REDUCE(12), JSON_REDUCE(14), JSON_ERROR, JSON_ERROR,
+	JSON_REDUCE(8), JSON_ERROR, JSON_REDUCE(13), JSON_ERROR, JSON_REDUCE(11),
+	JSON_REDUCE(10), JSON_REDUCE(15),
+};
+
+static const t_lr_token_id	json_action_check[] = {
+	0, -1, 2, -1, -1, -1, 6, 7, 8, 9, 10, 1, 0, 11, 2, 3, 6, 4, 6, 7, 8, 9,
+	10, 1, 3, 6, 5, 5, -1, -1, -1, -1, -1, -1,
+};
+
+static const size_t	json_goto_base[] = {
+	0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 3, 1, 1, 1, 1,
+};
+
+static const t_lr_state_id	json_goto_next[] = {
+	LR_STATE_NONE, LR_STATE_NONE, 16, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, 23, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 25, 24,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE,
+};
+
+static const t_lr_state_id	json_goto_defaults[] = {
+	8, 8, 8, 8, 8, 8, 8, 9, 9, 13, 13, 14, 10, 10, 17, 17,
+};
+
+static const t_lr_state_id	json_goto_check[] = {
+	LR_STATE_NONE, LR_STATE_NONE, 2, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, 18, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 22, 20,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE,
+};
+
+static const t_lr_comb_action	json_action_comb = {
+	json_action_base, json_action_next, json_action_defaults,
+	json_action_check, 34,
+};
+
+static const t_lr_comb_goto	json_goto_comb = {
+	json_goto_base, json_goto_next, json_goto_defaults,
+	json_goto_check, 29,
+};
+
+/**
+ * @brief Initializer of the fields of a t_lr_grammar.
+ */
+# define JSON_TABLES	.action_comb = &json_action_comb, \
+	.goto_comb = &json_goto_comb, \
+	.default_reduce = json_default_reduce, \
+	.state_count = JSON_STATE_COUNT, .token_count = JSON_TOKEN_COUNT, \
+	.prod_count = JSON_PROD_COUNT
+
+/**
+ * @brief Initializer of the t_lr_prod_cb of a production.
+ */
+# define JSON_PROD(name, cb, free_cb)	\
+	[JSON_PROD_ ## name] = {cb, JSON_PROD_ ## name ## _SIZE, free_cb}
+
+# undef JSON_SHIFT
+# undef JSON_REDUCE
+# undef JSON_ERROR
+# undef JSON_ACCEPT
+
+#endif
@@ -0,0 +1,266 @@
+/* Generated by mp-gen from tools/bench/stmt.mpg, do not edit. */
+
+#ifndef STMT_TABLES_H
+# define STMT_TABLES_H
+
+# include "lr_parser.h"
+
+/**
+ * @brief Token IDs.
+ */
+enum e_stmt_token
+{
+	STMT_TOK_ID,
+	STMT_TOK_NUM,
+	STMT_TOK_IF,
+	STMT_TOK_ELSE,
+	STMT_TOK_WHILE,
+	STMT_TOK_RETURN,
+	STMT_TOK_ASSIGN,
+	STMT_TOK_SEMI,
+	STMT_TOK_COMMA,
+	STMT_TOK_LPAREN,
+	STMT_TOK_RPAREN,
+	STMT_TOK_LBRACE,
+	STMT_TOK_RBRACE,
+	STMT_TOK_AND,
+	STMT_TOK_LT,
+	STMT_TOK_EQ,
+	STMT_TOK_PLUS,
+	STMT_TOK_MINUS,
+	STMT_TOK_STAR,
+	STMT_TOK_SLASH,
+	STMT_TOK_END,
+};
+
+/**
+ * @brief Production IDs.
+ */
+enum e_stmt_prod
+{
+	STMT_PROD_PROGRAM_0,	/**< program : stmts */
+	STMT_PROD_STMTS_0,	/**< stmts : stmt */
+	STMT_PROD_STMTS_1,	/**< stmts : stmts stmt */
+	STMT_PROD_STMT_0,	/**< stmt : ID ASSIGN expr SEMI */
+	STMT_PROD_STMT_1,	/**< stmt : expr SEMI */
+	STMT_PROD_STMT_2,	/**< stmt : IF LPAREN expr RPAREN block */
+	STMT_PROD_STMT_3,	/**< stmt : IF LPAREN expr RPAREN block ELSE block */
+	STMT_PROD_STMT_4,	/**< stmt : WHILE LPAREN expr RPAREN block */
+	STMT_PROD_STMT_5,	/**< stmt : RETURN expr SEMI */
+	STMT_PROD_STMT_6,	/**< stmt : block */
+	STMT_PROD_BLOCK_0,	/**< block : LBRACE RBRACE */
+	STMT_PROD_BLOCK_1,	/**< block : LBRACE stmts RBRACE */
+	STMT_PROD_EXPR_0,	/**< expr : expr AND cmp */
+	STMT_PROD_EXPR_1,	/**< expr : cmp */
+	STMT_PROD_CMP_0,	/**< cmp : sum LT sum */
+	STMT_PROD_CMP_1,	/**< cmp : sum EQ sum */
+	STMT_PROD_CMP_2,	/**< cmp : sum */
+	STMT_PROD_SUM_0,	/**< sum : sum PLUS prod */
+	STMT_PROD_SUM_1,	/**< sum : sum MINUS prod */
+	STMT_PROD_SUM_2,	/**< sum : prod */
+	STMT_PROD_PROD_0,	/**< prod : prod STAR unary */
+	STMT_PROD_PROD_1,	/**< prod : prod SLASH unary */
+	STMT_PROD_PROD_2,	/**< prod : unary */
+	STMT_PROD_UNARY_0,	/**< unary : MINUS unary */
+	STMT_PROD_UNARY_1,	/**< unary : primary */
+	STMT_PROD_PRIMARY_0,	/**< primary : NUM */
+	STMT_PROD_PRIMARY_1,	/**< primary : ID */
+	STMT_PROD_PRIMARY_2,	/**< primary : ID LPAREN RPAREN */
+	STMT_PROD_PRIMARY_3,	/**< primary : ID LPAREN args RPAREN */
+	STMT_PROD_PRIMARY_4,	/**< primary : LPAREN expr RPAREN */
+	STMT_PROD_ARGS_0,	/**< args : expr */
+	STMT_PROD_ARGS_1,	/**< args : args COMMA expr */
+};
+
+# define STMT_TOKEN_COUNT	21
+# define STMT_PROD_COUNT	32
+# define STMT_STATE_COUNT	64
+
+# define STMT_PROD_PROGRAM_0_SIZE	1
+# define STMT_PROD_STMTS_0_SIZE	1
+# define STMT_PROD_STMTS_1_SIZE	2
+# define STMT_PROD_STMT_0_SIZE	4
+# define STMT_PROD_STMT_1_SIZE	2
+# define STMT_PROD_STMT_2_SIZE	5
+# define STMT_PROD_STMT_3_SIZE	7
+# define STMT_PROD_STMT_4_SIZE	5
+# define STMT_PROD_STMT_5_SIZE	3
+# define STMT_PROD_STMT_6_SIZE	1
+# define STMT_PROD_BLOCK_0_SIZE	2
+# define STMT_PROD_BLOCK_1_SIZE	3
+# define STMT_PROD_EXPR_0_SIZE	3
+# define STMT_PROD_EXPR_1_SIZE	1
+# define STMT_PROD_CMP_0_SIZE	3
+# define STMT_PROD_CMP_1_SIZE	3
+# define STMT_PROD_CMP_2_SIZE	1
+# define STMT_PROD_SUM_0_SIZE	3
+# define STMT_PROD_SUM_1_SIZE	3
+# define STMT_PROD_SUM_2_SIZE	1
+# define STMT_PROD_PROD_0_SIZE	3
+# define STMT_PROD_PROD_1_SIZE	3
+# define STMT_PROD_PROD_2_SIZE	1
+# define STMT_PROD_UNARY_0_SIZE	2
+# define STMT_PROD_UNARY_1_SIZE	1
+# define STMT_PROD_PRIMARY_0_SIZE	1
+# define STMT_PROD_PRIMARY_1_SIZE	1
+# define STMT_PROD_PRIMARY_2_SIZE	3
+# define STMT_PROD_PRIMARY_3_SIZE	4
+# define STMT_PROD_PRIMARY_4_SIZE	3
+# define STMT_PROD_ARGS_0_SIZE	1
+# define STMT_PROD_ARGS_1_SIZE	3
+
+# if (MP_ID_BITS == 8 && (STMT_STATE_COUNT >= 255 \
+	|| STMT_PROD_COUNT >= 255)) || (MP_ID_BITS == 16 \
+	&& (STMT_STATE_COUNT >= 65535 || STMT_PROD_COUNT >= 65535))
+#  error "stmt tables need a larger MP_ID_BITS"
+# endif
+# if MP_ACTION_BITS == 16 && (STMT_STATE_COUNT > 16384 \
+	|| STMT_PROD_COUNT > 16384)
+#  error "stmt tables need MP_ACTION_BITS == 32"
+# endif
+
+# define STMT_SHIFT(id)	LR_PACK_ACTION(ACTION_SHIFT, id)
+# define STMT_REDUCE(id)	LR_PACK_ACTION(ACTION_REDUCE, id)
+# define STMT_ERROR	LR_PACK_ACTION(ACTION_ERROR, 0)
+# define STMT_ACCEPT	LR_PACK_ACTION(ACTION_ACCEPT, 0)
+
+static const t_lr_prod_id	stmt_default_reduce[] = {
+	LR_PROD_NONE, LR_PROD_NONE, 25, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE,
+	LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE, 1,
+	9, LR_PROD_NONE, 13, LR_PROD_NONE, LR_PROD_NONE, 22, 24, LR_PROD_NONE,
+	LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE,
+	LR_PROD_NONE, 10, LR_PROD_NONE, 23, 2, 4, LR_PROD_NONE, LR_PROD_NONE,
+	LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE,
+	LR_PROD_NONE, 27, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE,
+	8, 29, 11, 12, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE,
+	20, 21, 3, LR_PROD_NONE, 28, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE,
+	LR_PROD_NONE, 7, LR_PROD_NONE, 6,
+};
+
+static const size_t	stmt_action_base[] = {
+	0, 1, 2, 3, 4, 14, 14, 24, 14, 7, 0, 2, 2, 9, 2, 23, 25, 2, 2, 14, 45,
+	14, 14, 10, 35, 8, 2, 56, 2, 2, 2, 14, 14, 14, 14, 14, 14, 14, 40, 2, 17,
+	41, 53, 59, 2, 2, 2, 2, 54, 54, 25, 25, 2, 2, 2, 14, 2, 21, 21, 17, 5, 2,
+	21, 2,
+};
+
+static const t_lr_packed_action	stmt_action_next[] = {
+	STMT_SHIFT(1), STMT_SHIFT(2), STMT_SHIFT(3), STMT_ERROR, STMT_SHIFT(4),
+	STMT_SHIFT(5), STMT_ERROR, STMT_SHIFT(19), STMT_SHIFT(62), STMT_SHIFT(6),
+	STMT_SHIFT(20), STMT_SHIFT(7), STMT_SHIFT(21), STMT_SHIFT(22),
+	STMT_SHIFT(23), STMT_SHIFT(2), STMT_SHIFT(30), STMT_SHIFT(8),
+	STMT_SHIFT(45), STMT_SHIFT(20), STMT_ERROR, STMT_SHIFT(31),
+	STMT_SHIFT(31), STMT_SHIFT(6), STMT_SHIFT(1), STMT_SHIFT(2),
+	STMT_SHIFT(3), STMT_ACCEPT, STMT_SHIFT(4), STMT_SHIFT(5), STMT_SHIFT(31),
+	STMT_SHIFT(8), STMT_SHIFT(7), STMT_SHIFT(6), STMT_ERROR, STMT_SHIFT(7),
+	STMT_SHIFT(26), STMT_SHIFT(32), STMT_SHIFT(33), STMT_SHIFT(34),
+	STMT_SHIFT(35), STMT_SHIFT(8), STMT_SHIFT(44), STMT_SHIFT(36),
+	STMT_SHIFT(37), STMT_SHIFT(23), STMT_SHIFT(2), STMT_SHIFT(54),
+	STMT_SHIFT(31), STMT_SHIFT(55), STMT_ERROR, STMT_SHIFT(56), STMT_ERROR,
+	STMT_SHIFT(31), STMT_SHIFT(6), STMT_SHIFT(39), STMT_SHIFT(1),
+	STMT_SHIFT(2), STMT_SHIFT(3), STMT_ERROR, STMT_SHIFT(4), STMT_SHIFT(5),
+	STMT_SHIFT(8), STMT_SHIFT(57), STMT_ERROR, STMT_SHIFT(6), STMT_SHIFT(31),
+	STMT_SHIFT(7), STMT_SHIFT(46), STMT_SHIFT(58), STMT_SHIFT(34),
+	STMT_SHIFT(35), STMT_SHIFT(31), STMT_SHIFT(8), STMT_ERROR, STMT_ERROR,
+	STMT_ERROR, STMT_ERROR, STMT_ERROR, STMT_ERROR,
+};
+
+static const t_lr_packed_action	stmt_action_defaults[] = {
+	STMT_ERROR, STMT_REDUCE(26), STMT_REDUCE(25), STMT_ERROR, STMT_ERROR,
+	STMT_ERROR, STMT_ERROR, STMT_ERROR, STMT_ERROR, STMT_ERROR,
+	STMT_REDUCE(0), STMT_REDUCE(1), STMT_REDUCE(9), STMT_ERROR,
+	STMT_REDUCE(13), STMT_REDUCE(16), STMT_REDUCE(19), STMT_REDUCE(22),
+	STMT_REDUCE(24), STMT_ERROR, STMT_ERROR, STMT_ERROR, STMT_ERROR,
+	STMT_REDUCE(26), STMT_ERROR, STMT_ERROR, STMT_REDUCE(10), STMT_ERROR,
+	STMT_REDUCE(23), STMT_REDUCE(2), STMT_REDUCE(4), STMT_ERROR, STMT_ERROR,
+	STMT_ERROR, STMT_ERROR, STMT_ERROR, STMT_ERROR, STMT_ERROR, STMT_ERROR,
+	STMT_REDUCE(27), STMT_REDUCE(30), STMT_ERROR, STMT_ERROR, STMT_ERROR,
+	STMT_REDUCE(8), STMT_REDUCE(29), STMT_REDUCE(11), STMT_REDUCE(12),
+	STMT_REDUCE(14), STMT_REDUCE(15), STMT_REDUCE(17), STMT_REDUCE(18),
+	STMT_REDUCE(20), STMT_REDUCE(21), STMT_REDUCE(3), STMT_ERROR,
+	STMT_REDUCE(28), STMT_ERROR, STMT_ERROR, STMT_REDUCE(31), STMT_REDUCE(5),
+	STMT_REDUCE(7), STMT_ERROR, STMT_REDUCE(6),
+};
+
+static const t_lr_token_id	stmt_action_check[] = {
+	0, 1, 2, -1, 4, 5, -1, 6, 3, 9, 9, 11, 9, 9, 0, 1, 7, 17, 10, 9, -1, 13,
+	13, 9, 0, 1, 2, 20, 4, 5, 13, 17, 11, 9, -1, 11, 12, 14, 15, 16, 17, 17,
+	7, 18, 19, 0, 1, 7, 13, 8, -1, 10, -1, 13, 9, 10, 0, 1, 2, -1, 4, 5, 17,
+	10, -1, 9, 13, 11, 12, 10, 16, 17, 13, 17, -1, -1, -1, -1, -1, -1,
+};
+
+static const size_t	stmt_goto_base[] = {
+	0, 1, 1, 2, 2, 2, 2, 2, 2, 2, 3, 3, 4, 4, 5, 5, 5, 6, 6, 6, 7, 7, 7, 8,
+	8, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static const t_lr_state_id	stmt_goto_next[] = {
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 27, 24, 25,
+	LR_STATE_NONE, 29, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 28,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, 38, 40, 42, 43, LR_STATE_NONE,
+	LR_STATE_NONE, 29, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 47, LR_STATE_NONE, 48, 49,
+	LR_STATE_NONE, 50, 51, LR_STATE_NONE, 52, 53, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 59, 60, 61,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 63, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE,
+};
+
+static const t_lr_state_id	stmt_goto_defaults[] = {
+	9, 10, 10, 11, 11, 11, 11, 11, 11, 11, 12, 12, 13, 13, 14, 14, 14, 15,
+	15, 15, 16, 16, 16, 17, 17, 18, 18, 18, 18, 18, 41, 41,
+};
+
+static const t_lr_state_id	stmt_goto_check[] = {
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 7, 5, 6,
+	LR_STATE_NONE, 10, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 8,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, 19, 20, 21, 22, LR_STATE_NONE,
+	LR_STATE_NONE, 27, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 31, LR_STATE_NONE, 32, 33,
+	LR_STATE_NONE, 34, 35, LR_STATE_NONE, 36, 37, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 55, 57, 58,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 62, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE,
+};
+
+static const t_lr_comb_action	stmt_action_comb = {
+	stmt_action_base, stmt_action_next, stmt_action_defaults,
+	stmt_action_check, 80,
+};
+
+static const t_lr_comb_goto	stmt_goto_comb = {
+	stmt_goto_base, stmt_goto_next, stmt_goto_defaults,
+	stmt_goto_check, 72,
+};
+
+/**
+ * @brief Initializer of the fields of a t_lr_grammar.
+ */
+# define STMT_TABLES	.action_comb = &stmt_action_comb, \
+	.goto_comb = &stmt_goto_comb, \
+	.default_reduce = stmt_default_reduce, \
+	.state_count = STMT_STATE_COUNT, .token_count = STMT_TOKEN_COUNT, \
+	.prod_count = STMT_PROD_COUNT
+
+/**
+ * @brief Initializer of the t_lr_prod_cb of a production.
+ */
+# define STMT_PROD(name, cb, free_cb)	\
+	[STMT_PROD_ ## name] = {cb, STMT_PROD_ ## name ## _SIZE, free_cb}
+
+# undef STMT_SHIFT
+# undef STMT_REDUCE
+# undef STMT_ERROR
+# undef STMT_ACCEPT
+
+#endif
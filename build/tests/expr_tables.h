@@ -0,0 +1,143 @@
+/* Generated by mp-gen from tests/expr.mpg, do not edit. */
+
+#ifndef EXPR_TABLES_H
+# define EXPR_TABLES_H
+
+# include "lr_parser.h"
+
+/**
+ * @brief Token IDs.
+ */
+enum e_expr_token
+{
+	EXPR_TOK_NUM,
+	EXPR_TOK_PLUS,
+	EXPR_TOK_STAR,
+	EXPR_TOK_MINUS,
+	EXPR_TOK_LPAREN,
+	EXPR_TOK_RPAREN,
+	EXPR_TOK_END,
+};
+
+/**
+ * @brief Production IDs.
+ */
+enum e_expr_prod
+{
+	EXPR_PROD_EXPR_0,	/**< expr : expr PLUS term */
+	EXPR_PROD_EXPR_1,	/**< expr : term */
+	EXPR_PROD_TERM_0,	/**< term : term STAR unary */
+	EXPR_PROD_TERM_1,	/**< term : unary */
+	EXPR_PROD_UNARY_0,	/**< unary : MINUS unary */
+	EXPR_PROD_UNARY_1,	/**< unary : atom */
+	EXPR_PROD_ATOM_0,	/**< atom : LPAREN expr RPAREN */
+	EXPR_PROD_ATOM_1,	/**< atom : NUM */
+};
+
+# define EXPR_TOKEN_COUNT	7
+# define EXPR_PROD_COUNT	8
+# define EXPR_STATE_COUNT	15
+
+# define EXPR_PROD_EXPR_0_SIZE	3
+# define EXPR_PROD_EXPR_1_SIZE	1
+# define EXPR_PROD_TERM_0_SIZE	3
+# define EXPR_PROD_TERM_1_SIZE	1
+# define EXPR_PROD_UNARY_0_SIZE	2
+# define EXPR_PROD_UNARY_1_SIZE	1
+# define EXPR_PROD_ATOM_0_SIZE	3
+# define EXPR_PROD_ATOM_1_SIZE	1
+
+# if (MP_ID_BITS == 8 && (EXPR_STATE_COUNT >= 255 \
+	|| EXPR_PROD_COUNT >= 255)) || (MP_ID_BITS == 16 \
+	&& (EXPR_STATE_COUNT >= 65535 || EXPR_PROD_COUNT >= 65535))
+#  error "expr tables need a larger MP_ID_BITS"
+# endif
+# if MP_ACTION_BITS == 16 && (EXPR_STATE_COUNT > 16384 \
+	|| EXPR_PROD_COUNT > 16384)
+#  error "expr tables need MP_ACTION_BITS == 32"
+# endif
+
+# define EXPR_SHIFT(id)	LR_PACK_ACTION(ACTION_SHIFT, id)
+# define EXPR_REDUCE(id)	LR_PACK_ACTION(ACTION_REDUCE, id)
+# define EXPR_ERROR	LR_PACK_ACTION(ACTION_ERROR, 0)
+# define EXPR_ACCEPT	LR_PACK_ACTION(ACTION_ACCEPT, 0)
+
+static const t_lr_prod_id	expr_default_reduce[] = {
+	LR_PROD_NONE, 7, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE,
+	3, 5, 4, LR_PROD_NONE, LR_PROD_NONE, LR_PROD_NONE, 6, LR_PROD_NONE, 2,
+};
+
+static const size_t	expr_action_base[] = {
+	0, 1, 0, 0, 4, 5, 1, 1, 1, 7, 0, 0, 1, 5, 1,
+};
+
+static const t_lr_packed_action	expr_action_next[] = {
+	EXPR_SHIFT(1), EXPR_ERROR, EXPR_ERROR, EXPR_SHIFT(2), EXPR_SHIFT(3),
+	EXPR_SHIFT(10), EXPR_ERROR, EXPR_SHIFT(11), EXPR_SHIFT(10), EXPR_ERROR,
+	EXPR_ACCEPT, EXPR_ERROR, EXPR_SHIFT(12), EXPR_ERROR,
+};
+
+static const t_lr_packed_action	expr_action_defaults[] = {
+	EXPR_ERROR, EXPR_REDUCE(7), EXPR_ERROR, EXPR_ERROR, EXPR_ERROR,
+	EXPR_REDUCE(1), EXPR_REDUCE(3), EXPR_REDUCE(5), EXPR_REDUCE(4),
+	EXPR_ERROR, EXPR_ERROR, EXPR_ERROR, EXPR_REDUCE(6), EXPR_REDUCE(0),
+	EXPR_REDUCE(2),
+};
+
+static const t_lr_token_id	expr_action_check[] = {
+	0, -1, -1, 3, 4, 1, -1, 2, 1, -1, 6, -1, 5, -1,
+};
+
+static const size_t	expr_goto_base[] = {
+	0, 0, 1, 1, 2, 2, 3, 3,
+};
+
+static const t_lr_state_id	expr_goto_next[] = {
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 9, 8, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, 13, LR_STATE_NONE, 14, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE,
+};
+
+static const t_lr_state_id	expr_goto_defaults[] = {
+	4, 4, 5, 5, 6, 6, 7, 7,
+};
+
+static const t_lr_state_id	expr_goto_check[] = {
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, 3, 2, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, 10, LR_STATE_NONE, 11, LR_STATE_NONE, LR_STATE_NONE,
+	LR_STATE_NONE, LR_STATE_NONE,
+};
+
+static const t_lr_comb_action	expr_action_comb = {
+	expr_action_base, expr_action_next, expr_action_defaults,
+	expr_action_check, 14,
+};
+
+static const t_lr_comb_goto	expr_goto_comb = {
+	expr_goto_base, expr_goto_next, expr_goto_defaults,
+	expr_goto_check, 18,
+};
+
+/**
+ * @brief Initializer of the fields of a t_lr_grammar.
+ */
+# define EXPR_TABLES	.action_comb = &expr_action_comb, \
+	.goto_comb = &expr_goto_comb, \
+	.default_reduce = expr_default_reduce, \
+	.state_count = EXPR_STATE_COUNT, .token_count = EXPR_TOKEN_COUNT, \
+	.prod_count = EXPR_PROD_COUNT
+
+/**
+ * @brief Initializer of the t_lr_prod_cb of a production.
+ */
+# define EXPR_PROD(name, cb, free_cb)	\
+	[EXPR_PROD_ ## name] = {cb, EXPR_PROD_ ## name ## _SIZE, free_cb}
+
+# undef EXPR_SHIFT
+# undef EXPR_REDUCE
+# undef EXPR_ERROR
+# undef EXPR_ACCEPT
+
+#endif
@@ -13,6 +13,12 @@ objdir=build
 outdir=bin
 cflags=
 ldflags=
+id_bits=
+action_bits=
+stack_inline=
+token_ref=
+stats=
+trace=
 
 # ---
 # Help message
@@ -30,6 +36,14 @@ Build options:
   --optimize-disable       disable optimization
   --objdir=OBJDIR          directory for all object (default: ./build)
   --outdir=OUTDIR          directory for all output executable (default : ./bin)
+  --id-bits=BITS           width of state/production IDs: 8, 16 or 32 (default: 32)
+  --action-bits=BITS       width of packed actions: 16 or 32 (default: 32)
+  --stack-inline=ITEMS     stack items stored inline in the stack (default: 0)
+  --token-ref              store token indexes on the stack instead of tokens
+  --stats                  count shifts, reductions and callback time per
+                           state and production (see lr_parser_stats)
+  --trace                  record parser actions in a trace ring (see
+                           lr_parser_set_trace and mp-gen --replay)
 Other tweaks:
   --cflags=CFLAGS            some more compilation flags
   --ldflags=LDFLAGS          some more linker flags
@@ -59,6 +73,12 @@ for arg ; do case "$arg" in
 --outdir=*) outdir="${arg#*=}" ;;
 --cflags=*) cflags="${arg#*=}" ;;
 --ldflags=*) ldflags="${arg#*=}" ;;
+--id-bits=*) id_bits="${arg#*=}" ;;
+--action-bits=*) action_bits="${arg#*=}" ;;
+--stack-inline=*) stack_inline="${arg#*=}" ;;
+--token-ref) token_ref=y ;;
+--stats) stats=y ;;
+--trace) trace=y ;;
 *) echo "Unknown option: ${arg#*=}";exit 1 ;;
 esac; done
 
@@ -85,6 +105,12 @@ DEBUG := $debug
 OPTIMIZE := $optimize
 OBJDIR := $objdir
 OUTDIR := $outdir
+ID_BITS := $id_bits
+ACTION_BITS := $action_bits
+STACK_INLINE := $stack_inline
+TOKEN_REF := $token_ref
+STATS := $stats
+TRACE := $trace
 # Other tweaks
 CMOREFLAGS := $cflags
 LDMOREFLAGS := $ldflags
@@ -0,0 +1,222 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lr_action.h                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 11:02:17 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 11:02:17 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file lr_action.h
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Parser actions and their table encodings.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef LR_ACTION_H
+# define LR_ACTION_H
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+# include <stddef.h>
+# include <stdint.h>
+
+# include "lr_token.h"
+# include "lr_type.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Configuration.                                                         * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Width in bits of a packed action (16 or 32).
+ *
+ * A packed action holds the action type in its low LR_ACTION_TYPE_BITS bits
+ * and the shift state or reduce production in the remaining bits.
+ */
+# ifndef MP_ACTION_BITS
+#  define MP_ACTION_BITS 32
+# endif
+
+# if MP_ACTION_BITS == 16
+
+/**
+ * @brief Packed action, type bits and payload in one word.
+ */
+typedef uint16_t	t_lr_packed_action;
+
+# elif MP_ACTION_BITS == 32
+
+typedef uint32_t	t_lr_packed_action;
+
+# else
+
+#  error MP_ACTION_BITS must be 16 or 32 !
+
+# endif
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Type of LR parser action.
+ *
+ * Defines the possible actions the parser can take when processing a token.
+ */
+typedef enum e_lr_action_type
+{
+	ACTION_SHIFT,	/**< Shift action: push token onto stack. */
+	ACTION_REDUCE,	/**< Reduce action: apply production rule. */
+	ACTION_ERROR,	/**< Error action: syntax error encountered. */
+	ACTION_ACCEPT,	/**< Accept action: parsing completed successfully. */
+	ACTION__COUNT,	/**< Number of action types. */
+}	t_lr_action_type;
+
+/**
+ * @brief Union containing data for parser actions.
+ *
+ * Holds either the target state ID for shift actions or the production ID
+ * for reduce actions.
+ */
+typedef union u_lr_action_data
+{
+	t_lr_state_id	shift_id;	/**< Target state ID for shift actions. */
+	t_lr_prod_id	reduce_id;	/**< Production ID for reduce actions. */
+}	t_lr_action_data;
+
+/**
+ * @brief Parser action structure.
+ *
+ * Represents an action to be taken by the parser, including its type
+ * and associated data.
+ */
+typedef struct s_lr_action
+{
+	t_lr_action_type	type;	/**< Type of action. */
+	t_lr_action_data	data;	/**< Data associated with the action. */
+}	t_lr_action;
+
+/**
+ * @brief Comb-vector compressed action table.
+ *
+ * Row-displacement encoding of the state × token action table. Each state
+ * owns a displacement in base; the action for (state, token) is stored in
+ * next[base[state] + token] when check[base[state] + token] equals token,
+ * otherwise the state default action applies. Rows with identical entries
+ * share the same displacement.
+ */
+typedef struct s_lr_comb_action
+{
+	const size_t				*base;		/**< Row displacement per state. */
+	const t_lr_packed_action	*next;		/**< Action stored in each slot. */
+	const t_lr_packed_action	*defaults;	/**< Default action per state. */
+	const t_lr_token_id			*check;		/**< Token owning each slot. */
+	size_t						size;		/**< Number of slots. */
+}	t_lr_comb_action;
+
+/**
+ * @brief Comb-vector compressed goto table.
+ *
+ * Row-displacement encoding of the goto table, with one row per production
+ * and one column per state. The goto for (state, prod) is stored in
+ * next[base[prod] + state] when check[base[prod] + state] equals state,
+ * otherwise the production default goto applies.
+ */
+typedef struct s_lr_comb_goto
+{
+	const size_t		*base;		/**< Row displacement per production. */
+	const t_lr_state_id	*next;		/**< Goto state stored in each slot. */
+	const t_lr_state_id	*defaults;	/**< Default goto per production. */
+	const t_lr_state_id	*check;		/**< State owning each slot. */
+	size_t				size;		/**< Number of slots. */
+}	t_lr_comb_goto;
+
+/**
+ * @brief Precomputed chain of unit reductions.
+ *
+ * With the top item in state top over an item in state under, and the
+ * token token_id ahead, the parser reduces the top item by prods[first]
+ * up to prods[first + count - 1] in place, then moves it to state. Every
+ * unit reduction is a step, with or without callback, and states[first + k]
+ * is the state prods[first + k] reduces in, for counters and traces.
+ */
+typedef struct s_lr_chain
+{
+	t_lr_state_id	under;		/**< State of the item under the top one. */
+	t_lr_state_id	top;		/**< State of the top item. */
+	t_lr_token_id	token_id;	/**< Token ahead, -1 for an empty slot. */
+	t_lr_state_id	state;		/**< State of the top item after the chain. */
+	uint32_t		first;		/**< First production in prods. */
+	uint32_t		count;		/**< Number of productions. */
+}	t_lr_chain;
+
+/**
+ * @brief Hash table of the reduce chains of a grammar.
+ */
+typedef struct s_lr_chains
+{
+	const t_lr_chain	*slots;		/**< Open addressing slots. */
+	const t_lr_state_id	*states;	/**< State each production reduces in. */
+	const t_lr_prod_id	*prods;		/**< Productions of every chain. */
+	size_t				mask;		/**< Number of slots minus one. */
+	size_t				count;		/**< Number of chains. */
+}	t_lr_chains;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Packed action helpers.                                                 * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Number of low bits holding the action type in a packed action.
+ */
+# define LR_ACTION_TYPE_BITS	2
+
+/**
+ * @brief Largest state or production ID a packed action can carry.
+ */
+# define LR_PACKED_ID_MAX	\
+	((t_lr_packed_action)-1 >> LR_ACTION_TYPE_BITS)
+
+/**
+ * @brief Build a packed action from a type and a state or production ID.
+ */
+# define LR_PACK_ACTION(type, id)	\
+	((t_lr_packed_action)(((t_lr_packed_action)(id) << LR_ACTION_TYPE_BITS) \
+	| (t_lr_packed_action)(type)))
+
+/**
+ * @brief Get the action type of a packed action.
+ */
+# define LR_PACKED_TYPE(packed)	\
+	((t_lr_action_type)((packed) & ((1 << LR_ACTION_TYPE_BITS) - 1)))
+
+/**
+ * @brief Get the state or production ID of a packed action.
+ */
+# define LR_PACKED_ID(packed)	\
+	((packed) >> LR_ACTION_TYPE_BITS)
+
+/**
+ * @brief Expand a packed action into a t_lr_action.
+ */
+# define LR_UNPACK_ACTION(packed)	\
+	((t_lr_action){.type = LR_PACKED_TYPE(packed), \
+	.data.shift_id = LR_PACKED_ID(packed)})
+
+#endif
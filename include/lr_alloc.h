@@ -0,0 +1,113 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lr_alloc.h                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:12:30 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 18:12:30 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file lr_alloc.h
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Pluggable allocator interface.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef LR_ALLOC_H
+# define LR_ALLOC_H
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+# include <stddef.h>
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Allocator structure.
+ *
+ * Memory callbacks with the opaque state they receive. realloc behaves like
+ * the libc one: on failure it returns NULL and leaves ptr untouched. The
+ * sizes given to realloc and free are the ones the block was requested
+ * with, so size-aware allocators (pools, bump allocators) need no header.
+ */
+typedef struct s_lr_allocator
+{
+	void	*(*alloc)(void *state, size_t size);								/**< Allocate size bytes. */
+	void	*(*realloc)(void *state, void *ptr, size_t oldsize, size_t newsize);	/**< Resize a block. */
+	void	(*free)(void *state, void *ptr, size_t size);						/**< Free a block. */
+	void	*state;																/**< Opaque allocator state. */
+}	t_lr_allocator;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Global variables.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Default allocator, backed by malloc, realloc and free.
+ */
+extern const t_lr_allocator	g_lr_default_allocator;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Function prototypes.                                                   * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Allocate memory with an allocator.
+ *
+ * @param allocator Allocator, NULL for the default one.
+ * @param size Size in bytes.
+ * @return Pointer to the block, or NULL on allocation failure.
+ */
+void	*lr_alloc(
+			const t_lr_allocator *allocator,
+			size_t size
+			);
+
+/**
+ * @brief Resize memory allocated with an allocator.
+ *
+ * @param allocator Allocator, NULL for the default one.
+ * @param ptr Block to resize.
+ * @param oldsize Current size of the block in bytes.
+ * @param newsize New size in bytes.
+ * @return Pointer to the block, or NULL on allocation failure (ptr is then
+ *         left untouched).
+ */
+void	*lr_realloc(
+			const t_lr_allocator *allocator,
+			void *ptr,
+			size_t oldsize,
+			size_t newsize
+			);
+
+/**
+ * @brief Free memory allocated with an allocator.
+ *
+ * @param allocator Allocator, NULL for the default one.
+ * @param ptr Block to free, may be NULL.
+ * @param size Size of the block in bytes.
+ */
+void	lr_free(
+			const t_lr_allocator *allocator,
+			void *ptr,
+			size_t size
+			);
+
+#endif
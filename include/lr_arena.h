@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lr_arena.h                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 19:05:12 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 19:05:12 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file lr_arena.h
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Region allocator for semantic values.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef LR_ARENA_H
+# define LR_ARENA_H
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+# include <stddef.h>
+
+# include "lr_alloc.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Defines.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Alignment of every arena allocation.
+ */
+# define LR_ARENA_ALIGN	_Alignof(max_align_t)
+
+/**
+ * @brief Default minimum size of an arena chunk in bytes.
+ */
+# define LR_ARENA_CHUNK_SIZE	4096
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Arena chunk header, followed by the chunk bytes.
+ */
+typedef struct s_lr_arena_chunk
+{
+	struct s_lr_arena_chunk	*next;	/**< Next chunk. */
+	size_t					size;	/**< Usable bytes of the chunk. */
+}	t_lr_arena_chunk;
+
+/**
+ * @brief Arena structure.
+ *
+ * Bump allocator over a list of chunks. Allocations are never freed one by
+ * one: lr_arena_reset rewinds the whole region in constant time and keeps
+ * the chunks for the next use, lr_arena_destroy gives them back to the
+ * allocator.
+ */
+typedef struct s_lr_arena
+{
+	t_lr_arena_chunk		*head;			/**< First chunk. */
+	t_lr_arena_chunk		*cur;			/**< Chunk being filled. */
+	char					*ptr;			/**< Next free byte of cur. */
+	char					*end;			/**< End of cur. */
+	size_t					chunk_size;		/**< Minimum chunk size. */
+	const t_lr_allocator	*allocator;		/**< Allocator of the chunks. */
+}	t_lr_arena;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Function prototypes.                                                   * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Initialize an empty arena.
+ *
+ * Nothing is allocated until the first lr_arena_alloc.
+ *
+ * @param arena Arena to initialize.
+ * @param allocator Allocator of the chunks, NULL for the default one.
+ * @param chunk_size Minimum size of a chunk in bytes, 0 for
+ *                   LR_ARENA_CHUNK_SIZE.
+ */
+void	lr_arena_init(
+			t_lr_arena *arena,
+			const t_lr_allocator *allocator,
+			size_t chunk_size
+			);
+
+/**
+ * @brief Allocate memory from an arena.
+ *
+ * @param arena Arena.
+ * @param size Size in bytes.
+ * @return Pointer aligned on LR_ARENA_ALIGN, or NULL on allocation failure.
+ */
+void	*lr_arena_alloc(
+			t_lr_arena *arena,
+			size_t size
+			);
+
+/**
+ * @brief Release every allocation of an arena at once.
+ *
+ * Constant time, the chunks are kept and reused by later allocations.
+ *
+ * @param arena Arena.
+ */
+void	lr_arena_reset(
+			t_lr_arena *arena
+			);
+
+/**
+ * @brief Free every chunk of an arena.
+ *
+ * @param arena Arena.
+ */
+void	lr_arena_destroy(
+			t_lr_arena *arena
+			);
+
+#endif
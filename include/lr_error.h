@@ -47,6 +47,12 @@ typedef enum e_lr_error
 	LR_PROD_ERROR,
 	/** @brief Internal parser error, possibly due to malformed LR tables. */
 	LR_INTERNAL_ERROR,
+	/** @brief Fixed stack buffer exhausted and spilling is disabled. */
+	LR_STACK_OVERFLOW,
+	/** @brief File could not be opened, read, written or mapped. */
+	LR_IO_ERROR,
+	/** @brief Serialized data has a wrong format or fails validation. */
+	LR_BAD_FORMAT,
 }	t_lr_error;
 
 #endif
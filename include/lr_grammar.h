@@ -0,0 +1,502 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lr_grammar.h                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 17:24:05 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 17:24:05 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file lr_grammar.h
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Immutable grammar tables shared by parsers.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef LR_GRAMMAR_H
+# define LR_GRAMMAR_H
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+# include <stddef.h>
+# include <stdint.h>
+
+# include "lr_token.h"
+# include "lr_type.h"
+# include "lr_error.h"
+# include "lr_stack.h"
+# include "lr_action.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Defines.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Largest number of reduce chains lr_chains_build keeps.
+ */
+# ifndef LR_CHAIN_MAX
+#  define LR_CHAIN_MAX	1024
+# endif
+
+/**
+ * @brief Magic number of grammar files ("MPGR" on little endian hosts).
+ */
+# define LR_GRAMMAR_MAGIC	0x5247504du
+
+/**
+ * @brief Version of the grammar file format.
+ */
+# define LR_GRAMMAR_VERSION	2
+
+/**
+ * @brief Grammar file flags.
+ */
+typedef enum e_lr_grammar_file_flag
+{
+	LR_GRAMMAR_ACTION_COMB = 1 << 0,	/**< Comb instead of dense actions. */
+	LR_GRAMMAR_GOTO_COMB = 1 << 1,		/**< Comb instead of dense gotos. */
+	LR_GRAMMAR_DEFAULTS = 1 << 2,		/**< Default reductions follow. */
+	LR_GRAMMAR_TOKEN_MAP = 1 << 3,		/**< Token columns follow. */
+}	t_lr_grammar_file_flag;
+
+/**
+ * @brief Unit production elimination flags.
+ */
+typedef enum e_lr_units_flag
+{
+	LR_UNITS_BYPASS_ALL = 1 << 0,	/**< Bypass even if callbacks see it. */
+}	t_lr_units_flag;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Production callback structure.
+ *
+ * Defines a callback function to be invoked when reducing by a production rule,
+ * along with metadata about the production. Callbacks receive the parser
+ * context, which holds the user pointer and the allocator.
+ */
+typedef struct s_lr_prod_cb
+{
+	void	*(*cb)(t_lr_stack_item *item, t_lr_parser_ctx *ctx);	/**< Callback to create derived value. */
+	size_t	size;													/**< Number of items this production consumes. */
+	void	(*free_cb)(void *to_free, t_lr_parser_ctx *ctx);		/**< Callback to free derived value. */
+}	t_lr_prod_cb;
+
+/**
+ * @brief Parsing engine, processes one token like _lr_parser_exec.
+ *
+ * Generated direct-coded parsers (mp-gen --direct) provide one, the table
+ * interpreter is used when the grammar holds none.
+ */
+typedef t_lr_error				(*t_lr_engine)(
+									t_lr_parser_ctx *ctx,
+									const t_lr_token *token
+									);
+
+/**
+ * @brief LR grammar structure.
+ *
+ * Contains the read-only tables and callbacks of a grammar. A grammar is
+ * never modified by parsing, so any number of parsers, from any number of
+ * threads, may share one. The table interpreter checks every table entry it
+ * uses, unless verified is set, in which case it trusts them. With a
+ * token_map, the action tables have column_count columns instead of
+ * token_count, several tokens sharing a column when they behave the same.
+ */
+typedef struct s_lr_grammar
+{
+	const t_lr_prod_cb			*prod_cb;			/**< Array of production callbacks. */
+	const t_lr_token_free_cb	*token_free_cbs;	/**< Token free callbacks or NULL. */
+	const t_lr_action			*action_table;		/**< Action table (state × token). */
+	const t_lr_state_id			*goto_table;		/**< Goto table (state × production). */
+	size_t						state_count;		/**< Number of states in the parser. */
+	size_t						token_count;		/**< Number of terminal symbols. */
+	size_t						prod_count;			/**< Number of production rules. */
+	const t_lr_packed_action	*packed_table;		/**< Packed action table or NULL. */
+	const t_lr_comb_action		*action_comb;		/**< Compressed action table or NULL. */
+	const t_lr_comb_goto		*goto_comb;			/**< Compressed goto table or NULL. */
+	const t_lr_prod_id			*default_reduce;	/**< Forced reduction per state or NULL. */
+	const t_lr_chains			*chains;			/**< Reduce chains or NULL. */
+	const t_lr_token_id			*token_map;			/**< Column per token ID or NULL. */
+	size_t						column_count;		/**< Action columns with token_map. */
+	t_lr_engine					engine;				/**< Direct-coded engine or NULL. */
+	int							verified;			/**< Set by lr_grammar_verify. */
+}	t_lr_grammar;
+
+/**
+ * @brief Header of a grammar file.
+ *
+ * Followed by 8 byte aligned sections, in this order: the production
+ * sizes (uint32_t), the action table (comb base, next, defaults and check,
+ * or the dense packed table), the goto table (comb base, next, defaults
+ * and check, or the dense table) and the default reductions, if any
+ * (t_lr_prod_id per state). Every array is laid out like in memory,
+ * so a mapped file is used in place; files are only exchanged between
+ * hosts of the same byte order and type widths, which the magic number and
+ * the sizes check.
+ */
+typedef struct s_lr_grammar_header
+{
+	uint32_t	magic;			/**< LR_GRAMMAR_MAGIC. */
+	uint16_t	version;		/**< LR_GRAMMAR_VERSION. */
+	uint8_t		flags;			/**< t_lr_grammar_file_flag. */
+	uint8_t		id_size;		/**< sizeof(t_lr_state_id). */
+	uint8_t		token_id_size;	/**< sizeof(t_lr_token_id). */
+	uint8_t		action_size;	/**< sizeof(t_lr_packed_action). */
+	uint8_t		word_size;		/**< sizeof(size_t). */
+	uint8_t		reserved;		/**< Zero. */
+	uint64_t	state_count;	/**< Number of states. */
+	uint64_t	token_count;	/**< Number of tokens. */
+	uint64_t	prod_count;		/**< Number of productions. */
+	uint64_t	action_slots;	/**< Action comb slots, 0 if dense. */
+	uint64_t	goto_slots;		/**< Goto comb slots, 0 if dense. */
+	uint64_t	column_count;	/**< Action columns. */
+}	t_lr_grammar_header;
+
+/**
+ * @brief Grammar mapped from a grammar file.
+ *
+ * grammar points into the mapping and into this structure, which must not
+ * be moved once loaded. Its token_free_cbs and engine are NULL and may be
+ * set by the caller.
+ */
+typedef struct s_lr_grammar_map
+{
+	t_lr_grammar		grammar;		/**< Grammar to parse with. */
+	t_lr_comb_action	action_comb;	/**< Action comb over the mapping. */
+	t_lr_comb_goto		goto_comb;		/**< Goto comb over the mapping. */
+	t_lr_prod_cb		*prod_cb;		/**< Production callbacks or NULL. */
+	void				*data;			/**< File mapping. */
+	size_t				size;			/**< Size of the mapping. */
+}	t_lr_grammar_map;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Function prototypes.                                                   * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Look up the action of a state on a token.
+ *
+ * Uses action_comb, then packed_table, then action_table, whichever is
+ * set first.
+ *
+ * @param grammar Grammar.
+ * @param state_id State ID.
+ * @param token_id Token ID.
+ * @return The action to perform.
+ */
+t_lr_action		lr_grammar_action(
+					const t_lr_grammar *grammar,
+					t_lr_state_id state_id,
+					t_lr_token_id token_id
+					);
+
+/**
+ * @brief Get the number of columns of the action tables.
+ *
+ * @param grammar Grammar.
+ * @return column_count with a token map, token_count otherwise.
+ */
+size_t			lr_grammar_columns(
+					const t_lr_grammar *grammar
+					);
+
+/**
+ * @brief Look up the goto state of a state on a production.
+ *
+ * Uses goto_comb, or goto_table when it is not set.
+ *
+ * @param grammar Grammar.
+ * @param state_id State ID exposed by the reduction.
+ * @param prod_id Production ID.
+ * @return The state to go to.
+ */
+t_lr_state_id	lr_grammar_goto(
+					const t_lr_grammar *grammar,
+					t_lr_state_id state_id,
+					t_lr_prod_id prod_id
+					);
+
+/**
+ * @brief Save the tables of a grammar to a grammar file.
+ *
+ * Writes the compressed tables when the grammar has them, the dense ones
+ * otherwise (action_table is packed on the fly), and the production sizes
+ * of prod_cb.
+ *
+ * @param grammar Grammar with prod_cb, an action and a goto table.
+ * @param path Path of the file, created or truncated.
+ * @return LR_OK on success, LR_IO_ERROR on failure, LR_INTERNAL_ERROR if
+ *         the grammar misses a table or an action does not fit in a
+ *         packed action.
+ */
+t_lr_error		lr_grammar_save(
+					const t_lr_grammar *grammar,
+					const char *path
+					);
+
+/**
+ * @brief Map a grammar file read-only.
+ *
+ * Checks the header against this build and verifies the tables with
+ * lr_grammar_verify once, then points map->grammar straight at the mapping:
+ * nothing is copied and processes mapping the same file share its pages. When
+ * prod_cb is NULL, map->prod_cb is allocated with the production sizes and
+ * no callbacks, and may be filled by the caller; otherwise prod_cb is used
+ * as is and its sizes must match the file.
+ *
+ * @param map Output mapped grammar.
+ * @param path Path of the grammar file.
+ * @param prod_cb Production callbacks indexed by production, or NULL.
+ * @return LR_OK on success, LR_IO_ERROR if the file cannot be mapped,
+ *         LR_BAD_FORMAT if it is not a valid grammar file for this build,
+ *         LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error		lr_grammar_load_mmap(
+					t_lr_grammar_map *map,
+					const char *path,
+					const t_lr_prod_cb *prod_cb
+					);
+
+/**
+ * @brief Unmap a grammar mapped by lr_grammar_load_mmap.
+ *
+ * No parser may use the grammar anymore.
+ *
+ * @param map Mapped grammar.
+ */
+void			lr_grammar_unmap(
+					t_lr_grammar_map *map
+					);
+
+/**
+ * @brief Look up the reduce chain of a unit reduction.
+ *
+ * @param grammar Grammar.
+ * @param under State of the item under the top one.
+ * @param top State of the top item, which reduces by a unit production.
+ * @param token_id Token ahead.
+ * @return The chain, or NULL if the grammar holds none for this key.
+ */
+const t_lr_chain	*lr_grammar_chain(
+						const t_lr_grammar *grammar,
+						t_lr_state_id under,
+						t_lr_state_id top,
+						t_lr_token_id token_id
+						);
+
+/**
+ * @brief Verify the tables of a grammar and mark it as verified.
+ *
+ * Checks that every table entry a lookup can read is in range and that no
+ * reduction, on any path through the automaton, pops more items than the
+ * stack holds. A verified grammar is parsed without any runtime check; its
+ * tables and production sizes must not change afterwards.
+ *
+ * @param grammar Grammar to verify.
+ * @return LR_OK if the grammar is verified, LR_INTERNAL_ERROR if its tables
+ *         are missing or malformed, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error		lr_grammar_verify(
+					t_lr_grammar *grammar
+					);
+
+/**
+ * @brief Build the compressed tables from the dense tables.
+ *
+ * Converts action_table and goto_table into comb vectors and sets
+ * action_comb and goto_comb, which the parser then uses transparently.
+ * The action default of a state is its most frequent reduction (or an
+ * error when the state never reduces); like yacc, error entries of a state
+ * with a default reduction are folded into it, so the syntax error is
+ * reported before the next shift instead of immediately.
+ *
+ * @param grammar Grammar holding the dense tables.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_INTERNAL_ERROR if an ID does not fit in a packed action.
+ */
+t_lr_error		lr_comb_build(
+					t_lr_grammar *grammar
+					);
+
+/**
+ * @brief Free the compressed tables built by lr_comb_build.
+ *
+ * Resets action_comb and goto_comb to NULL so the dense tables are used
+ * again.
+ *
+ * @param grammar Grammar.
+ */
+void			lr_comb_destroy(
+					t_lr_grammar *grammar
+					);
+
+/**
+ * @brief Build the packed action table from the dense action table.
+ *
+ * Encodes every action_table cell into a single t_lr_packed_action and
+ * sets packed_table, shrinking each cell to MP_ACTION_BITS bits.
+ *
+ * @param grammar Grammar holding the dense tables.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_INTERNAL_ERROR if an ID does not fit in a packed action.
+ */
+t_lr_error		lr_pack_build(
+					t_lr_grammar *grammar
+					);
+
+/**
+ * @brief Free the packed action table built by lr_pack_build.
+ *
+ * @param grammar Grammar.
+ */
+void			lr_pack_destroy(
+					t_lr_grammar *grammar
+					);
+
+/**
+ * @brief Build the default reductions of the consistent states.
+ *
+ * A state is consistent when it never shifts nor accepts and reduces by a
+ * single production; default_reduce then holds that production, and
+ * LR_PROD_NONE for the other states. The lookahead of a consistent state
+ * is never read: it reduces on every token, erroneous ones included, which
+ * only delays the syntax error to the next state that reads it, exactly
+ * like the comb tables already do.
+ *
+ * @param grammar Grammar holding an action table.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error		lr_defaults_build(
+					t_lr_grammar *grammar
+					);
+
+/**
+ * @brief Free the default reductions built by lr_defaults_build.
+ *
+ * @param grammar Grammar.
+ */
+void			lr_defaults_destroy(
+					t_lr_grammar *grammar
+					);
+
+/**
+ * @brief Precompute the chains of unit reductions of a grammar.
+ *
+ * For every transition the automaton can take into a state, and every
+ * token that state reduces by a unit production, follows the unit
+ * reductions the token triggers down to the first other action, and
+ * stores the chains of two reductions or more. Goto entries no reduction
+ * reaches are skipped, identical steps are stored once, and only the
+ * LR_CHAIN_MAX longest chains are kept.
+ * The parser then runs a whole chain at once, on the top item, without
+ * looking up any table. Every reduction of a chain, with or without
+ * callback, is still one step, counted and traced by the state it reduces
+ * in. The tables and production callbacks must not change afterwards.
+ *
+ * @param grammar Grammar holding prod_cb and its tables.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_INTERNAL_ERROR if a table entry is out of range.
+ */
+t_lr_error		lr_chains_build(
+					t_lr_grammar *grammar
+					);
+
+/**
+ * @brief Free the reduce chains built by lr_chains_build.
+ *
+ * @param grammar Grammar.
+ */
+void			lr_chains_destroy(
+					t_lr_grammar *grammar
+					);
+
+/**
+ * @brief Rewrite the tables so callback-less unit productions are bypassed.
+ *
+ * A state whose only action is a reduction by a unit production without
+ * callback is never entered: every goto into it targets the state that
+ * reduction leads to, so the reduction, its pop and push and its goto
+ * lookup are saved, even through several such productions.
+ *
+ * By default what callbacks see is kept: a state is only bypassed from the
+ * gotos of productions without callback nor free callback, into unit
+ * productions without free callback either, whose NULL values are the
+ * same, and shifts are left as they are. With LR_UNITS_BYPASS_ALL shifts
+ * and every goto are rewritten too, which changes what callbacks see: the
+ * item under a bypassed production stays on the stack in place of the
+ * NULL value it derived, so the parent callback gets that token or value
+ * instead of NULL. Only grammars whose callbacks never test for that NULL
+ * value may use it. In both cases tree mode gets no node for a bypassed
+ * production.
+ *
+ * The grammar then holds dense tables only, with its default reductions;
+ * build the compressed tables, the chains or verify it again afterwards if
+ * needed.
+ *
+ * @param grammar Grammar holding prod_cb and its tables.
+ * @param flags 0 or LR_UNITS_BYPASS_ALL.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_INTERNAL_ERROR if prod_cb is missing.
+ */
+t_lr_error		lr_units_build(
+					t_lr_grammar *grammar,
+					int flags
+					);
+
+/**
+ * @brief Merge the tokens that have the same action in every state.
+ *
+ * Tokens of a class share one action column: action_table is replaced by
+ * a dense table with a column per class, and token_map gives the class of
+ * each token ID, which callbacks keep seeing. The packed and compressed
+ * action tables are dropped, build them again afterwards if needed; the
+ * previous action table and token map are left to their owner. Classes
+ * are largest once lr_units_build bypassed the callback-less productions
+ * tokens shift into, as with binop : PLUS | MINUS.
+ *
+ * @param grammar Grammar holding its action table.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_INTERNAL_ERROR if a token maps out of the action table.
+ */
+t_lr_error		lr_classes_build(
+					t_lr_grammar *grammar
+					);
+
+/**
+ * @brief Free the action table and token map built by lr_classes_build.
+ *
+ * @param grammar Grammar.
+ */
+void			lr_classes_destroy(
+					t_lr_grammar *grammar
+					);
+
+/**
+ * @brief Free the tables rewritten by lr_units_build.
+ *
+ * @param grammar Grammar.
+ */
+void			lr_units_destroy(
+					t_lr_grammar *grammar
+					);
+
+#endif
@@ -0,0 +1,87 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lr_io.h                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 21:20:44 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 21:20:44 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file lr_io.h
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief File helpers of the serialized formats.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef LR_IO_H
+# define LR_IO_H
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+# include <stddef.h>
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Function prototypes.                                                   * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Write a whole buffer to a file descriptor.
+ *
+ * @param fd File descriptor.
+ * @param buf Buffer to write.
+ * @param size Size of buf in bytes.
+ * @return 0 on success, -1 on failure.
+ */
+int		lr_io_write(
+			int fd,
+			const void *buf,
+			size_t size
+			);
+
+/**
+ * @brief Write zero bytes up to the next multiple of 8 of an offset.
+ *
+ * @param fd File descriptor.
+ * @param offset Number of bytes written so far, updated.
+ * @return 0 on success, -1 on failure.
+ */
+int		lr_io_pad(
+			int fd,
+			size_t *offset
+			);
+
+/**
+ * @brief Map a whole file read-only.
+ *
+ * @param path Path of the file.
+ * @param size Output size of the mapping.
+ * @return The mapping, or NULL if the file is empty or cannot be mapped.
+ */
+void	*lr_io_map(
+			const char *path,
+			size_t *size
+			);
+
+/**
+ * @brief Unmap a file mapped by lr_io_map.
+ *
+ * @param data Mapping, may be NULL.
+ * @param size Size of the mapping.
+ */
+void	lr_io_unmap(
+			void *data,
+			size_t size
+			);
+
+#endif
@@ -33,6 +33,11 @@
 # include "lr_type.h"
 # include "lr_error.h"
 # include "lr_stack.h"
+# include "lr_grammar.h"
+# include "lr_arena.h"
+# include "lr_tree.h"
+# include "lr_stats.h"
+# include "lr_trace.h"
 
 // ************************************************************************** //
 // *                                                                        * //
@@ -41,110 +46,341 @@
 // ************************************************************************** //
 
 /**
- * @brief Type of LR parser action.
+ * @brief LR parser context structure.
  *
- * Defines the possible actions the parser can take when processing a token.
+ * Contains the per-parse state of the LR parsing algorithm: the shared
+ * grammar it runs, the parsing stack (with the allocator of the context),
+ * the user pointer, the semantic value arena and the parse tree. Only the
+ * stack (and the arena or the tree once used) is allocated, so a context
+ * is cheap to create for each parse. With MP_STATS the context also counts
+ * its shifts and reductions, see lr_parser_stats, and with MP_TRACE it
+ * records its actions in a trace, see lr_parser_set_trace. The stack
+ * refers to its context, which must not be moved once initialized.
  */
-typedef enum e_lr_action_type
+struct s_lr_parser_ctx
 {
-	ACTION_SHIFT,	/**< Shift action: push token onto stack. */
-	ACTION_REDUCE,	/**< Reduce action: apply production rule. */
-	ACTION_ERROR,	/**< Error action: syntax error encountered. */
-	ACTION_ACCEPT,	/**< Accept action: parsing completed successfully. */
-	ACTION__COUNT,	/**< Number of action types. */
-}	t_lr_action_type;
+	const t_lr_grammar	*grammar;	/**< Grammar tables and callbacks. */
+	t_lr_stack			stack;		/**< Parsing stack. */
+	void				*usrptr;	/**< User pointer passed to callbacks. */
+	t_lr_arena			arena;		/**< Semantic value arena. */
+	t_lr_tree			tree;		/**< Parse tree of the tree mode. */
+	uint32_t			shifted;	/**< Tokens shifted since the reset. */
+# ifdef MP_TOKEN_REF
+	const t_lr_token	*tokens;	/**< Token buffer of the parse. */
+	size_t				token_count;	/**< Tokens in the buffer. */
+# endif
+# ifdef MP_STATS
+	t_lr_stats			stats;		/**< Hot path counters. */
+# endif
+# ifdef MP_TRACE
+	t_lr_trace			*trace;		/**< Action trace, or NULL. */
+# endif
+};
 
 /**
- * @brief Union containing data for parser actions.
- *
- * Holds either the target state ID for shift actions or the production ID
- * for reduce actions.
+ * @brief Per-parse parser handle.
  */
-typedef union u_lr_action_data
-{
-	t_lr_state_id	shift_id;	/**< Target state ID for shift actions. */
-	t_lr_prod_id	reduce_id;	/**< Production ID for reduce actions. */
-}	t_lr_action_data;
+typedef t_lr_parser_ctx			t_lr_parser;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Function prototypes.                                                   * //
+// *                                                                        * //
+// ************************************************************************** //
 
 /**
- * @brief Parser action structure.
+ * @brief Initialize the LR parser context.
+ *
+ * Sets up the parser stack and prepares the parser for execution against
+ * grammar. Every field of the grammar MUST be set: prod_cb, token_free_cbs,
+ * action_table, goto_table, state_count, token_count, prod_count,
+ * packed_table, action_comb, goto_comb (NULL to use the dense tables) and
+ * engine (NULL to interpret the tables). Action lookups use action_comb
+ * first, then packed_table, then action_table. The grammar is only read and
+ * must outlive the context.
  *
- * Represents an action to be taken by the parser, including its type
- * and associated data.
+ * @param ctx Pointer to the parser context to initialize.
+ * @param grammar Grammar to parse with.
+ * @param usrptr User pointer passed to all callbacks.
+ * @return LR_OK on success, error code otherwise.
  */
-typedef struct s_lr_action
-{
-	t_lr_action_type	type;	/**< Type of action. */
-	t_lr_action_data	data;	/**< Data associated with the action. */
-}	t_lr_action;
+int				lr_parser_init(
+					t_lr_parser_ctx *ctx,
+					const t_lr_grammar *grammar,
+					void *usrptr
+					);
 
 /**
- * @brief Production callback structure.
+ * @brief Initialize the LR parser context with a stack capacity hint.
+ *
+ * Same as lr_parser_init, the stack starts with room for capacity items so
+ * parses that stay under it never grow it.
  *
- * Defines a callback function to be invoked when reducing by a production rule,
- * along with metadata about the production.
+ * @param ctx Pointer to the parser context to initialize.
+ * @param grammar Grammar to parse with.
+ * @param usrptr User pointer passed to all callbacks.
+ * @param capacity Initial stack capacity in items.
+ * @return LR_OK on success, error code otherwise.
  */
-typedef struct s_lr_prod_cb
-{
-	void	*(*cb)(t_lr_stack_item *item, void *usrptr);	/**< Callback to create derived value. */
-	size_t	size;											/**< Number of items this production consumes. */
-	void	(*free_cb)(void *to_free, void *usrptr);		/**< Callback to free derived value. */
-}	t_lr_prod_cb;
+int				lr_parser_init_capacity(
+					t_lr_parser_ctx *ctx,
+					const t_lr_grammar *grammar,
+					void *usrptr,
+					size_t capacity
+					);
 
 /**
- * @brief LR parser context structure.
+ * @brief Initialize the LR parser context with an allocator.
+ *
+ * Same as lr_parser_init_capacity, the stack memory comes from allocator,
+ * which production callbacks may use too (see lr_parser_allocator).
  *
- * Contains all the state and tables needed to execute the LR parsing algorithm,
- * including action and goto tables, production callbacks, and the parsing stack.
+ * @param ctx Pointer to the parser context to initialize.
+ * @param grammar Grammar to parse with.
+ * @param usrptr User pointer passed to all callbacks.
+ * @param allocator Allocator of the context, NULL for the default one.
+ * @param capacity Initial stack capacity in items.
+ * @return LR_OK on success, error code otherwise.
  */
-typedef struct s_lr_parser_ctx
-{
-	t_lr_prod_cb		*prod_cb;			/**< Array of production callbacks. */
-	t_lr_token_free_cb	*token_free_cbs;	/**< Array of token free callbacks. */
-	t_lr_action			*action_table;		/**< Action table (state × token). */
-	t_lr_state_id		*goto_table;		/**< Goto table (state × production). */
-	size_t				state_count;		/**< Number of states in the parser. */
-	size_t				token_count;		/**< Number of terminal symbols. */
-	size_t				prod_count;			/**< Number of production rules. */
-	t_lr_stack			stack;				/**< Parsing stack. */
-	void				*usrptr;			/**< User pointer passed to callbacks. */
-}	t_lr_parser_ctx;
-
-// ************************************************************************** //
-// *                                                                        * //
-// * Function prototypes.                                                   * //
-// *                                                                        * //
-// ************************************************************************** //
+int				lr_parser_init_allocator(
+					t_lr_parser_ctx *ctx,
+					const t_lr_grammar *grammar,
+					void *usrptr,
+					const t_lr_allocator *allocator,
+					size_t capacity
+					);
 
 /**
- * @brief Initialize the LR parser context.
+ * @brief Initialize the LR parser context on a caller stack buffer.
  *
- * Sets up the parser stack and prepares the parser for execution.
- * Before calling this function, the following fields MUST be set:
- * prod_cb, token_free_cbs, action_table, goto_table, state_count,
- * token_count, prod_count.
+ * Same as lr_parser_init, the stack items are stored in buf (on the
+ * caller stack, in an arena...) so parsing allocates nothing while they
+ * fit. A full buffer spills to the heap, or makes the parse fail with
+ * LR_STACK_OVERFLOW when flags holds LR_STACK_NO_SPILL. With MP_STATS the
+ * counters are allocated on the heap by the default allocator, use
+ * lr_parser_init_allocator where nothing may come from it.
  *
  * @param ctx Pointer to the parser context to initialize.
+ * @param grammar Grammar to parse with.
  * @param usrptr User pointer passed to all callbacks.
+ * @param buf Caller stack buffer, which must outlive the context.
+ * @param size Size of buf in bytes, LR_STACK_SLOT_SIZE per item.
+ * @param flags 0 or LR_STACK_NO_SPILL.
  * @return LR_OK on success, error code otherwise.
  */
-int				lr_parser_init(
+int				lr_parser_init_buffer(
 					t_lr_parser_ctx *ctx,
-					void *usrptr
+					const t_lr_grammar *grammar,
+					void *usrptr,
+					void *buf,
+					size_t size,
+					int flags
+					);
+
+/**
+ * @brief Change the allocator of the LR parser context.
+ *
+ * A heap stack buffer is moved to memory of the new allocator; a caller or
+ * inline buffer only spills to it from then on.
+ *
+ * @param ctx Pointer to the parser context.
+ * @param allocator New allocator, NULL for the default one.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error		lr_parser_set_allocator(
+					t_lr_parser_ctx *ctx,
+					const t_lr_allocator *allocator
+					);
+
+/**
+ * @brief Get the allocator of the LR parser context.
+ *
+ * Production callbacks receive the context and may allocate their derived
+ * values with it through lr_alloc and lr_free.
+ *
+ * @param ctx Pointer to the parser context.
+ * @return The allocator, never NULL.
+ */
+const t_lr_allocator	*lr_parser_allocator(
+							const t_lr_parser_ctx *ctx
+							);
+
+/**
+ * @brief Switch the LR parser context to arena mode.
+ *
+ * Production callbacks then allocate their derived values with
+ * lr_parser_arena_alloc and the parser never calls free callbacks: the
+ * values, the accepted one included, stay valid until the next
+ * lr_parser_reset or lr_parser_destroy, which release all of them at once.
+ * With a grammar without token free callbacks, tearing a parse down then
+ * costs the same whatever the size of its tree.
+ *
+ * @param ctx Pointer to the parser context, freshly initialized or reset.
+ * @param chunk_size Minimum size in bytes of the arena chunks, allocated
+ *                   with the allocator of the context, 0 for the default.
+ */
+void			lr_parser_use_arena(
+					t_lr_parser_ctx *ctx,
+					size_t chunk_size
+					);
+
+/**
+ * @brief Allocate a semantic value in the arena of the LR parser context.
+ *
+ * @param ctx Pointer to the parser context, in arena mode.
+ * @param size Size in bytes.
+ * @return Pointer to size bytes, or NULL on allocation failure.
+ */
+void			*lr_parser_arena_alloc(
+					t_lr_parser_ctx *ctx,
+					size_t size
+					);
+
+/**
+ * @brief Switch the LR parser context to tree mode.
+ *
+ * Reductions then append a node to the flat post-order tree of the context
+ * (see t_lr_tree) instead of calling the production callbacks, of which
+ * only the size is read, and every shift appends a leaf. Tokens are
+ * referred to by their position in the input and stay owned by the
+ * caller, the stack never frees them. On accept, lr_parser_exec stores a
+ * pointer to the tree, a const t_lr_tree *, in its derived output; the
+ * tree is valid until the next lr_parser_reset or lr_parser_destroy unless
+ * taken with lr_parser_take_tree.
+ *
+ * @param ctx Pointer to the parser context, freshly initialized or reset.
+ */
+void			lr_parser_use_tree(
+					t_lr_parser_ctx *ctx
+					);
+
+/**
+ * @brief Take the parse tree out of the LR parser context.
+ *
+ * The caller owns the tree from then on and frees it with lr_tree_destroy;
+ * the context starts an empty tree.
+ *
+ * @param ctx Pointer to the parser context, in tree mode.
+ * @param tree Output tree.
+ */
+void			lr_parser_take_tree(
+					t_lr_parser_ctx *ctx,
+					t_lr_tree *tree
+					);
+
+/**
+ * @brief Take a snapshot of the hot path counters (MP_STATS).
+ *
+ * Copies the counters of the context into snapshot, initialized by the
+ * caller with lr_stats_init for the states and productions of its grammar.
+ * The counters add up over every parse of the context until
+ * lr_parser_stats_reset. Without MP_STATS nothing is counted and snapshot
+ * is zeroed.
+ *
+ * @param ctx Pointer to the parser context.
+ * @param snapshot Output counters.
+ * @return LR_OK on success, LR_INTERNAL_ERROR if snapshot is not sized for
+ *         the grammar or the library is built without MP_STATS.
+ */
+t_lr_error		lr_parser_stats(
+					const t_lr_parser_ctx *ctx,
+					t_lr_stats *snapshot
+					);
+
+/**
+ * @brief Zero the hot path counters of the context (MP_STATS).
+ *
+ * @param ctx Pointer to the parser context.
+ */
+void			lr_parser_stats_reset(
+					t_lr_parser_ctx *ctx
+					);
+
+/**
+ * @brief Record the actions of the context in a trace (MP_TRACE).
+ *
+ * From then on every shift, reduction, accept and syntax error of the
+ * context appends a record to trace, which must outlive its use. Contexts
+ * of a single thread may share a trace. Without MP_TRACE nothing is
+ * recorded.
+ *
+ * @param ctx Pointer to the parser context.
+ * @param trace Trace to append to, NULL to stop tracing.
+ */
+void			lr_parser_set_trace(
+					t_lr_parser_ctx *ctx,
+					t_lr_trace *trace
+					);
+
+/**
+ * @brief Set the token buffer of the parse (MP_TOKEN_REF).
+ *
+ * With MP_TOKEN_REF, every token given to lr_parser_exec and
+ * lr_parser_exec_n must lie in this buffer, and the stack only stores its
+ * index: shifting any other token fails with LR_INTERNAL_ERROR. The buffer
+ * keeps ownership of the tokens and must stay unchanged until the parse is
+ * over, including the derived values that still refer to it.
+ * Initialization and lr_parser_reset set it to NULL, so it is set again for
+ * every parse; lr_parser_exec_n uses its own tokens when none is set.
+ * Without MP_TOKEN_REF this does nothing.
+ *
+ * @param ctx Pointer to the parser context.
+ * @param tokens Token buffer.
+ * @param count Number of tokens in the buffer, at most UINT32_MAX are
+ *              indexed.
+ */
+void			lr_parser_set_tokens(
+					t_lr_parser_ctx *ctx,
+					const t_lr_token *tokens,
+					size_t count
+					);
+
+/**
+ * @brief Get the token of a stack item.
+ *
+ * Production callbacks reach the tokens of their items through it, so they
+ * work whether the stack stores tokens or references (MP_TOKEN_REF).
+ *
+ * @param ctx Pointer to the parser context.
+ * @param item Stack item of type ITEM_TOKEN.
+ * @return The token, owned by the stack or the token buffer, NULL with
+ *         MP_TOKEN_REF if no token buffer is set.
+ */
+const t_lr_token	*lr_parser_token(
+						const t_lr_parser_ctx *ctx,
+						const t_lr_stack_item *item
+						);
+
+/**
+ * @brief Reset the LR parser context for a new parse.
+ *
+ * Frees whatever an unfinished or failed parse left on the stack and
+ * restores the initial state, keeping the stack buffer so a recycled
+ * context parses without allocating once its stack is warmed up. In arena
+ * mode the arena is rewound, keeping its chunks as well, and in tree mode
+ * the tree is emptied. With MP_TOKEN_REF the token buffer is forgotten.
+ *
+ * @param ctx Pointer to the parser context.
+ * @return LR_OK on success, error code on failure.
+ */
+t_lr_error		lr_parser_reset(
+					t_lr_parser_ctx *ctx
 					);
 
 /**
- * @brief Execute one step of LR parsing.
+ * @brief Feed one token to the LR parser.
  *
- * Processes a single token and performs the appropriate action (shift, reduce,
- * accept, or error). This function may need to be called multiple times for
- * the same token if reductions occur.
+ * Runs every reduction the token triggers, then shifts it, accepts the
+ * input or rejects the token, so each token is given exactly once. Unless
+ * the grammar is verified, the table interpreter rejects a token ID the
+ * grammar does not have as a syntax error.
  *
  * @param ctx Pointer to the parser context.
  * @param token Pointer to the token to process.
  * @param derived Output pointer to receive the final derived value on accept.
- * @return LR_ACCEPT on successful parse completion, LR_OK if more tokens needed,
- *         error code on failure.
+ * @return LR_OK once the token is shifted, LR_ACCEPT once the input is
+ *         accepted, error code on failure. After an error, the context must
+ *         be reset or destroyed.
  */
 t_lr_error		lr_parser_exec(
 					t_lr_parser_ctx *ctx,
@@ -152,10 +388,36 @@ t_lr_error		lr_parser_exec(
 					void **derived
 					);
 
+/**
+ * @brief Execute LR parsing on a buffer of tokens.
+ *
+ * Equivalent to calling lr_parser_exec on each token in turn, without the
+ * per token call overhead. Tokens are shifted in order until one of them
+ * is rejected, the input is accepted or the buffer is exhausted; the
+ * caller keeps ownership of the tokens that were not consumed. With
+ * MP_TOKEN_REF and no token buffer set, tokens becomes the token buffer.
+ *
+ * @param ctx Pointer to the parser context.
+ * @param tokens Array of tokens to process.
+ * @param count Number of tokens in the array.
+ * @param derived Output pointer to receive the final derived value on accept.
+ * @param consumed Output number of processed tokens, the accepting token
+ *                 included and the rejected one excluded.
+ * @return LR_ACCEPT on successful parse completion, LR_OK if more tokens
+ *         needed, error code on failure.
+ */
+t_lr_error		lr_parser_exec_n(
+					t_lr_parser_ctx *ctx,
+					const t_lr_token *tokens,
+					size_t count,
+					void **derived,
+					size_t *consumed
+					);
+
 /**
  * @brief Destroy the parser context and free all resources.
  *
- * Frees the parser stack and all associated data.
+ * Frees the parser stack, the arena, the tree and all associated data.
  *
  * @param ctx Pointer to the parser context to destroy.
  */
@@ -172,7 +434,8 @@ void			lr_parser_destroy(
 /**
  * @brief Internal parser execution function.
  *
- * Recursively processes a token, performing shifts and reductions as needed.
+ * Processes a token, performing the reductions it triggers in a loop, then
+ * shifting it.
  *
  * @param ctx Pointer to the parser context.
  * @param tokens Pointer to the current token.
@@ -183,27 +446,70 @@ t_lr_error		_lr_parser_exec(
 					const t_lr_token *tokens
 					);
 
+/**
+ * @brief Internal parser execution function for a verified grammar.
+ *
+ * Same as _lr_parser_exec, without checking the table entries.
+ *
+ * @param ctx Pointer to the parser context.
+ * @param tokens Pointer to the current token.
+ * @return LR_ACCEPT, LR_OK, or error code.
+ */
+t_lr_error		_lr_parser_exec_verified(
+					t_lr_parser_ctx *ctx,
+					const t_lr_token *tokens
+					);
+
+/**
+ * @brief Extract the derived value of an accepted input.
+ *
+ * @param ctx Pointer to the parser context.
+ * @param derived Output pointer to receive the final derived value.
+ * @return LR_ACCEPT, or LR_INTERNAL_ERROR if the stack is malformed.
+ */
+t_lr_error		_lr_parser_accept(
+					t_lr_parser_ctx *ctx,
+					void **derived
+					);
+
 /**
  * @brief Perform a shift action.
  *
- * Pushes the given token onto the stack with the specified state ID.
+ * Pushes the given token, or its index with MP_TOKEN_REF, onto the stack
+ * with the specified state ID.
  *
  * @param ctx Pointer to the parser context.
  * @param token Token to shift.
  * @param state_id Target state ID.
- * @return LR_OK on success, error code on failure.
+ * @return LR_OK on success, LR_INTERNAL_ERROR with MP_TOKEN_REF if the
+ *         token is not in the token buffer, other error code on failure.
  */
 t_lr_error		_lr_parser_shift(
 					t_lr_parser_ctx *ctx,
-					t_lr_token token,
+					const t_lr_token *token,
 					t_lr_state_id state_id
 					);
 
+/**
+ * @brief Reject a token.
+ *
+ * Frees the stack items, keeping its buffer for lr_parser_reset.
+ *
+ * @param ctx Pointer to the parser context.
+ * @param token Rejected token.
+ * @return LR_SYNTAX_ERROR.
+ */
+t_lr_error		_lr_parser_error(
+					t_lr_parser_ctx *ctx,
+					const t_lr_token *token
+					);
+
 /**
  * @brief Perform a reduce action.
  *
  * Pops items from the stack, invokes the production callback to create
- * a derived value, and pushes the result back onto the stack.
+ * a derived value, and pushes the result back onto the stack. The
+ * production, the stack size and the goto state are checked first.
  *
  * @param ctx Pointer to the parser context.
  * @param prod_id Production rule ID to reduce by.
@@ -214,6 +520,92 @@ t_lr_error		_lr_parser_reduce(
 					t_lr_prod_id prod_id
 					);
 
+/**
+ * @brief Perform a reduce action with an already resolved goto state.
+ *
+ * Same as _lr_parser_reduce, the derived value is pushed with state_id
+ * instead of looking up the goto table. Only the stack size is checked.
+ *
+ * @param ctx Pointer to the parser context.
+ * @param prod_id Production rule ID to reduce by.
+ * @param state_id Goto state of the derived value.
+ * @return LR_OK on success, error code on failure.
+ */
+t_lr_error		_lr_parser_reduce_to(
+					t_lr_parser_ctx *ctx,
+					t_lr_prod_id prod_id,
+					t_lr_state_id state_id
+					);
+
+/**
+ * @brief Perform a reduce action without any check.
+ *
+ * The stack must hold more items than the production size.
+ *
+ * @param ctx Pointer to the parser context.
+ * @param prod_id Production rule ID to reduce by.
+ * @param state_id Goto state of the derived value.
+ * @return LR_OK on success, error code on failure.
+ */
+t_lr_error		_lr_parser_derive(
+					t_lr_parser_ctx *ctx,
+					t_lr_prod_id prod_id,
+					t_lr_state_id state_id
+					);
+
+/**
+ * @brief Find the reduce chain starting with a reduction, if any.
+ *
+ * @param ctx Pointer to the parser context.
+ * @param token Current token.
+ * @param prod_id Production the top item reduces by.
+ * @return The chain, or NULL to reduce one production at a time.
+ */
+const t_lr_chain	*_lr_parser_find_chain(
+						t_lr_parser_ctx *ctx,
+						const t_lr_token *token,
+						t_lr_prod_id prod_id
+						);
+
+/**
+ * @brief Run a chain of unit reductions in place on the top item.
+ *
+ * @param ctx Pointer to the parser context.
+ * @param chain Chain of the top item.
+ * @return LR_OK on success, LR_PROD_ERROR if a callback fails.
+ */
+t_lr_error		_lr_parser_run_chain(
+					t_lr_parser_ctx *ctx,
+					const t_lr_chain *chain
+					);
+
+/**
+ * @brief Append the leaf of a shifted token to the parse tree.
+ *
+ * @param ctx Pointer to the parser context, in tree mode.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error		_lr_parser_tree_shift(
+					t_lr_parser_ctx *ctx
+					);
+
+/**
+ * @brief Perform a reduce action in tree mode.
+ *
+ * Pops the items of the production, appends its node to the parse tree
+ * and pushes a derived item without value with state_id.
+ *
+ * @param ctx Pointer to the parser context, in tree mode.
+ * @param prod_id Production rule ID to reduce by.
+ * @param state_id Goto state of the derived item.
+ * @return LR_OK on success, error code on failure.
+ */
+t_lr_error		_lr_parser_tree_reduce(
+					t_lr_parser_ctx *ctx,
+					t_lr_prod_id prod_id,
+					t_lr_state_id state_id
+					);
+
 /**
  * @brief Get the goto state from the goto table.
  *
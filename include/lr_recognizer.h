@@ -0,0 +1,164 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lr_recognizer.h                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 19:48:02 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 19:48:02 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file lr_recognizer.h
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief LR recognizer, validates input without semantic values.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef LR_RECOGNIZER_H
+# define LR_RECOGNIZER_H
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+# include <stddef.h>
+
+# include "lr_token.h"
+# include "lr_type.h"
+# include "lr_error.h"
+# include "lr_alloc.h"
+# include "lr_grammar.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief LR recognizer structure.
+ *
+ * Runs the tables of a grammar like the parser, but only gives an
+ * accept or reject verdict: its stack holds state IDs alone, tokens are
+ * never stored and no production or free callback is called. Only the
+ * size of the productions is read from prod_cb, so a recognizer shares the
+ * grammar of the parsers. The engine of the grammar is not used, so a
+ * grammar generated by mp-gen --direct alone, without tables, cannot be
+ * recognized.
+ */
+typedef struct s_lr_recognizer
+{
+	const t_lr_grammar		*grammar;	/**< Grammar tables. */
+	t_lr_state_id			*states;	/**< State stack. */
+	size_t					alloced;	/**< Allocated capacity. */
+	size_t					used;		/**< Number of states on the stack. */
+	const t_lr_allocator	*allocator;	/**< Allocator of the state stack. */
+}	t_lr_recognizer;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Function prototypes.                                                   * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Initialize an LR recognizer.
+ *
+ * @param rec Pointer to the recognizer to initialize.
+ * @param grammar Grammar to recognize, which must outlive the recognizer.
+ * @param allocator Allocator of the state stack, NULL for the default one.
+ * @param capacity Initial stack capacity in states, 0 is treated as 1.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_INTERNAL_ERROR if the grammar has no action table.
+ */
+t_lr_error		lr_recognizer_init(
+					t_lr_recognizer *rec,
+					const t_lr_grammar *grammar,
+					const t_lr_allocator *allocator,
+					size_t capacity
+					);
+
+/**
+ * @brief Reset an LR recognizer for a new input.
+ *
+ * Constant time, the state stack is kept.
+ *
+ * @param rec Pointer to the recognizer.
+ */
+void			lr_recognizer_reset(
+					t_lr_recognizer *rec
+					);
+
+/**
+ * @brief Feed one token ID to an LR recognizer.
+ *
+ * Unless the grammar is verified (see lr_grammar_verify), the token ID and
+ * every table entry are checked as lr_parser_exec does.
+ *
+ * @param rec Pointer to the recognizer.
+ * @param token_id Token ID.
+ * @return LR_ACCEPT when the input is valid, LR_OK if more tokens are
+ *         needed, error code on failure. After an accept or an error, the
+ *         recognizer must be reset or destroyed.
+ */
+t_lr_error		lr_recognizer_exec(
+					t_lr_recognizer *rec,
+					t_lr_token_id token_id
+					);
+
+/**
+ * @brief Feed a buffer of tokens to an LR recognizer.
+ *
+ * Equivalent to calling lr_recognizer_exec on the ID of each token in
+ * turn; only the IDs are read, so the buffer of a parser can be validated
+ * before it is parsed.
+ *
+ * @param rec Pointer to the recognizer.
+ * @param tokens Array of tokens.
+ * @param count Number of tokens in the array.
+ * @param consumed Output number of processed tokens, the accepting token
+ *                 included and the rejected one excluded.
+ * @return LR_ACCEPT when the input is valid, LR_OK if more tokens are
+ *         needed, error code on failure.
+ */
+t_lr_error		lr_recognizer_exec_n(
+					t_lr_recognizer *rec,
+					const t_lr_token *tokens,
+					size_t count,
+					size_t *consumed
+					);
+
+/**
+ * @brief Destroy an LR recognizer and free its state stack.
+ *
+ * @param rec Pointer to the recognizer to destroy.
+ */
+void			lr_recognizer_destroy(
+					t_lr_recognizer *rec
+					);
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private function.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Push a state, growing the stack if needed.
+ *
+ * @param rec Pointer to the recognizer.
+ * @param state_id State ID to push.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error		_lr_recognizer_push(
+					t_lr_recognizer *rec,
+					t_lr_state_id state_id
+					);
+
+#endif
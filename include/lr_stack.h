@@ -32,6 +32,31 @@
 # include "lr_token.h"
 # include "lr_error.h"
 # include "lr_type.h"
+# include "lr_alloc.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Configuration.                                                         * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Number of stack items stored inside the stack structure.
+ *
+ * Stacks initialized with a capacity up to this one use the inline items
+ * and only allocate when they outgrow them. 0 disables the inline items.
+ */
+# ifndef MP_STACK_INLINE_CAPACITY
+#  define MP_STACK_INLINE_CAPACITY 0
+# endif
+
+/**
+ * @def MP_TOKEN_REF
+ * @brief Define MP_TOKEN_REF to store token indexes instead of tokens.
+ *
+ * Shifted tokens then stay in the caller token buffer, which owns them:
+ * the stack copies a t_lr_token_ref and never calls token free callbacks.
+ */
 
 // ************************************************************************** //
 // *                                                                        * //
@@ -61,7 +86,7 @@ typedef enum e_lr_stack_item_type
  */
 typedef struct s_lr_stack_derived
 {
-	void	(*prod_free_cb)(void *to_free, void *usrptr);	/**< Callback to free the derived data. */
+	void	(*prod_free_cb)(void *to_free, t_lr_parser_ctx *ctx);	/**< Callback to free the derived data. */
 	void	*data;											/**< Pointer to the derived data. */
 }	t_lr_stack_derived;
 
@@ -69,39 +94,81 @@ typedef struct s_lr_stack_derived
  * @brief Union for stack item data.
  *
  * Holds either a token or a derived value, depending on the item type.
+ * With MP_TOKEN_REF a token is only referred to by its index in the token
+ * buffer of the parse, which keeps the items small whatever MP_TOKEN_TYPE.
+ * Use lr_parser_token to reach a token in either case.
  */
 typedef union u_lr_stack_item_data
 {
+# ifdef MP_TOKEN_REF
+	t_lr_token_ref		token_ref;	/**< Index in the token buffer. */
+# else
 	t_lr_token			token;		/**< Token data. */
+# endif
 	t_lr_stack_derived	derived;	/**< Derived data. */
 }	t_lr_stack_item_data;
 
 /**
  * @brief Stack item structure.
  *
- * Represents a single item on the LR parser stack, containing the item type,
- * its associated data, and the parser state ID.
+ * Represents the payload of a single level of the LR parser stack: the item
+ * type and its associated data. The parser state ID of the level is stored
+ * apart, in the state array of the stack.
  */
 typedef struct s_lr_stack_item
 {
 	t_lr_stack_item_type	type;		/**< Type of the stack item. */
 	t_lr_stack_item_data	data;		/**< Data associated with the item. */
-	t_lr_state_id			state_id;	/**< Parser state ID at this stack level. */
 }	t_lr_stack_item;
 
+/**
+ * @brief Bytes used by one stack level, payload and state ID.
+ *
+ * Use it to size the buffer given to lr_stack_init_buffer.
+ */
+# define LR_STACK_SLOT_SIZE	(sizeof(t_lr_stack_item) + sizeof(t_lr_state_id))
+
+/**
+ * @brief Stack buffer flags.
+ */
+typedef enum e_lr_stack_flag
+{
+	LR_STACK_HEAP = 1 << 0,		/**< The buffer is heap allocated and owned. */
+	LR_STACK_NO_SPILL = 1 << 1,	/**< Fail with LR_STACK_OVERFLOW when full. */
+	LR_STACK_ARENA = 1 << 2,	/**< Derived values live in an arena. */
+	LR_STACK_TREE = 1 << 3,		/**< Reductions build a parse tree. */
+}	t_lr_stack_flag;
+
 /**
  * @brief LR parser stack structure.
  *
  * Dynamic stack implementation for the LR parser. Grows automatically
- * as needed and manages memory for tokens and derived values.
+ * as needed and manages memory for tokens and derived values. The stack is
+ * split in two parallel arrays, the payloads and a dense array of state
+ * IDs, so state lookups only touch the few bytes of the latter. Heap and
+ * caller buffers hold the payloads followed by the states. The levels
+ * live in the inline items, in a caller buffer or on the heap of its
+ * allocator; a full inline or caller buffer spills to the heap unless
+ * LR_STACK_NO_SPILL is set. A stack using its inline items must not be
+ * moved.
  */
 typedef struct s_lr_stack
 {
-	t_lr_stack_item		*data;				/**< Array of stack items. */
-	t_lr_token_free_cb	*token_free_cbs;	/**< Array of token free callbacks. */
-	size_t				alloced;			/**< Allocated capacity. */
-	size_t				used;				/**< Number of items currently on stack. */
-	void				*usrptr;			/**< User pointer passed to callbacks. */
+	t_lr_stack_item				*data;				/**< Array of stack items. */
+	t_lr_state_id				*states;			/**< State ID of each item. */
+	const t_lr_token_free_cb	*token_free_cbs;	/**< Array of token free callbacks. */
+	size_t						alloced;			/**< Allocated capacity. */
+	size_t						used;				/**< Number of items currently on stack. */
+	t_lr_parser_ctx				*ctx;				/**< Parser context passed to callbacks. */
+	const t_lr_allocator		*allocator;			/**< Allocator of heap buffers. */
+	int							flags;				/**< Buffer flags (t_lr_stack_flag). */
+# ifdef MP_STATS
+	uint64_t					grows;				/**< Buffer reallocations. */
+# endif
+# if MP_STACK_INLINE_CAPACITY > 0
+	t_lr_stack_item				inline_items[MP_STACK_INLINE_CAPACITY];	/**< Inline items. */
+	t_lr_state_id				inline_states[MP_STACK_INLINE_CAPACITY];	/**< Inline states. */
+# endif
 }	t_lr_stack;
 
 // ************************************************************************** //
@@ -113,17 +180,93 @@ typedef struct s_lr_stack
 /**
  * @brief Initialize an LR parser stack.
  *
- * Allocates initial memory for the stack and sets up the token free callbacks.
+ * Allocates initial memory for the stack with the default allocator and
+ * sets up the token free callbacks.
  *
  * @param stack Pointer to the stack structure to initialize.
  * @param token_free_cbs Array of token free callbacks indexed by token ID.
- * @param usrptr User pointer passed to all callbacks.
+ * @param ctx Parser context passed to the derived value callbacks.
  * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
  */
 t_lr_error		lr_stack_init(
 					t_lr_stack *stack,
-					t_lr_token_free_cb *token_free_cbs,
-					void *usrptr
+					const t_lr_token_free_cb *token_free_cbs,
+					t_lr_parser_ctx *ctx
+					);
+
+/**
+ * @brief Initialize an LR parser stack with an allocator and a capacity.
+ *
+ * @param stack Pointer to the stack structure to initialize.
+ * @param token_free_cbs Array of token free callbacks indexed by token ID.
+ * @param ctx Parser context passed to the derived value callbacks.
+ * @param allocator Allocator of the heap buffers, NULL for the default one.
+ * @param capacity Initial capacity in items, 0 is treated as 1.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error		lr_stack_init_capacity(
+					t_lr_stack *stack,
+					const t_lr_token_free_cb *token_free_cbs,
+					t_lr_parser_ctx *ctx,
+					const t_lr_allocator *allocator,
+					size_t capacity
+					);
+
+/**
+ * @brief Initialize an LR parser stack on a caller buffer.
+ *
+ * The items are stored in buf, which the stack never frees and which holds
+ * size / LR_STACK_SLOT_SIZE items once aligned. When it is full, the stack
+ * spills to the heap of the default allocator (see lr_stack_set_allocator),
+ * or fails with LR_STACK_OVERFLOW if flags holds LR_STACK_NO_SPILL. Never
+ * allocates.
+ *
+ * @param stack Pointer to the stack structure to initialize.
+ * @param token_free_cbs Array of token free callbacks indexed by token ID.
+ * @param ctx Parser context passed to the derived value callbacks.
+ * @param buf Caller buffer, aligned by the stack if needed.
+ * @param size Size of buf in bytes.
+ * @param flags 0 or LR_STACK_NO_SPILL.
+ */
+void			lr_stack_init_buffer(
+					t_lr_stack *stack,
+					const t_lr_token_free_cb *token_free_cbs,
+					t_lr_parser_ctx *ctx,
+					void *buf,
+					size_t size,
+					int flags
+					);
+
+/**
+ * @brief Change the allocator of an LR parser stack.
+ *
+ * A heap buffer is moved to memory of the new allocator, inline and caller
+ * buffers are kept.
+ *
+ * @param stack Pointer to the stack.
+ * @param allocator New allocator, NULL for the default one.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure (the stack
+ *         is then left unchanged).
+ */
+t_lr_error		lr_stack_set_allocator(
+					t_lr_stack *stack,
+					const t_lr_allocator *allocator
+					);
+
+/**
+ * @brief Free every item of an LR parser stack and keep its buffer.
+ *
+ * Frees all items on the stack by calling appropriate callbacks, the stack
+ * is left empty and keeps its capacity. With LR_STACK_ARENA the derived
+ * values are left to their arena, and a stack without token free callbacks
+ * (always the case with MP_TOKEN_REF) is then cleared in constant time.
+ * A stack with LR_STACK_TREE owns nothing and is always cleared in constant
+ * time.
+ *
+ * @param stack Pointer to the stack to clear.
+ */
+void			lr_stack_clear(
+					t_lr_stack *stack
 					);
 
 /**
@@ -155,11 +298,14 @@ size_t			lr_stack_used(
  *
  * @param stack Pointer to the stack.
  * @param item Pointer to the item to push.
- * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ * @param state_id Parser state ID of the new level.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_STACK_OVERFLOW if the buffer is full and may not spill.
  */
 t_lr_error		lr_stack_push(
 					t_lr_stack *stack,
-					const t_lr_stack_item *item
+					const t_lr_stack_item *item,
+					t_lr_state_id state_id
 					);
 
 /**
@@ -180,12 +326,13 @@ t_lr_error		lr_stack_pop(
 /**
  * @brief Pop multiple items from the stack.
  *
- * Removes count items from the top of the stack. Items are not freed,
- * they are simply removed from the stack.
+ * Removes count items from the top of the stack in constant time. Items
+ * are not freed, they are simply removed from the stack.
  *
  * @param stack Pointer to the stack.
  * @param count Number of items to pop.
- * @return LR_OK on success, LR_INTERNAL_ERROR if not enough items on stack.
+ * @return LR_OK on success, LR_INTERNAL_ERROR without popping anything if
+ *         not enough items on stack.
  */
 t_lr_error		lr_stack_popn(
 					t_lr_stack *stack,
@@ -202,4 +349,49 @@ t_lr_state_id	lr_stack_cur_state(
 					t_lr_stack *stack
 					);
 
+/**
+ * @brief Get the state ID exposed once count items are popped.
+ *
+ * @param stack Pointer to the stack.
+ * @param count Number of top items to look under, less than the number of
+ *              items on the stack.
+ * @return The state ID of the item under the top count items.
+ */
+t_lr_state_id	lr_stack_state_under(
+					const t_lr_stack *stack,
+					size_t count
+					);
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private function.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Double the capacity of a full stack, spilling to the heap if needed.
+ *
+ * @param stack Pointer to the stack.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_STACK_OVERFLOW if the buffer may not spill.
+ */
+t_lr_error		_lr_stack_grow(
+					t_lr_stack *stack
+					);
+
+/**
+ * @brief Move the stack to a new heap buffer.
+ *
+ * @param stack Pointer to the stack.
+ * @param allocator Allocator of the new buffer.
+ * @param alloced Capacity of the new buffer, at least the used items.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure (the stack
+ *         is then left unchanged).
+ */
+t_lr_error		_lr_stack_move(
+					t_lr_stack *stack,
+					const t_lr_allocator *allocator,
+					size_t alloced
+					);
+
 #endif
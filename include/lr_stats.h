@@ -0,0 +1,170 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lr_stats.h                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:41:26 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 23:41:26 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file lr_stats.h
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Parser hot path counters (MP_STATS).
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef LR_STATS_H
+# define LR_STATS_H
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+# include <stddef.h>
+# include <stdint.h>
+
+# include "lr_type.h"
+# include "lr_error.h"
+# include "lr_alloc.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Defines.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Number of buckets of the stack depth histogram.
+ */
+# define LR_STATS_DEPTH_BUCKETS	32
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Parser counters.
+ *
+ * A parser context built with MP_STATS counts every shift by the state it
+ * leaves, every reduction by the state it happens in and by production,
+ * and times the production callbacks. Bucket k of the depth histogram
+ * counts the shifts that leave the stack with a depth in [2^k, 2^(k+1)).
+ * The per state and per production arrays share a single allocation.
+ */
+typedef struct s_lr_stats
+{
+	uint64_t				*state_shifts;		/**< Shifts from each state. */
+	uint64_t				*state_reductions;	/**< Reductions in each state. */
+	uint64_t				*prod_reductions;	/**< Reductions by each production. */
+	uint64_t				*prod_ns;			/**< Callback nanoseconds of each production. */
+	uint64_t				depth[LR_STATS_DEPTH_BUCKETS];	/**< Shifts by stack depth. */
+	size_t					max_depth;			/**< Peak stack depth. */
+	uint64_t				grows;				/**< Stack buffer reallocations. */
+	size_t					state_count;		/**< Number of states. */
+	size_t					prod_count;			/**< Number of productions. */
+	const t_lr_allocator	*allocator;			/**< Allocator of the arrays. */
+}	t_lr_stats;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Function prototypes.                                                   * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Initialize zeroed counters for a grammar.
+ *
+ * @param stats Counters to initialize.
+ * @param state_count Number of states of the grammar.
+ * @param prod_count Number of productions of the grammar.
+ * @param allocator Allocator of the arrays, NULL for the default one.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error	lr_stats_init(
+				t_lr_stats *stats,
+				size_t state_count,
+				size_t prod_count,
+				const t_lr_allocator *allocator
+				);
+
+/**
+ * @brief Zero the counters.
+ *
+ * @param stats Counters.
+ */
+void		lr_stats_clear(
+				t_lr_stats *stats
+				);
+
+/**
+ * @brief Copy counters into others of the same grammar.
+ *
+ * @param dst Destination counters.
+ * @param src Source counters.
+ * @return LR_OK on success, LR_INTERNAL_ERROR if their sizes differ.
+ */
+t_lr_error	lr_stats_copy(
+				t_lr_stats *dst,
+				const t_lr_stats *src
+				);
+
+/**
+ * @brief Free the arrays of counters.
+ *
+ * @param stats Counters.
+ */
+void		lr_stats_destroy(
+				t_lr_stats *stats
+				);
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private function.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Count a shift.
+ *
+ * @param stats Counters.
+ * @param state_id State the shift leaves.
+ * @param depth Stack depth after the shift.
+ */
+void		_lr_stats_shift(
+				t_lr_stats *stats,
+				t_lr_state_id state_id,
+				size_t depth
+				);
+
+/**
+ * @brief Count a reduction.
+ *
+ * @param stats Counters.
+ * @param state_id State the reduction happens in.
+ * @param prod_id Production reduced by.
+ * @param ns Nanoseconds spent in its callback.
+ */
+void		_lr_stats_reduce(
+				t_lr_stats *stats,
+				t_lr_state_id state_id,
+				t_lr_prod_id prod_id,
+				uint64_t ns
+				);
+
+/**
+ * @brief Read the monotonic clock timing the callbacks.
+ *
+ * @return Nanoseconds.
+ */
+uint64_t	_lr_stats_now(void);
+
+#endif
@@ -21,6 +21,14 @@
 #ifndef LR_TOKEN_H
 # define LR_TOKEN_H
 
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+# include <stdint.h>
+
 // ************************************************************************** //
 // *                                                                        * //
 // * Structure definitions.                                                 * //
@@ -73,4 +81,12 @@ typedef struct s_lr_token
 	t_lr_token_type	data;	/**< Token data payload. */
 }	t_lr_token;
 
+/**
+ * @brief Index of a token in the token buffer of a parse.
+ *
+ * Stored on the stack in place of the token itself when MP_TOKEN_REF is
+ * defined, see lr_parser_set_tokens.
+ */
+typedef uint32_t		t_lr_token_ref;
+
 #endif
@@ -0,0 +1,253 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lr_trace.h                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:58:12 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 23:58:12 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file lr_trace.h
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Parser action trace ring (MP_TRACE).
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef LR_TRACE_H
+# define LR_TRACE_H
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+# include <stddef.h>
+# include <stdint.h>
+
+# include "lr_type.h"
+# include "lr_error.h"
+# include "lr_alloc.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Defines.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Magic number of saved traces ("MPTL" on little endian hosts).
+ */
+# define LR_TRACE_MAGIC	0x4c54504du
+
+/**
+ * @brief Version of the saved trace format.
+ */
+# define LR_TRACE_VERSION	1
+
+/**
+ * @brief Bits of the token or production ID of a record.
+ */
+# define LR_TRACE_ID_BITS	30
+
+/**
+ * @brief Largest token or production ID a record holds.
+ */
+# define LR_TRACE_ID_MAX	((1u << LR_TRACE_ID_BITS) - 1)
+
+/**
+ * @brief Type of a record.
+ */
+# define LR_TRACE_TYPE(record)	((t_lr_trace_type)((record).data \
+	>> LR_TRACE_ID_BITS))
+
+/**
+ * @brief Token or production ID of a record.
+ */
+# define LR_TRACE_ID(record)	((record).data & LR_TRACE_ID_MAX)
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Enum definition.                                                       * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Parser action of a record.
+ */
+typedef enum e_lr_trace_type
+{
+	LR_TRACE_SHIFT,		/**< Token shifted, ID of the token. */
+	LR_TRACE_REDUCE,	/**< Reduction, ID of the production. */
+	LR_TRACE_ACCEPT,	/**< Input accepted, ID 0. */
+	LR_TRACE_ERROR,		/**< Token rejected, ID of the token. */
+}	t_lr_trace_type;
+
+/**
+ * @brief Trace flags.
+ */
+typedef enum e_lr_trace_flag
+{
+	LR_TRACE_TSC = 1 << 0,	/**< Timestamp every record. */
+}	t_lr_trace_flag;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Trace record of a parser action.
+ */
+typedef struct s_lr_trace_record
+{
+	uint32_t	state;	/**< State on top of the stack when it is taken. */
+	uint32_t	data;	/**< Type in the top 2 bits, then the ID. */
+}	t_lr_trace_record;
+
+/**
+ * @brief Ring of trace records.
+ *
+ * A parser context built with MP_TRACE, once given a trace with
+ * lr_parser_set_trace, appends a record after each of its actions: shifts,
+ * reductions, accepts and syntax errors. The ring holds a power of two
+ * records and overwrites the oldest ones when full, so tracing never
+ * allocates nor fails: a record costs two stores, cheap enough to leave
+ * tracing on. With LR_TRACE_TSC every record is also timestamped, with the
+ * time stamp counter where there is one and the monotonic clock in
+ * nanoseconds otherwise, which costs more than the record itself. A trace
+ * is not thread safe, each thread needs its own.
+ */
+typedef struct s_lr_trace
+{
+	t_lr_trace_record		*records;	/**< Ring of records. */
+	uint64_t				*tsc;		/**< Timestamps, or NULL. */
+	uint64_t				head;		/**< Records appended since the clear. */
+	size_t					mask;		/**< Capacity minus one. */
+	int						flags;		/**< Trace flags. */
+	const t_lr_allocator	*allocator;	/**< Allocator of the ring. */
+}	t_lr_trace;
+
+/**
+ * @brief Header of a saved trace.
+ *
+ * A saved trace is this header followed by the count records, oldest
+ * first, then by their timestamps with LR_TRACE_TSC. It is read in place
+ * by hosts of the same byte order, which the magic number checks.
+ */
+typedef struct s_lr_trace_header
+{
+	uint32_t	magic;			/**< LR_TRACE_MAGIC. */
+	uint16_t	version;		/**< LR_TRACE_VERSION. */
+	uint8_t		flags;			/**< Trace flags. */
+	uint8_t		record_size;	/**< sizeof(t_lr_trace_record). */
+	uint64_t	count;			/**< Number of records. */
+	uint64_t	dropped;		/**< Older records overwritten by the ring. */
+}	t_lr_trace_header;
+
+/**
+ * @brief Read-only view of a saved trace.
+ */
+typedef struct s_lr_trace_view
+{
+	const t_lr_trace_record	*records;	/**< Records, oldest first. */
+	const uint64_t			*tsc;		/**< Their timestamps, or NULL. */
+	size_t					count;		/**< Number of records. */
+	uint64_t				dropped;	/**< Records lost before the first. */
+}	t_lr_trace_view;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Function prototypes.                                                   * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Initialize an empty trace.
+ *
+ * @param trace Trace to initialize.
+ * @param capacity Records kept, rounded up to a power of two.
+ * @param flags 0 or LR_TRACE_TSC.
+ * @param allocator Allocator of the ring, NULL for the default one.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error	lr_trace_init(
+				t_lr_trace *trace,
+				size_t capacity,
+				int flags,
+				const t_lr_allocator *allocator
+				);
+
+/**
+ * @brief Drop every record of a trace.
+ *
+ * @param trace Trace.
+ */
+void		lr_trace_clear(
+				t_lr_trace *trace
+				);
+
+/**
+ * @brief Free the ring of a trace.
+ *
+ * @param trace Trace.
+ */
+void		lr_trace_destroy(
+				t_lr_trace *trace
+				);
+
+/**
+ * @brief Save the records of a trace to a file, oldest first.
+ *
+ * @param trace Trace.
+ * @param path Path of the file, created or truncated.
+ * @return LR_OK on success, LR_IO_ERROR on failure.
+ */
+t_lr_error	lr_trace_save(
+				const t_lr_trace *trace,
+				const char *path
+				);
+
+/**
+ * @brief Read a saved trace in place.
+ *
+ * @param view Output view.
+ * @param data Saved trace, aligned for a uint64_t, which must outlive the
+ *             view.
+ * @param size Size of data in bytes.
+ * @return LR_OK on success, LR_BAD_FORMAT if data is not a valid trace.
+ */
+t_lr_error	lr_trace_view(
+				t_lr_trace_view *view,
+				const void *data,
+				size_t size
+				);
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private function.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Append a record to a trace.
+ *
+ * @param trace Trace.
+ * @param type Parser action.
+ * @param state_id State on top of the stack.
+ * @param id Token or production ID, 0 for an accept.
+ */
+void		_lr_trace_put(
+				t_lr_trace *trace,
+				t_lr_trace_type type,
+				t_lr_state_id state_id,
+				uint32_t id
+				);
+
+#endif
@@ -0,0 +1,277 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lr_tree.h                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 20:14:39 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 20:14:39 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file lr_tree.h
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Flat post-order parse tree.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef LR_TREE_H
+# define LR_TREE_H
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+# include <stddef.h>
+# include <stdint.h>
+
+# include "lr_type.h"
+# include "lr_error.h"
+# include "lr_alloc.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Defines.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Production ID of the leaves, which stand for a shifted token.
+ */
+# define LR_TREE_TOKEN	((t_lr_prod_id)-1)
+
+/**
+ * @brief Magic number of serialized trees ("MPTR" on little endian hosts).
+ */
+# define LR_TREE_MAGIC	0x5254504du
+
+/**
+ * @brief Version of the serialized tree format.
+ */
+# define LR_TREE_VERSION	1
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Parse tree node.
+ *
+ * A leaf covers exactly the token at first_token; an inner node covers the
+ * tokens of its children.
+ */
+typedef struct s_lr_tree_node
+{
+	t_lr_prod_id	prod_id;		/**< Production, or LR_TREE_TOKEN. */
+	uint32_t		child_count;	/**< Number of direct children. */
+	uint32_t		size;			/**< Nodes in the subtree, node included. */
+	uint32_t		first_token;	/**< Index of the first covered token. */
+	uint32_t		token_count;	/**< Number of covered tokens. */
+}	t_lr_tree_node;
+
+/**
+ * @brief Parse tree structure.
+ *
+ * The nodes are stored in post-order in a single array: children come
+ * before their parent and the root is the last node. Iterating over the
+ * array visits the tree bottom-up; the children of a node are reached from
+ * its last one (the previous node) by jumping over the subtree sizes. A
+ * tree holds no pointer, so it may be copied, saved or handed over to
+ * another thread as is. Tokens are referred to by their index in the input.
+ */
+typedef struct s_lr_tree
+{
+	t_lr_tree_node			*nodes;		/**< Nodes in post-order. */
+	size_t					count;		/**< Number of nodes. */
+	size_t					alloced;	/**< Allocated capacity. */
+	const t_lr_allocator	*allocator;	/**< Allocator of the nodes. */
+}	t_lr_tree;
+
+/**
+ * @brief Header of a serialized tree.
+ *
+ * A serialized tree is this header followed by the count nodes, laid out
+ * exactly like t_lr_tree_node, so it can be read in place. Trees are only
+ * exchanged between hosts of the same byte order and ID width, which the
+ * magic number and the sizes check.
+ */
+typedef struct s_lr_tree_header
+{
+	uint32_t	magic;			/**< LR_TREE_MAGIC. */
+	uint16_t	version;		/**< LR_TREE_VERSION. */
+	uint8_t		prod_id_size;	/**< sizeof(t_lr_prod_id). */
+	uint8_t		node_size;		/**< sizeof(t_lr_tree_node). */
+	uint64_t	count;			/**< Number of nodes. */
+}	t_lr_tree_header;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Function prototypes.                                                   * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Initialize an empty parse tree.
+ *
+ * @param tree Pointer to the tree to initialize.
+ * @param allocator Allocator of the nodes, NULL for the default one.
+ */
+void			lr_tree_init(
+					t_lr_tree *tree,
+					const t_lr_allocator *allocator
+					);
+
+/**
+ * @brief Append a node to a parse tree.
+ *
+ * @param tree Pointer to the tree.
+ * @param node Node to append.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error		lr_tree_push(
+					t_lr_tree *tree,
+					const t_lr_tree_node *node
+					);
+
+/**
+ * @brief Get the index of the root of a parse tree.
+ *
+ * @param tree Pointer to a non empty tree.
+ * @return Index of the root node.
+ */
+size_t			lr_tree_root(
+					const t_lr_tree *tree
+					);
+
+/**
+ * @brief Get the index of the last child of a node.
+ *
+ * @param tree Pointer to the tree.
+ * @param node Index of a node with children.
+ * @return Index of its last child.
+ */
+size_t			lr_tree_last_child(
+					const t_lr_tree *tree,
+					size_t node
+					);
+
+/**
+ * @brief Get the index of the previous sibling of a node.
+ *
+ * @param tree Pointer to the tree.
+ * @param node Index of a node that is not the first child of its parent.
+ * @return Index of its previous sibling.
+ */
+size_t			lr_tree_prev_sibling(
+					const t_lr_tree *tree,
+					size_t node
+					);
+
+/**
+ * @brief Remove every node of a parse tree and keep its buffer.
+ *
+ * @param tree Pointer to the tree.
+ */
+void			lr_tree_clear(
+					t_lr_tree *tree
+					);
+
+/**
+ * @brief Free the nodes of a parse tree.
+ *
+ * Does nothing on a view, which owns no node.
+ *
+ * @param tree Pointer to the tree.
+ */
+void			lr_tree_destroy(
+					t_lr_tree *tree
+					);
+
+/**
+ * @brief Get the size of a serialized parse tree.
+ *
+ * @param tree Pointer to the tree.
+ * @return Size in bytes, header included.
+ */
+size_t			lr_tree_serialized_size(
+					const t_lr_tree *tree
+					);
+
+/**
+ * @brief Serialize a parse tree.
+ *
+ * @param tree Pointer to the tree.
+ * @param buf Output buffer of lr_tree_serialized_size bytes, aligned for
+ *            a uint64_t.
+ * @return Number of bytes written.
+ */
+size_t			lr_tree_serialize(
+					const t_lr_tree *tree,
+					void *buf
+					);
+
+/**
+ * @brief Read a serialized parse tree in place.
+ *
+ * Checks the header and the structure of the nodes once, then makes tree
+ * a read-only view of the nodes in data: no node is copied. A view must
+ * not be appended to, and lr_tree_destroy leaves data alone.
+ *
+ * @param tree Output tree view.
+ * @param data Serialized tree, aligned for a uint64_t, which must outlive
+ *             the view.
+ * @param size Size of data in bytes.
+ * @return LR_OK on success, LR_BAD_FORMAT if data is not a valid tree.
+ */
+t_lr_error		lr_tree_view(
+					t_lr_tree *tree,
+					const void *data,
+					size_t size
+					);
+
+/**
+ * @brief Save a parse tree to a file.
+ *
+ * @param tree Pointer to the tree.
+ * @param path Path of the file, created or truncated.
+ * @return LR_OK on success, LR_IO_ERROR on failure.
+ */
+t_lr_error		lr_tree_save(
+					const t_lr_tree *tree,
+					const char *path
+					);
+
+/**
+ * @brief Map a saved parse tree read-only.
+ *
+ * Maps the file and reads it with lr_tree_view, so opening a tree costs
+ * one validation pass and no copy, and processes mapping the same file
+ * share its pages. Release the view with lr_tree_unmap.
+ *
+ * @param tree Output tree view.
+ * @param path Path of the file.
+ * @return LR_OK on success, LR_IO_ERROR if the file cannot be mapped,
+ *         LR_BAD_FORMAT if it is not a valid tree.
+ */
+t_lr_error		lr_tree_map(
+					t_lr_tree *tree,
+					const char *path
+					);
+
+/**
+ * @brief Unmap a parse tree mapped by lr_tree_map.
+ *
+ * @param tree Pointer to the tree view.
+ */
+void			lr_tree_unmap(
+					t_lr_tree *tree
+					);
+
+#endif
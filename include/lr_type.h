@@ -21,19 +21,44 @@
 #ifndef LR_TYPE_H
 # define LR_TYPE_H
 
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+# include <stdint.h>
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Configuration.                                                         * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Width in bits of state and production IDs (8, 16 or 32).
+ *
+ * Must be the same for the library and every unit including its headers.
+ */
+# ifndef MP_ID_BITS
+#  define MP_ID_BITS 32
+# endif
+
 // ************************************************************************** //
 // *                                                                        * //
 // * Typedefs.                                                              * //
 // *                                                                        * //
 // ************************************************************************** //
 
+# if MP_ID_BITS == 8
+
 /**
  * @brief Identifier for LR parser states.
  *
  * This type represents the state identifier in the LR parsing automaton.
  * Each state in the parsing table is identified by a unique integer value.
  */
-typedef int	t_lr_state_id;
+typedef uint8_t		t_lr_state_id;
 
 /**
  * @brief Identifier for production rules.
@@ -41,6 +66,37 @@ typedef int	t_lr_state_id;
  * This type represents a production rule identifier in the grammar.
  * Each production rule used for reductions is identified by a unique integer.
  */
-typedef int	t_lr_prod_id;
+typedef uint8_t		t_lr_prod_id;
+
+# elif MP_ID_BITS == 16
+
+typedef uint16_t	t_lr_state_id;
+typedef uint16_t	t_lr_prod_id;
+
+# elif MP_ID_BITS == 32
+
+typedef uint32_t	t_lr_state_id;
+typedef uint32_t	t_lr_prod_id;
+
+# else
+
+#  error MP_ID_BITS must be 8, 16 or 32 !
+
+# endif
+
+/**
+ * @brief State ID never used by a table, marks an empty slot.
+ */
+# define LR_STATE_NONE	((t_lr_state_id)-1)
+
+/**
+ * @brief Production ID never used by a table, marks a missing production.
+ */
+# define LR_PROD_NONE	((t_lr_prod_id)-1)
+
+/**
+ * @brief LR parser context, defined in lr_parser.h.
+ */
+typedef struct s_lr_parser_ctx	t_lr_parser_ctx;
 
 #endif
@@ -0,0 +1,153 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   alloc.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:12:30 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 18:12:30 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file alloc.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Default allocator and allocator helpers.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdlib.h>
+
+#include "lr_alloc.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief malloc wrapper of the default allocator.
+ */
+static void	*_lr_default_alloc(
+				void *state,
+				size_t size
+				)
+{
+	(void)state;
+	return (malloc(size));
+}
+
+/**
+ * @brief realloc wrapper of the default allocator.
+ */
+static void	*_lr_default_realloc(
+				void *state,
+				void *ptr,
+				size_t oldsize,
+				size_t newsize
+				)
+{
+	(void)state;
+	(void)oldsize;
+	return (realloc(ptr, newsize));
+}
+
+/**
+ * @brief free wrapper of the default allocator.
+ */
+static void	_lr_default_free(
+				void *state,
+				void *ptr,
+				size_t size
+				)
+{
+	(void)state;
+	(void)size;
+	free(ptr);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Global variables.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+const t_lr_allocator	g_lr_default_allocator = {
+	.alloc = _lr_default_alloc,
+	.realloc = _lr_default_realloc,
+	.free = _lr_default_free,
+	.state = NULL,
+};
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Allocate memory with an allocator.
+ *
+ * @param allocator Allocator, NULL for the default one.
+ * @param size Size in bytes.
+ * @return Pointer to the block, or NULL on allocation failure.
+ */
+void	*lr_alloc(
+			const t_lr_allocator *allocator,
+			size_t size
+			)
+{
+	if (allocator == NULL)
+		allocator = &g_lr_default_allocator;
+	return (allocator->alloc(allocator->state, size));
+}
+
+/**
+ * @brief Resize memory allocated with an allocator.
+ *
+ * @param allocator Allocator, NULL for the default one.
+ * @param ptr Block to resize.
+ * @param oldsize Current size of the block in bytes.
+ * @param newsize New size in bytes.
+ * @return Pointer to the block, or NULL on allocation failure.
+ */
+void	*lr_realloc(
+			const t_lr_allocator *allocator,
+			void *ptr,
+			size_t oldsize,
+			size_t newsize
+			)
+{
+	if (allocator == NULL)
+		allocator = &g_lr_default_allocator;
+	return (allocator->realloc(allocator->state, ptr, oldsize, newsize));
+}
+
+/**
+ * @brief Free memory allocated with an allocator.
+ *
+ * @param allocator Allocator, NULL for the default one.
+ * @param ptr Block to free, may be NULL.
+ * @param size Size of the block in bytes.
+ */
+void	lr_free(
+			const t_lr_allocator *allocator,
+			void *ptr,
+			size_t size
+			)
+{
+	if (ptr == NULL)
+		return ;
+	if (allocator == NULL)
+		allocator = &g_lr_default_allocator;
+	allocator->free(allocator->state, ptr, size);
+}
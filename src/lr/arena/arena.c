@@ -0,0 +1,190 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   arena.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 19:05:12 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 19:05:12 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file arena.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Region allocator implementation.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include "lr_arena.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Defines.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Round a size up to the arena alignment.
+ */
+#define LR_ARENA_ROUND(size)	(((size) + LR_ARENA_ALIGN - 1) \
+	& ~(LR_ARENA_ALIGN - 1))
+
+/**
+ * @brief Offset of the chunk bytes after the chunk header.
+ */
+#define LR_ARENA_HEADER	LR_ARENA_ROUND(sizeof(t_lr_arena_chunk))
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Make cur the chunk being filled.
+ */
+static void	_lr_arena_use(
+				t_lr_arena *arena,
+				t_lr_arena_chunk *chunk
+				)
+{
+	arena->cur = chunk;
+	arena->ptr = (char *)chunk + LR_ARENA_HEADER;
+	arena->end = arena->ptr + chunk->size;
+}
+
+/**
+ * @brief Move to a chunk with room for size bytes.
+ *
+ * Reuses the next chunk kept by a reset when it is large enough, otherwise
+ * inserts a new chunk after the current one.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int	_lr_arena_grow(
+				t_lr_arena *arena,
+				size_t size
+				)
+{
+	t_lr_arena_chunk	*chunk;
+	size_t				chunk_size;
+
+	if (arena->cur != NULL && arena->cur->next != NULL
+		&& arena->cur->next->size >= size)
+		return (_lr_arena_use(arena, arena->cur->next), 0);
+	chunk_size = arena->chunk_size;
+	if (chunk_size < size)
+		chunk_size = size;
+	chunk = lr_alloc(arena->allocator, LR_ARENA_HEADER + chunk_size);
+	if (chunk == NULL)
+		return (-1);
+	chunk->size = chunk_size;
+	chunk->next = NULL;
+	if (arena->cur == NULL)
+		arena->head = chunk;
+	else
+	{
+		chunk->next = arena->cur->next;
+		arena->cur->next = chunk;
+	}
+	_lr_arena_use(arena, chunk);
+	return (0);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Initialize an empty arena.
+ *
+ * @param arena Arena to initialize.
+ * @param allocator Allocator of the chunks, NULL for the default one.
+ * @param chunk_size Minimum size of a chunk in bytes, 0 for
+ *                   LR_ARENA_CHUNK_SIZE.
+ */
+void	lr_arena_init(
+			t_lr_arena *arena,
+			const t_lr_allocator *allocator,
+			size_t chunk_size
+			)
+{
+	if (chunk_size == 0)
+		chunk_size = LR_ARENA_CHUNK_SIZE;
+	*arena = (t_lr_arena){.chunk_size = LR_ARENA_ROUND(chunk_size),
+		.allocator = allocator};
+}
+
+/**
+ * @brief Allocate memory from an arena.
+ *
+ * Bumps the current chunk pointer, moving to another chunk only when the
+ * current one is full.
+ *
+ * @param arena Arena.
+ * @param size Size in bytes.
+ * @return Pointer aligned on LR_ARENA_ALIGN, or NULL on allocation failure.
+ */
+void	*lr_arena_alloc(
+			t_lr_arena *arena,
+			size_t size
+			)
+{
+	void	*p;
+
+	if (size == 0)
+		size = 1;
+	size = LR_ARENA_ROUND(size);
+	if ((size_t)(arena->end - arena->ptr) < size
+		&& _lr_arena_grow(arena, size) < 0)
+		return (NULL);
+	p = arena->ptr;
+	arena->ptr += size;
+	return (p);
+}
+
+/**
+ * @brief Release every allocation of an arena at once.
+ *
+ * @param arena Arena.
+ */
+void	lr_arena_reset(
+			t_lr_arena *arena
+			)
+{
+	if (arena->head != NULL)
+		_lr_arena_use(arena, arena->head);
+}
+
+/**
+ * @brief Free every chunk of an arena.
+ *
+ * @param arena Arena.
+ */
+void	lr_arena_destroy(
+			t_lr_arena *arena
+			)
+{
+	t_lr_arena_chunk	*chunk;
+	t_lr_arena_chunk	*next;
+
+	chunk = arena->head;
+	while (chunk != NULL)
+	{
+		next = chunk->next;
+		lr_free(arena->allocator, chunk, LR_ARENA_HEADER + chunk->size);
+		chunk = next;
+	}
+	lr_arena_init(arena, arena->allocator, arena->chunk_size);
+}
@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   io.c                                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 21:20:44 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 21:20:44 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file io.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief File helpers of the serialized formats implementation.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "lr_io.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Write a whole buffer to a file descriptor.
+ *
+ * Retries partial writes until everything is written.
+ *
+ * @param fd File descriptor.
+ * @param buf Buffer to write.
+ * @param size Size of buf in bytes.
+ * @return 0 on success, -1 on failure.
+ */
+int	lr_io_write(
+		int fd,
+		const void *buf,
+		size_t size
+		)
+{
+	ssize_t	r;
+
+	while (size != 0)
+	{
+		r = write(fd, buf, size);
+		if (r <= 0)
+			return (-1);
+		buf = (const char *)buf + r;
+		size -= r;
+	}
+	return (0);
+}
+
+/**
+ * @brief Write zero bytes up to the next multiple of 8 of an offset.
+ *
+ * @param fd File descriptor.
+ * @param offset Number of bytes written so far, updated.
+ * @return 0 on success, -1 on failure.
+ */
+int	lr_io_pad(
+		int fd,
+		size_t *offset
+		)
+{
+	static const char	zeros[8];
+	const size_t		pad = -*offset & 7;
+
+	*offset += pad;
+	return (lr_io_write(fd, zeros, pad));
+}
+
+/**
+ * @brief Map a whole file read-only.
+ *
+ * The mapping is shared, so processes mapping the same file share its
+ * pages.
+ *
+ * @param path Path of the file.
+ * @param size Output size of the mapping.
+ * @return The mapping, or NULL if the file is empty or cannot be mapped.
+ */
+void	*lr_io_map(
+			const char *path,
+			size_t *size
+			)
+{
+	struct stat	st;
+	void		*data;
+	int			fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (NULL);
+	data = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && st.st_size > 0)
+		data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return (NULL);
+	*size = st.st_size;
+	return (data);
+}
+
+/**
+ * @brief Unmap a file mapped by lr_io_map.
+ *
+ * @param data Mapping, may be NULL.
+ * @param size Size of the mapping.
+ */
+void	lr_io_unmap(
+			void *data,
+			size_t size
+			)
+{
+	if (data != NULL)
+		munmap(data, size);
+}
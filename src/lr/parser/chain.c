@@ -0,0 +1,654 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   chain.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:58:21 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 23:58:21 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file chain.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Precomputed chains of unit reductions.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lr_grammar.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Working state of the chain builder.
+ */
+typedef struct s_lr_chain_work
+{
+	const t_lr_grammar	*grammar;	/**< Grammar. */
+	char				*unit;		/**< States reducing by a unit prod. */
+	uint64_t			*preds;		/**< Predecessor set of every state. */
+	uint64_t			*set;		/**< States uncovered by a lookback. */
+	uint64_t			*next;		/**< Next step of the lookback. */
+	size_t				*last;		/**< Last state looked back per prod. */
+	size_t				words;		/**< Words of a set of states. */
+	size_t				*edges;		/**< Transitions, under * states + top. */
+	size_t				edge_count;	/**< Number of transitions. */
+	t_lr_chain			*chains;	/**< Chains found. */
+	size_t				count;		/**< Number of chains found. */
+	size_t				edge_first;	/**< First chain of the current edge. */
+	size_t				alloced;	/**< Capacity of chains. */
+	t_lr_prod_id		*prods;		/**< Productions of the chains. */
+	t_lr_state_id		*states;	/**< State each production reduces in. */
+	size_t				prod_used;	/**< Productions used. */
+	size_t				prod_alloced;	/**< Capacity of prods. */
+	size_t				state_alloced;	/**< Capacity of states. */
+}	t_lr_chain_work;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Hash a chain key.
+ */
+static size_t	_lr_chain_hash(
+					size_t under,
+					size_t top,
+					t_lr_token_id token_id
+					)
+{
+	size_t	h;
+
+	h = under * 0x9e3779b1u;
+	h = (h ^ top) * 0x85ebca6bu;
+	h = (h ^ (size_t)token_id) * 0xc2b2ae35u;
+	return (h ^ h >> 15);
+}
+
+/**
+ * @brief Grow an array to hold one more element.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int	_lr_reserve(
+				void **array,
+				size_t *alloced,
+				size_t used,
+				size_t elem
+				)
+{
+	void	*grown;
+
+	if (used < *alloced)
+		return (0);
+	grown = realloc(*array, (*alloced * 2 + 16) * elem);
+	if (grown == NULL)
+		return (-1);
+	*array = grown;
+	*alloced = *alloced * 2 + 16;
+	return (0);
+}
+
+/**
+ * @brief Mark the states that reduce by a unit production on some token.
+ *
+ * @return 1 if every action of the table is in range, 0 otherwise.
+ */
+static int	_lr_mark_units(
+				t_lr_chain_work *w
+				)
+{
+	const t_lr_grammar	*grammar = w->grammar;
+	t_lr_action			action;
+	size_t				k;
+
+	k = 0;
+	while (k < grammar->state_count * grammar->token_count)
+	{
+		action = lr_grammar_action(grammar, k / grammar->token_count,
+				k % grammar->token_count);
+		if ((action.type == ACTION_SHIFT
+				&& action.data.shift_id >= grammar->state_count)
+			|| (action.type == ACTION_REDUCE
+				&& action.data.reduce_id >= grammar->prod_count))
+			return (0);
+		if (action.type == ACTION_REDUCE
+			&& grammar->prod_cb[action.data.reduce_id].size == 1)
+			w->unit[k / grammar->token_count] = 1;
+		++k;
+	}
+	return (1);
+}
+
+/**
+ * @brief Tell whether a state is in a set of states.
+ */
+static int	_lr_has(
+				const uint64_t *set,
+				size_t state_id
+				)
+{
+	return (set[state_id / 64] >> (state_id % 64) & 1);
+}
+
+/**
+ * @brief Record a transition in the predecessors of its target.
+ *
+ * @return 1 if it is new, 0 otherwise.
+ */
+static size_t	_lr_add_pred(
+					t_lr_chain_work *w,
+					size_t from,
+					size_t to
+					)
+{
+	const uint64_t	bit = (uint64_t)1 << (from % 64);
+	uint64_t		*word;
+
+	word = w->preds + to * w->words + from / 64;
+	if (*word & bit)
+		return (0);
+	*word |= bit;
+	return (1);
+}
+
+/**
+ * @brief Record the gotos a reduction takes.
+ *
+ * Goes back from the reducing state one known transition per item popped,
+ * which gives the states the reduction uncovers, and records their goto by
+ * the production.
+ *
+ * @return Number of new transitions.
+ */
+static size_t	_lr_lookback(
+					t_lr_chain_work *w,
+					size_t state_id,
+					t_lr_prod_id prod_id
+					)
+{
+	const size_t	states = w->grammar->state_count;
+	t_lr_state_id	target;
+	size_t			size;
+	size_t			added;
+	size_t			k;
+	size_t			i;
+
+	memset(w->set, 0, w->words * sizeof(*w->set));
+	w->set[state_id / 64] |= (uint64_t)1 << (state_id % 64);
+	size = w->grammar->prod_cb[prod_id].size;
+	while (size-- > 0)
+	{
+		memset(w->next, 0, w->words * sizeof(*w->next));
+		k = 0;
+		while (k < states)
+		{
+			i = 0;
+			while (_lr_has(w->set, k) && i < w->words)
+			{
+				w->next[i] |= w->preds[k * w->words + i];
+				++i;
+			}
+			++k;
+		}
+		memcpy(w->set, w->next, w->words * sizeof(*w->set));
+	}
+	added = 0;
+	k = 0;
+	while (k < states)
+	{
+		target = lr_grammar_goto(w->grammar, k, prod_id);
+		if (_lr_has(w->set, k) && target != 0 && target < states)
+			added += _lr_add_pred(w, k, target);
+		++k;
+	}
+	return (added);
+}
+
+/**
+ * @brief Find the transitions the automaton takes.
+ *
+ * Starts from the shifts, then records the gotos of every reduction until
+ * no new transition shows up. Goto cells that no reduction reaches, like
+ * the defaults of a compressed goto table, are left out.
+ */
+static void	_lr_collect_preds(
+				t_lr_chain_work *w
+				)
+{
+	const t_lr_grammar	*grammar = w->grammar;
+	const size_t		cells = grammar->state_count * grammar->token_count;
+	t_lr_action			action;
+	size_t				added;
+	size_t				state;
+	size_t				k;
+
+	k = 0;
+	while (k < cells)
+	{
+		action = lr_grammar_action(grammar, k / grammar->token_count,
+				k % grammar->token_count);
+		if (action.type == ACTION_SHIFT)
+			_lr_add_pred(w, k / grammar->token_count, action.data.shift_id);
+		++k;
+	}
+	added = 1;
+	while (added != 0)
+	{
+		added = 0;
+		memset(w->last, 0, grammar->prod_count * sizeof(*w->last));
+		k = 0;
+		while (k < cells)
+		{
+			state = k / grammar->token_count;
+			action = lr_grammar_action(grammar, state, k++
+					% grammar->token_count);
+			if (action.type != ACTION_REDUCE
+				|| w->last[action.data.reduce_id] == state + 1)
+				continue ;
+			w->last[action.data.reduce_id] = state + 1;
+			added += _lr_lookback(w, state, action.data.reduce_id);
+		}
+	}
+}
+
+/**
+ * @brief Collect the transitions the automaton takes into marked states.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int	_lr_collect_edges(
+				t_lr_chain_work *w
+				)
+{
+	const size_t	states = w->grammar->state_count;
+	size_t			alloced;
+	size_t			top;
+	size_t			u;
+
+	_lr_collect_preds(w);
+	alloced = 0;
+	top = 0;
+	while (top < states)
+	{
+		u = 0;
+		while (w->unit[top] && u < states)
+		{
+			if (_lr_has(w->preds + top * w->words, u)
+				&& _lr_reserve((void **)&w->edges, &alloced, w->edge_count,
+					sizeof(*w->edges)) < 0)
+				return (-1);
+			if (_lr_has(w->preds + top * w->words, u))
+				w->edges[w->edge_count++] = u * states + top;
+			++u;
+		}
+		++top;
+	}
+	return (0);
+}
+
+/**
+ * @brief Append the next production of a chain and the state it reduces in.
+ *
+ * Every unit reduction is kept as a step of its own, with or without
+ * callback, so counters and traces see the same reductions as without
+ * chains.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int	_lr_chain_push(
+				t_lr_chain_work *w,
+				t_lr_state_id state_id,
+				t_lr_prod_id prod_id
+				)
+{
+	if (_lr_reserve((void **)&w->prods, &w->prod_alloced, w->prod_used,
+			sizeof(*w->prods)) < 0
+		|| _lr_reserve((void **)&w->states, &w->state_alloced, w->prod_used,
+			sizeof(*w->states)) < 0)
+		return (-1);
+	w->states[w->prod_used] = state_id;
+	w->prods[w->prod_used++] = prod_id;
+	return (0);
+}
+
+/**
+ * @brief Share the steps of a new chain with an identical one.
+ *
+ * The chains of a transition on different tokens often run the same
+ * reductions, their steps are then stored once.
+ */
+static void	_lr_chain_share(
+				t_lr_chain_work *w,
+				t_lr_chain *chain
+				)
+{
+	const t_lr_chain	*other;
+	size_t				k;
+
+	k = w->edge_first;
+	while (k < w->count)
+	{
+		other = w->chains + k++;
+		if (other->count == chain->count
+			&& memcmp(w->prods + other->first, w->prods + chain->first,
+				chain->count * sizeof(*w->prods)) == 0
+			&& memcmp(w->states + other->first, w->states + chain->first,
+				chain->count * sizeof(*w->states)) == 0)
+		{
+			w->prod_used = chain->first;
+			chain->first = other->first;
+			return ;
+		}
+	}
+}
+
+/**
+ * @brief Follow the unit reductions of a transition on a token.
+ *
+ * The state under the top item stays the same along the chain, so every
+ * goto is known. Chains of less than two reductions are dropped.
+ *
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_INTERNAL_ERROR if a goto is out of range.
+ */
+static t_lr_error	_lr_chain_walk(
+						t_lr_chain_work *w,
+						size_t edge,
+						t_lr_token_id token_id
+						)
+{
+	const t_lr_grammar	*grammar = w->grammar;
+	t_lr_chain			chain;
+	t_lr_action			action;
+
+	chain = (t_lr_chain){.under = edge / grammar->state_count,
+		.top = edge % grammar->state_count, .token_id = token_id,
+		.state = edge % grammar->state_count, .first = w->prod_used};
+	action = lr_grammar_action(grammar, chain.state, token_id);
+	while (action.type == ACTION_REDUCE
+		&& w->prod_used - chain.first < grammar->state_count
+		&& grammar->prod_cb[action.data.reduce_id].size == 1)
+	{
+		if (_lr_chain_push(w, chain.state, action.data.reduce_id) < 0)
+			return (LR_BAD_ALLOC);
+		chain.state = lr_grammar_goto(grammar, chain.under,
+				action.data.reduce_id);
+		if (chain.state >= grammar->state_count)
+			return (LR_INTERNAL_ERROR);
+		action = lr_grammar_action(grammar, chain.state, token_id);
+	}
+	chain.count = w->prod_used - chain.first;
+	if (chain.count < 2)
+		w->prod_used = chain.first;
+	if (chain.count < 2)
+		return (LR_OK);
+	_lr_chain_share(w, &chain);
+	if (_lr_reserve((void **)&w->chains, &w->alloced, w->count,
+			sizeof(*w->chains)) < 0)
+		return (LR_BAD_ALLOC);
+	w->chains[w->count++] = chain;
+	return (LR_OK);
+}
+
+/**
+ * @brief Compare two chains, the longest first, for qsort.
+ */
+static int	_lr_chain_cmp(
+				const void *a,
+				const void *b
+				)
+{
+	return ((((const t_lr_chain *)a)->count < ((const t_lr_chain *)b)->count)
+		- (((const t_lr_chain *)a)->count > ((const t_lr_chain *)b)->count));
+}
+
+/**
+ * @brief Place the steps of the chains kept, shared ones once.
+ *
+ * @param w Working state.
+ * @param moved Output position of each step sequence, by its first step.
+ * @return Number of steps kept.
+ */
+static size_t	_lr_chains_place(
+					const t_lr_chain_work *w,
+					size_t *moved
+					)
+{
+	size_t	steps;
+	size_t	k;
+
+	k = 0;
+	while (k < w->prod_used)
+		moved[k++] = SIZE_MAX;
+	steps = 0;
+	k = 0;
+	while (k < w->count)
+	{
+		if (moved[w->chains[k].first] == SIZE_MAX)
+		{
+			moved[w->chains[k].first] = steps;
+			steps += w->chains[k].count;
+		}
+		++k;
+	}
+	return (steps);
+}
+
+/**
+ * @brief Store the chains found in a single block with their hash table.
+ *
+ * @return The chains, or NULL on allocation failure.
+ */
+static t_lr_chains	*_lr_chains_emit(
+						const t_lr_chain_work *w,
+						size_t *moved
+						)
+{
+	t_lr_chains	*chains;
+	t_lr_chain	*slots;
+	t_lr_chain	chain;
+	size_t		size;
+	size_t		k;
+	size_t		i;
+
+	size = 1;
+	while (size < 2 * w->count)
+		size *= 2;
+	k = _lr_chains_place(w, moved);
+	chains = malloc(sizeof(*chains) + size * sizeof(*slots)
+			+ k * (sizeof(*chains->states) + sizeof(*chains->prods)));
+	if (chains == NULL)
+		return (NULL);
+	slots = (t_lr_chain *)(chains + 1);
+	*chains = (t_lr_chains){.slots = slots,
+		.states = (t_lr_state_id *)(slots + size), .mask = size - 1,
+		.count = w->count};
+	chains->prods = (t_lr_prod_id *)(chains->states + k);
+	k = 0;
+	while (k < size)
+		slots[k++] = (t_lr_chain){.token_id = -1};
+	k = 0;
+	while (k < w->count)
+	{
+		chain = w->chains[k++];
+		chain.first = moved[chain.first];
+		memcpy((void *)(chains->states + chain.first), w->states
+			+ w->chains[k - 1].first, chain.count * sizeof(*chains->states));
+		memcpy((void *)(chains->prods + chain.first), w->prods
+			+ w->chains[k - 1].first, chain.count * sizeof(*chains->prods));
+		i = _lr_chain_hash(chain.under, chain.top, chain.token_id)
+			& chains->mask;
+		while (slots[i].token_id != -1)
+			i = (i + 1) & chains->mask;
+		slots[i] = chain;
+	}
+	return (chains);
+}
+
+/**
+ * @brief Find every chain of a grammar.
+ *
+ * Only walks the tokens on which the top state reduces by a unit
+ * production, and keeps the LR_CHAIN_MAX longest chains.
+ */
+static t_lr_error	_lr_chains_find(
+						t_lr_chain_work *w
+						)
+{
+	t_lr_action	action;
+	t_lr_error	err;
+	size_t		k;
+	size_t		t;
+
+	if (!_lr_mark_units(w))
+		return (LR_INTERNAL_ERROR);
+	if (_lr_collect_edges(w) < 0)
+		return (LR_BAD_ALLOC);
+	err = LR_OK;
+	k = 0;
+	while (k < w->edge_count && err == LR_OK)
+	{
+		w->edge_first = w->count;
+		t = 0;
+		while (t < w->grammar->token_count && err == LR_OK)
+		{
+			action = lr_grammar_action(w->grammar,
+					w->edges[k] % w->grammar->state_count, t);
+			if (action.type == ACTION_REDUCE
+				&& w->grammar->prod_cb[action.data.reduce_id].size == 1)
+				err = _lr_chain_walk(w, w->edges[k], t);
+			++t;
+		}
+		++k;
+	}
+	if (w->count > LR_CHAIN_MAX)
+		qsort(w->chains, w->count, sizeof(*w->chains), _lr_chain_cmp);
+	if (w->count > LR_CHAIN_MAX)
+		w->count = LR_CHAIN_MAX;
+	return (err);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Look up the reduce chain of a unit reduction.
+ *
+ * @param grammar Grammar.
+ * @param under State of the item under the top one.
+ * @param top State of the top item, which reduces by a unit production.
+ * @param token_id Token ahead.
+ * @return The chain, or NULL if the grammar holds none for this key.
+ */
+const t_lr_chain	*lr_grammar_chain(
+						const t_lr_grammar *grammar,
+						t_lr_state_id under,
+						t_lr_state_id top,
+						t_lr_token_id token_id
+						)
+{
+	const t_lr_chains	*chains = grammar->chains;
+	const t_lr_chain	*slot;
+	size_t				k;
+
+	if (chains == NULL)
+		return (NULL);
+	k = _lr_chain_hash(under, top, token_id) & chains->mask;
+	slot = chains->slots + k;
+	while (slot->token_id != -1)
+	{
+		if (slot->under == under && slot->top == top
+			&& slot->token_id == token_id)
+			return (slot);
+		k = (k + 1) & chains->mask;
+		slot = chains->slots + k;
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Precompute the chains of unit reductions of a grammar.
+ *
+ * Leaves chains to NULL when the grammar has no chain at all.
+ *
+ * @param grammar Grammar holding prod_cb and its tables.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_INTERNAL_ERROR if a table entry is out of range.
+ */
+t_lr_error	lr_chains_build(
+				t_lr_grammar *grammar
+				)
+{
+	t_lr_chain_work	w;
+	size_t			*moved;
+	t_lr_error		err;
+
+	grammar->chains = NULL;
+	if (grammar->prod_cb == NULL)
+		return (LR_INTERNAL_ERROR);
+	w = (t_lr_chain_work){.grammar = grammar,
+		.unit = calloc(grammar->state_count + 1, 1),
+		.words = grammar->state_count / 64 + 1};
+	w.preds = calloc(grammar->state_count * w.words, sizeof(*w.preds));
+	w.set = malloc(w.words * sizeof(*w.set));
+	w.next = malloc(w.words * sizeof(*w.next));
+	w.last = malloc((grammar->prod_count + 1) * sizeof(*w.last));
+	err = LR_BAD_ALLOC;
+	if (w.unit != NULL && w.preds != NULL && w.set != NULL && w.next != NULL
+		&& w.last != NULL)
+		err = _lr_chains_find(&w);
+	if (err == LR_OK && w.count != 0)
+	{
+		moved = malloc(w.prod_used * sizeof(*moved));
+		if (moved != NULL)
+			grammar->chains = _lr_chains_emit(&w, moved);
+		if (grammar->chains == NULL)
+			err = LR_BAD_ALLOC;
+		free(moved);
+	}
+	free(w.unit);
+	free(w.preds);
+	free(w.set);
+	free(w.next);
+	free(w.last);
+	free(w.edges);
+	free(w.chains);
+	free(w.prods);
+	free(w.states);
+	return (err);
+}
+
+/**
+ * @brief Free the reduce chains.
+ *
+ * @param grammar Grammar.
+ */
+void	lr_chains_destroy(
+			t_lr_grammar *grammar
+			)
+{
+	free((void *)grammar->chains);
+	grammar->chains = NULL;
+}
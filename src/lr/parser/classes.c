@@ -0,0 +1,282 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   classes.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:12:53 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 22:12:53 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file classes.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Token equivalence classes of the action table columns.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "lr_grammar.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Working state of the class builder.
+ */
+typedef struct s_lr_class_work
+{
+	const t_lr_grammar	*grammar;	/**< Grammar. */
+	size_t				columns;	/**< Columns of its action table. */
+	t_lr_token_id		*token;		/**< A token of each column, or -1. */
+	uint64_t			*hash;		/**< Hash of each column. */
+	size_t				*class;		/**< Class of each column. */
+	size_t				*first;		/**< First column of each class. */
+	size_t				count;		/**< Number of classes. */
+}	t_lr_class_work;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Get the current column of a token.
+ */
+static size_t	_lr_column(
+					const t_lr_grammar *grammar,
+					size_t token_id
+					)
+{
+	if (grammar->token_map != NULL)
+		return (grammar->token_map[token_id]);
+	return (token_id);
+}
+
+/**
+ * @brief Hash the actions of a token in every state.
+ */
+static uint64_t	_lr_column_hash(
+					const t_lr_grammar *grammar,
+					t_lr_token_id token_id
+					)
+{
+	t_lr_action	action;
+	uint64_t	h;
+	size_t		s;
+
+	h = 0xcbf29ce484222325u;
+	s = 0;
+	while (s < grammar->state_count)
+	{
+		action = lr_grammar_action(grammar, s++, token_id);
+		h = (h ^ action.type) * 0x100000001b3u;
+		if (action.type == ACTION_SHIFT)
+			h = (h ^ action.data.shift_id) * 0x100000001b3u;
+		if (action.type == ACTION_REDUCE)
+			h = (h ^ action.data.reduce_id) * 0x100000001b3u;
+	}
+	return (h);
+}
+
+/**
+ * @brief Check if two tokens have the same action in every state.
+ */
+static int	_lr_same_column(
+				const t_lr_grammar *grammar,
+				t_lr_token_id a,
+				t_lr_token_id b
+				)
+{
+	t_lr_action	x;
+	t_lr_action	y;
+	size_t		s;
+
+	s = 0;
+	while (s < grammar->state_count)
+	{
+		x = lr_grammar_action(grammar, s, a);
+		y = lr_grammar_action(grammar, s++, b);
+		if (x.type != y.type
+			|| (x.type == ACTION_SHIFT && x.data.shift_id != y.data.shift_id)
+			|| (x.type == ACTION_REDUCE
+				&& x.data.reduce_id != y.data.reduce_id))
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * @brief Give each column the class of the first identical column.
+ */
+static void	_lr_classes_find(
+				t_lr_class_work *w
+				)
+{
+	size_t	c;
+	size_t	j;
+
+	c = 0;
+	while (c < w->columns)
+	{
+		j = 0;
+		while (w->token[c] >= 0 && j < w->count
+			&& (w->hash[w->first[j]] != w->hash[c]
+				|| !_lr_same_column(w->grammar, w->token[w->first[j]],
+					w->token[c])))
+			++j;
+		w->class[c] = j;
+		if (w->token[c] >= 0 && j == w->count)
+			w->first[w->count++] = c;
+		++c;
+	}
+}
+
+/**
+ * @brief Find the classes of the columns of a grammar.
+ *
+ * @return 1 on success, 0 if a token maps out of the action table.
+ */
+static int	_lr_classes_scan(
+				t_lr_class_work *w
+				)
+{
+	size_t	k;
+
+	k = 0;
+	while (k < w->columns)
+		w->token[k++] = -1;
+	k = 0;
+	while (k < w->grammar->token_count)
+	{
+		if (_lr_column(w->grammar, k) >= w->columns)
+			return (0);
+		if (w->token[_lr_column(w->grammar, k)] < 0)
+			w->token[_lr_column(w->grammar, k)] = k;
+		++k;
+	}
+	k = 0;
+	while (k < w->columns)
+	{
+		if (w->token[k] >= 0)
+			w->hash[k] = _lr_column_hash(w->grammar, w->token[k]);
+		++k;
+	}
+	_lr_classes_find(w);
+	return (1);
+}
+
+/**
+ * @brief Build the narrow action table and the token map of the classes.
+ *
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+static t_lr_error	_lr_classes_emit(
+						const t_lr_class_work *w,
+						t_lr_grammar *grammar
+						)
+{
+	t_lr_action		*actions;
+	t_lr_token_id	*map;
+	size_t			k;
+
+	actions = malloc(grammar->state_count * w->count * sizeof(*actions) + 1);
+	map = malloc(grammar->token_count * sizeof(*map) + 1);
+	if (actions == NULL || map == NULL)
+		return (free(actions), free(map), LR_BAD_ALLOC);
+	k = 0;
+	while (k < grammar->state_count * w->count)
+	{
+		actions[k] = lr_grammar_action(grammar, k / w->count,
+				w->token[w->first[k % w->count]]);
+		++k;
+	}
+	k = 0;
+	while (k < grammar->token_count)
+	{
+		map[k] = w->class[_lr_column(grammar, k)];
+		++k;
+	}
+	grammar->action_table = actions;
+	grammar->packed_table = NULL;
+	grammar->action_comb = NULL;
+	grammar->token_map = map;
+	grammar->column_count = w->count;
+	grammar->verified = 0;
+	return (LR_OK);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Merge the tokens that have the same action in every state.
+ *
+ * Classes are numbered in the order of the columns they come from, so a
+ * previous renumbering of the columns is kept.
+ *
+ * @param grammar Grammar holding its action table.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_INTERNAL_ERROR if a token maps out of the action table.
+ */
+t_lr_error	lr_classes_build(
+				t_lr_grammar *grammar
+				)
+{
+	t_lr_class_work	w;
+	t_lr_error		err;
+
+	w = (t_lr_class_work){.grammar = grammar,
+		.columns = lr_grammar_columns(grammar)};
+	w.token = malloc(w.columns * sizeof(*w.token) + 1);
+	w.hash = malloc(w.columns * sizeof(*w.hash) + 1);
+	w.class = malloc(w.columns * sizeof(*w.class) + 1);
+	w.first = malloc(w.columns * sizeof(*w.first) + 1);
+	err = LR_BAD_ALLOC;
+	if (w.token != NULL && w.hash != NULL && w.class != NULL
+		&& w.first != NULL)
+	{
+		err = LR_INTERNAL_ERROR;
+		if (_lr_classes_scan(&w))
+			err = _lr_classes_emit(&w, grammar);
+	}
+	free(w.token);
+	free(w.hash);
+	free(w.class);
+	free(w.first);
+	return (err);
+}
+
+/**
+ * @brief Free the action table and token map built by lr_classes_build.
+ *
+ * @param grammar Grammar.
+ */
+void	lr_classes_destroy(
+			t_lr_grammar *grammar
+			)
+{
+	free((void *)grammar->action_table);
+	free((void *)grammar->token_map);
+	grammar->action_table = NULL;
+	grammar->token_map = NULL;
+	grammar->column_count = 0;
+}
@@ -0,0 +1,578 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   comb.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:12:41 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 10:12:41 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file comb.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Comb-vector (row displacement) table compression.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdlib.h>
+
+#include "lr_grammar.h"
+
+#include "lr_utils.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private structure.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Working state of the comb packer.
+ *
+ * Every table cell is reduced to an integer key. A cell is an entry of its
+ * row when its key differs from both the row default and the skip key.
+ */
+typedef struct s_lr_comb_work
+{
+	long	*keys;		/**< Row-major rows × cols key matrix. */
+	long	*dflt;		/**< Default key of each row. */
+	long	skip;		/**< Key never stored (-1 if none). */
+	size_t	rows;		/**< Number of rows. */
+	size_t	cols;		/**< Number of columns. */
+	size_t	*base;		/**< Displacement of each row. */
+	long	*check;		/**< Column owning each slot, -1 if free. */
+	long	*next;		/**< Key stored in each slot. */
+	char	*taken;		/**< Displacements already owned by a row. */
+	size_t	cap;		/**< Capacity of check, next and taken. */
+	size_t	size;		/**< Number of slots actually used. */
+}	t_lr_comb_work;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Packer.                                                                * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Tell whether a cell is stored in the comb.
+ */
+static int	_comb_is_entry(
+				const t_lr_comb_work *w,
+				size_t row,
+				size_t col
+				)
+{
+	const long	key = w->keys[row * w->cols + col];
+
+	return (key != w->dflt[row] && key != w->skip);
+}
+
+/**
+ * @brief Hash the entries of a row, used to find duplicated rows quickly.
+ */
+static unsigned long	_comb_hash(
+							const t_lr_comb_work *w,
+							size_t row
+							)
+{
+	unsigned long	h;
+	size_t			col;
+
+	h = 5381;
+	col = 0;
+	while (col < w->cols)
+	{
+		if (_comb_is_entry(w, row, col))
+			h = (h * 33) ^ (col * 0x9e3779b1UL)
+				^ (unsigned long)w->keys[row * w->cols + col];
+		++col;
+	}
+	return (h);
+}
+
+/**
+ * @brief Tell whether two rows have exactly the same entries.
+ */
+static int	_comb_same(
+				const t_lr_comb_work *w,
+				size_t r1,
+				size_t r2
+				)
+{
+	size_t	col;
+	int		e1;
+
+	col = 0;
+	while (col < w->cols)
+	{
+		e1 = _comb_is_entry(w, r1, col);
+		if (e1 != _comb_is_entry(w, r2, col)
+			|| (e1 && w->keys[r1 * w->cols + col]
+				!= w->keys[r2 * w->cols + col]))
+			return (0);
+		++col;
+	}
+	return (1);
+}
+
+/**
+ * @brief Tell whether a row can be placed at the given displacement.
+ *
+ * Since check holds the column, two rows never read each other entries as
+ * long as their displacements differ, so only the own slots must be free.
+ */
+static int	_comb_fits(
+				const t_lr_comb_work *w,
+				size_t row,
+				size_t base
+				)
+{
+	size_t	col;
+
+	if (w->taken[base])
+		return (0);
+	col = 0;
+	while (col < w->cols)
+	{
+		if (_comb_is_entry(w, row, col) && w->check[base + col] != -1)
+			return (0);
+		++col;
+	}
+	return (1);
+}
+
+/**
+ * @brief Place a row at the first displacement where it fits.
+ */
+static void	_comb_place(
+				t_lr_comb_work *w,
+				size_t row,
+				unsigned long *hashes
+				)
+{
+	size_t	k;
+	size_t	col;
+
+	k = 0;
+	while (k < row && !(hashes[k] == hashes[row] && _comb_same(w, k, row)))
+		++k;
+	if (k < row)
+	{
+		w->base[row] = w->base[k];
+		return ;
+	}
+	k = 0;
+	while (!_comb_fits(w, row, k))
+		++k;
+	w->base[row] = k;
+	w->taken[k] = 1;
+	col = 0;
+	while (col < w->cols)
+	{
+		if (_comb_is_entry(w, row, col))
+		{
+			w->check[k + col] = col;
+			w->next[k + col] = w->keys[row * w->cols + col];
+		}
+		++col;
+	}
+	if (k + w->cols > w->size)
+		w->size = k + w->cols;
+}
+
+/**
+ * @brief Pack every row of the key matrix.
+ *
+ * On success, base, check and next hold the comb and size its length.
+ *
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+static t_lr_error	_comb_pack(
+						t_lr_comb_work *w
+						)
+{
+	unsigned long	*hashes;
+	size_t			k;
+
+	w->cap = w->rows * w->cols + w->rows + w->cols;
+	w->size = w->cols;
+	w->base = malloc(w->rows * sizeof(*w->base));
+	w->check = malloc(w->cap * sizeof(*w->check));
+	w->next = malloc(w->cap * sizeof(*w->next));
+	w->taken = malloc(w->cap * sizeof(*w->taken));
+	hashes = malloc(w->rows * sizeof(*hashes));
+	if (w->base == NULL || w->check == NULL || w->next == NULL
+		|| w->taken == NULL || hashes == NULL)
+		return (free(hashes), LR_BAD_ALLOC);
+	k = 0;
+	while (k < w->cap)
+	{
+		w->check[k] = -1;
+		w->next[k] = w->skip;
+		w->taken[k++] = 0;
+	}
+	k = 0;
+	while (k < w->rows)
+	{
+		hashes[k] = _comb_hash(w, k);
+		_comb_place(w, k, hashes);
+		++k;
+	}
+	free(hashes);
+	return (LR_OK);
+}
+
+/**
+ * @brief Free the working buffers of the packer.
+ */
+static void	_comb_work_free(
+				t_lr_comb_work *w
+				)
+{
+	free(w->keys);
+	free(w->dflt);
+	free(w->base);
+	free(w->check);
+	free(w->next);
+	free(w->taken);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Action table.                                                          * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Encode an action as a packer key.
+ *
+ * The key has the layout of a packed action, without its width limit.
+ */
+static long	_comb_action_key(
+				t_lr_action action
+				)
+{
+	if (action.type == ACTION_SHIFT)
+		return (ACTION_SHIFT
+			| (long)action.data.shift_id << LR_ACTION_TYPE_BITS);
+	if (action.type == ACTION_REDUCE)
+		return (ACTION_REDUCE
+			| (long)action.data.reduce_id << LR_ACTION_TYPE_BITS);
+	return (action.type);
+}
+
+/**
+ * @brief Decode a packer key into an action.
+ */
+static t_lr_action	_comb_key_action(
+						long key
+						)
+{
+	return (LR_UNPACK_ACTION(key));
+}
+
+/**
+ * @brief Choose the default key of an action row.
+ *
+ * The default is the most frequent reduction of the row, or an error if
+ * the row never reduces.
+ */
+static long	_comb_action_default(
+				const t_lr_grammar *grammar,
+				const long *row,
+				size_t *counts
+				)
+{
+	size_t		k;
+	t_lr_action	action;
+	long		best;
+
+	k = 0;
+	while (k < grammar->prod_count)
+		counts[k++] = 0;
+	best = ACTION_ERROR;
+	k = 0;
+	while (k < lr_grammar_columns(grammar))
+	{
+		action = _comb_key_action(row[k++]);
+		if (action.type != ACTION_REDUCE
+			|| (size_t)action.data.reduce_id >= grammar->prod_count)
+			continue ;
+		++counts[action.data.reduce_id];
+		if (best == ACTION_ERROR || counts[action.data.reduce_id]
+			> counts[_comb_key_action(best).data.reduce_id])
+			best = _comb_action_key(action);
+	}
+	return (best);
+}
+
+/**
+ * @brief Copy the packed action comb into its final single block.
+ *
+ * The arrays are laid out by decreasing alignment, so that each one starts
+ * aligned whatever the number of slots and MP_ACTION_BITS.
+ */
+static t_lr_comb_action	*_comb_action_emit(
+							const t_lr_comb_work *w
+							)
+{
+	t_lr_comb_action	*comb;
+	size_t				k;
+
+	comb = malloc(sizeof(*comb) + w->rows * sizeof(*comb->base)
+			+ (w->size + w->rows) * sizeof(*comb->next)
+			+ w->size * sizeof(*comb->check));
+	if (comb == NULL)
+		return (NULL);
+	comb->size = w->size;
+	comb->base = (size_t *)(comb + 1);
+	comb->check = (t_lr_token_id *)(comb->base + w->rows);
+	comb->next = (t_lr_packed_action *)(comb->check + w->size);
+	comb->defaults = comb->next + w->size;
+	k = 0;
+	while (k < w->size)
+	{
+		((t_lr_packed_action *)comb->next)[k] = w->next[k];
+		((t_lr_token_id *)comb->check)[k] = w->check[k];
+		++k;
+	}
+	k = 0;
+	while (k < w->rows)
+	{
+		((size_t *)comb->base)[k] = w->base[k];
+		((t_lr_packed_action *)comb->defaults)[k] = w->dflt[k];
+		++k;
+	}
+	return (comb);
+}
+
+/**
+ * @brief Build the compressed action table of a context.
+ */
+static t_lr_error	_comb_build_action(
+						t_lr_grammar *grammar
+						)
+{
+	t_lr_comb_work	w;
+	size_t			*counts;
+	size_t			k;
+
+	w = (t_lr_comb_work){.rows = grammar->state_count,
+		.cols = lr_grammar_columns(grammar), .skip = ACTION_ERROR};
+	w.keys = malloc(w.rows * w.cols * sizeof(*w.keys));
+	w.dflt = malloc(w.rows * sizeof(*w.dflt));
+	counts = malloc((grammar->prod_count + 1) * sizeof(*counts));
+	if (w.keys == NULL || w.dflt == NULL || counts == NULL)
+		return (free(counts), _comb_work_free(&w), LR_BAD_ALLOC);
+	k = 0;
+	while (k < w.rows * w.cols)
+	{
+		w.keys[k] = _comb_action_key(grammar->action_table[k]);
+		if (w.keys[k] > (t_lr_packed_action)-1)
+			return (free(counts), _comb_work_free(&w), LR_INTERNAL_ERROR);
+		++k;
+	}
+	k = 0;
+	while (k < w.rows)
+	{
+		w.dflt[k] = _comb_action_default(grammar, w.keys + k * w.cols, counts);
+		++k;
+	}
+	free(counts);
+	if (_comb_pack(&w) == LR_OK)
+		grammar->action_comb = _comb_action_emit(&w);
+	_comb_work_free(&w);
+	if (grammar->action_comb == NULL)
+		return (LR_BAD_ALLOC);
+	return (LR_OK);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Goto table.                                                            * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Encode a goto as a packer key.
+ *
+ * No goto enters state 0, the initial state, so a goto to it, like
+ * LR_STATE_NONE, marks a cell the automaton never takes. Such cells are
+ * skipped and read as the default of their production.
+ */
+static long	_comb_goto_key(
+				t_lr_state_id state_id
+				)
+{
+	if (state_id == 0 || state_id == LR_STATE_NONE)
+		return (-1);
+	return (state_id);
+}
+
+/**
+ * @brief Choose the default goto of a production, its most frequent target.
+ *
+ * Only the gotos the automaton takes compete, state 0 is left for the
+ * productions that have none.
+ */
+static long	_comb_goto_default(
+				const t_lr_grammar *grammar,
+				const long *row,
+				size_t *counts
+				)
+{
+	size_t	k;
+	long	best;
+
+	k = 0;
+	while (k < grammar->state_count)
+		counts[k++] = 0;
+	best = -1;
+	k = 0;
+	while (k < grammar->state_count)
+	{
+		if (row[k] >= 0 && (size_t)row[k] < grammar->state_count)
+		{
+			++counts[row[k]];
+			if (best < 0 || counts[row[k]] > counts[best])
+				best = row[k];
+		}
+		++k;
+	}
+	if (best < 0)
+		return (0);
+	return (best);
+}
+
+/**
+ * @brief Copy the packed goto comb into its final single block.
+ */
+static t_lr_comb_goto	*_comb_goto_emit(
+							const t_lr_comb_work *w
+							)
+{
+	t_lr_comb_goto	*comb;
+	size_t			k;
+
+	comb = malloc(sizeof(*comb) + w->rows * sizeof(*comb->base)
+			+ (2 * w->size + w->rows) * sizeof(*comb->next));
+	if (comb == NULL)
+		return (NULL);
+	comb->size = w->size;
+	comb->base = (size_t *)(comb + 1);
+	comb->next = (t_lr_state_id *)(comb->base + w->rows);
+	comb->defaults = comb->next + w->size;
+	comb->check = comb->defaults + w->rows;
+	k = 0;
+	while (k < w->size)
+	{
+		((t_lr_state_id *)comb->next)[k] = w->next[k];
+		((t_lr_state_id *)comb->check)[k] = w->check[k];
+		++k;
+	}
+	k = 0;
+	while (k < w->rows)
+	{
+		((size_t *)comb->base)[k] = w->base[k];
+		((t_lr_state_id *)comb->defaults)[k] = w->dflt[k];
+		++k;
+	}
+	return (comb);
+}
+
+/**
+ * @brief Build the compressed goto table of a context.
+ *
+ * The goto table is transposed so that each production is a row, which
+ * lets most productions collapse into their default target.
+ */
+static t_lr_error	_comb_build_goto(
+						t_lr_grammar *grammar
+						)
+{
+	t_lr_comb_work	w;
+	size_t			*counts;
+	size_t			k;
+
+	w = (t_lr_comb_work){.rows = grammar->prod_count,
+		.cols = grammar->state_count, .skip = -1};
+	w.keys = malloc(w.rows * w.cols * sizeof(*w.keys));
+	w.dflt = malloc(w.rows * sizeof(*w.dflt));
+	counts = malloc((grammar->state_count + 1) * sizeof(*counts));
+	if (w.keys == NULL || w.dflt == NULL || counts == NULL)
+		return (free(counts), _comb_work_free(&w), LR_BAD_ALLOC);
+	k = 0;
+	while (k < w.rows * w.cols)
+	{
+		w.keys[k] = _comb_goto_key(grammar->goto_table[(k % w.cols) * w.rows
+				+ k / w.cols]);
+		++k;
+	}
+	k = 0;
+	while (k < w.rows)
+	{
+		w.dflt[k] = _comb_goto_default(grammar, w.keys + k * w.cols, counts);
+		++k;
+	}
+	free(counts);
+	if (_comb_pack(&w) == LR_OK)
+		grammar->goto_comb = _comb_goto_emit(&w);
+	_comb_work_free(&w);
+	if (grammar->goto_comb == NULL)
+		return (LR_BAD_ALLOC);
+	return (LR_OK);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Build the compressed tables from the dense tables.
+ *
+ * @param grammar Grammar holding the dense tables.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_INTERNAL_ERROR if an ID does not fit in a packed action.
+ */
+t_lr_error	lr_comb_build(
+				t_lr_grammar *grammar
+				)
+{
+	t_lr_error	err;
+
+	grammar->action_comb = NULL;
+	grammar->goto_comb = NULL;
+	err = _comb_build_action(grammar);
+	if (err == LR_OK)
+		err = _comb_build_goto(grammar);
+	if (err != LR_OK)
+		lr_comb_destroy(grammar);
+	return (err);
+}
+
+/**
+ * @brief Free the compressed tables.
+ *
+ * @param grammar Grammar.
+ */
+void	lr_comb_destroy(
+			t_lr_grammar *grammar
+			)
+{
+	free((void *)grammar->action_comb);
+	free((void *)grammar->goto_comb);
+	grammar->action_comb = NULL;
+	grammar->goto_comb = NULL;
+}
@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   defaults.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:12:54 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 23:12:54 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file defaults.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Default reductions of the consistent states.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdlib.h>
+
+#include "lr_grammar.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Find the only production a state reduces by.
+ *
+ * @return The production, or LR_PROD_NONE if the state shifts, accepts,
+ *         never reduces or reduces by several productions.
+ */
+static t_lr_prod_id	_lr_state_default(
+						const t_lr_grammar *grammar,
+						t_lr_state_id state_id
+						)
+{
+	t_lr_prod_id	prod_id;
+	t_lr_action		action;
+	size_t			k;
+
+	prod_id = LR_PROD_NONE;
+	k = 0;
+	while (k < grammar->token_count)
+	{
+		action = lr_grammar_action(grammar, state_id, k++);
+		if (action.type == ACTION_SHIFT || action.type == ACTION_ACCEPT
+			|| (action.type == ACTION_REDUCE && prod_id != LR_PROD_NONE
+				&& action.data.reduce_id != prod_id))
+			return (LR_PROD_NONE);
+		if (action.type == ACTION_REDUCE)
+			prod_id = action.data.reduce_id;
+	}
+	return (prod_id);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Build the default reductions of the consistent states.
+ *
+ * The action table is read through lr_grammar_action, so any of its forms
+ * may be used.
+ *
+ * @param grammar Grammar holding an action table.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error	lr_defaults_build(
+				t_lr_grammar *grammar
+				)
+{
+	t_lr_prod_id	*defaults;
+	size_t			k;
+
+	grammar->default_reduce = NULL;
+	defaults = malloc(grammar->state_count * sizeof(*defaults) + 1);
+	if (defaults == NULL)
+		return (LR_BAD_ALLOC);
+	k = 0;
+	while (k < grammar->state_count)
+	{
+		defaults[k] = _lr_state_default(grammar, k);
+		++k;
+	}
+	grammar->default_reduce = defaults;
+	return (LR_OK);
+}
+
+/**
+ * @brief Free the default reductions.
+ *
+ * @param grammar Grammar.
+ */
+void	lr_defaults_destroy(
+			t_lr_grammar *grammar
+			)
+{
+	free((void *)grammar->default_reduce);
+	grammar->default_reduce = NULL;
+}
@@ -0,0 +1,307 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   grammar_load.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 21:52:41 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 21:52:41 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file grammar_load.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Grammar file loader.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <limits.h>
+#include <stdlib.h>
+
+#include "lr_grammar.h"
+
+#include "lr_io.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Grammar file reader state.
+ */
+typedef struct s_lr_reader
+{
+	const char	*data;		/**< File mapping. */
+	size_t		size;		/**< Size of the mapping. */
+	size_t		offset;		/**< Offset of the next section. */
+}	t_lr_reader;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Take the next 8 byte aligned section of a grammar file.
+ *
+ * @param r Reader.
+ * @param count Number of elements.
+ * @param elem Size of an element.
+ * @return The section, or NULL if the file is too short.
+ */
+static const void	*_lr_take(
+						t_lr_reader *r,
+						uint64_t count,
+						size_t elem
+						)
+{
+	const void	*section;
+	size_t		size;
+
+	if (r->offset > r->size || count > (r->size - r->offset) / elem)
+		return (NULL);
+	size = count * elem;
+	section = r->data + r->offset;
+	r->offset += size + (-size & 7);
+	return (section);
+}
+
+/**
+ * @brief Check the header of a grammar file against this build.
+ *
+ * Also bounds the counts so that every ID fits its type and table sizes
+ * do not overflow.
+ */
+static int	_lr_header_ok(
+				const t_lr_grammar_header *h
+				)
+{
+	if (h->magic != LR_GRAMMAR_MAGIC || h->version != LR_GRAMMAR_VERSION
+		|| (h->flags & ~(LR_GRAMMAR_ACTION_COMB | LR_GRAMMAR_GOTO_COMB
+				| LR_GRAMMAR_DEFAULTS | LR_GRAMMAR_TOKEN_MAP))
+		|| h->id_size != sizeof(t_lr_state_id)
+		|| h->token_id_size != sizeof(t_lr_token_id)
+		|| h->action_size != sizeof(t_lr_packed_action)
+		|| h->word_size != sizeof(size_t) || h->reserved != 0)
+		return (0);
+	if (h->state_count == 0 || h->state_count - 1 > LR_PACKED_ID_MAX
+		|| h->state_count > LR_STATE_NONE
+		|| h->prod_count > (uint64_t)LR_PACKED_ID_MAX + 1
+		|| h->prod_count > (uint64_t)(t_lr_prod_id)-1 + 1
+		|| h->token_count > (uint64_t)INT_MAX + 1
+		|| h->column_count > h->token_count
+		|| (!(h->flags & LR_GRAMMAR_TOKEN_MAP)
+			&& h->column_count != h->token_count))
+		return (0);
+	if ((h->token_count != 0 && h->state_count > SIZE_MAX / h->token_count)
+		|| (h->prod_count != 0 && h->state_count > SIZE_MAX / h->prod_count))
+		return (0);
+	return (!(h->flags & LR_GRAMMAR_ACTION_COMB) == !h->action_slots
+		&& !(h->flags & LR_GRAMMAR_GOTO_COMB) == !h->goto_slots);
+}
+
+/**
+ * @brief Take the action table sections.
+ *
+ * @return 1 on success, 0 if the file is too short.
+ */
+static int	_lr_load_actions(
+				t_lr_grammar_map *map,
+				t_lr_reader *r,
+				const t_lr_grammar_header *h
+				)
+{
+	t_lr_grammar		*grammar = &map->grammar;
+	t_lr_comb_action	*comb = &map->action_comb;
+
+	if (!(h->flags & LR_GRAMMAR_ACTION_COMB))
+	{
+		grammar->packed_table = _lr_take(r, grammar->state_count
+				* h->column_count, sizeof(t_lr_packed_action));
+		return (grammar->packed_table != NULL);
+	}
+	comb->base = _lr_take(r, grammar->state_count, sizeof(*comb->base));
+	comb->next = _lr_take(r, h->action_slots, sizeof(*comb->next));
+	comb->defaults = _lr_take(r, grammar->state_count,
+			sizeof(*comb->defaults));
+	comb->check = _lr_take(r, h->action_slots, sizeof(*comb->check));
+	comb->size = h->action_slots;
+	grammar->action_comb = comb;
+	return (comb->base != NULL && comb->next != NULL
+		&& comb->defaults != NULL && comb->check != NULL);
+}
+
+/**
+ * @brief Take the goto table sections.
+ *
+ * @return 1 on success, 0 if the file is too short.
+ */
+static int	_lr_load_gotos(
+				t_lr_grammar_map *map,
+				t_lr_reader *r,
+				const t_lr_grammar_header *h
+				)
+{
+	t_lr_grammar	*grammar = &map->grammar;
+	t_lr_comb_goto	*comb = &map->goto_comb;
+
+	if (!(h->flags & LR_GRAMMAR_GOTO_COMB))
+	{
+		grammar->goto_table = _lr_take(r, grammar->state_count
+				* grammar->prod_count, sizeof(t_lr_state_id));
+		return (grammar->goto_table != NULL);
+	}
+	comb->base = _lr_take(r, grammar->prod_count, sizeof(*comb->base));
+	comb->next = _lr_take(r, h->goto_slots, sizeof(*comb->next));
+	comb->defaults = _lr_take(r, grammar->prod_count, sizeof(*comb->defaults));
+	comb->check = _lr_take(r, h->goto_slots, sizeof(*comb->check));
+	comb->size = h->goto_slots;
+	grammar->goto_comb = comb;
+	return (comb->base != NULL && comb->next != NULL
+		&& comb->defaults != NULL && comb->check != NULL);
+}
+
+/**
+ * @brief Set the production callbacks of a mapped grammar.
+ *
+ * @return LR_OK on success, LR_BAD_FORMAT if prod_cb does not match the
+ *         sizes, LR_BAD_ALLOC on allocation failure.
+ */
+static t_lr_error	_lr_load_prods(
+						t_lr_grammar_map *map,
+						const uint32_t *sizes,
+						const t_lr_prod_cb *prod_cb
+						)
+{
+	const size_t	count = map->grammar.prod_count;
+	size_t			k;
+
+	k = 0;
+	if (prod_cb != NULL)
+	{
+		while (k < count && prod_cb[k].size == sizes[k])
+			++k;
+		if (k != count)
+			return (LR_BAD_FORMAT);
+		map->grammar.prod_cb = prod_cb;
+		return (LR_OK);
+	}
+	map->prod_cb = malloc(count * sizeof(*map->prod_cb));
+	if (map->prod_cb == NULL && count != 0)
+		return (LR_BAD_ALLOC);
+	while (k < count)
+	{
+		map->prod_cb[k] = (t_lr_prod_cb){.size = sizes[k]};
+		++k;
+	}
+	map->grammar.prod_cb = map->prod_cb;
+	return (LR_OK);
+}
+
+/**
+ * @brief Load every section of a mapped grammar file, then verify it.
+ */
+static t_lr_error	_lr_load(
+						t_lr_grammar_map *map,
+						t_lr_reader *r,
+						const t_lr_prod_cb *prod_cb
+						)
+{
+	const t_lr_grammar_header	*h;
+	const uint32_t				*sizes;
+	t_lr_error					err;
+
+	h = _lr_take(r, 1, sizeof(*h));
+	if (h == NULL || !_lr_header_ok(h))
+		return (LR_BAD_FORMAT);
+	map->grammar.state_count = h->state_count;
+	map->grammar.token_count = h->token_count;
+	map->grammar.column_count = h->column_count;
+	map->grammar.prod_count = h->prod_count;
+	sizes = _lr_take(r, h->prod_count, sizeof(*sizes));
+	if (sizes == NULL || !_lr_load_actions(map, r, h)
+		|| !_lr_load_gotos(map, r, h))
+		return (LR_BAD_FORMAT);
+	if (h->flags & LR_GRAMMAR_DEFAULTS)
+		map->grammar.default_reduce = _lr_take(r, h->state_count,
+				sizeof(t_lr_prod_id));
+	if (h->flags & LR_GRAMMAR_TOKEN_MAP)
+		map->grammar.token_map = _lr_take(r, h->token_count,
+				sizeof(t_lr_token_id));
+	if (((h->flags & LR_GRAMMAR_DEFAULTS)
+			&& map->grammar.default_reduce == NULL)
+		|| ((h->flags & LR_GRAMMAR_TOKEN_MAP)
+			&& map->grammar.token_map == NULL) || r->offset != r->size)
+		return (LR_BAD_FORMAT);
+	err = _lr_load_prods(map, sizes, prod_cb);
+	if (err == LR_OK)
+		err = lr_grammar_verify(&map->grammar);
+	if (err == LR_INTERNAL_ERROR)
+		return (LR_BAD_FORMAT);
+	return (err);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Map a grammar file read-only.
+ *
+ * Every check happens here, once: the mapped grammar is verified, so it
+ * is parsed without any runtime check.
+ *
+ * @param map Output mapped grammar.
+ * @param path Path of the grammar file.
+ * @param prod_cb Production callbacks indexed by production, or NULL.
+ * @return LR_OK on success, LR_IO_ERROR if the file cannot be mapped,
+ *         LR_BAD_FORMAT if it is not a valid grammar file for this build,
+ *         LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error	lr_grammar_load_mmap(
+				t_lr_grammar_map *map,
+				const char *path,
+				const t_lr_prod_cb *prod_cb
+				)
+{
+	t_lr_reader	r;
+	t_lr_error	err;
+
+	*map = (t_lr_grammar_map){0};
+	map->data = lr_io_map(path, &map->size);
+	if (map->data == NULL)
+		return (LR_IO_ERROR);
+	r = (t_lr_reader){.data = map->data, .size = map->size};
+	err = _lr_load(map, &r, prod_cb);
+	if (err != LR_OK)
+		lr_grammar_unmap(map);
+	return (err);
+}
+
+/**
+ * @brief Unmap a grammar mapped by lr_grammar_load_mmap.
+ *
+ * @param map Mapped grammar.
+ */
+void	lr_grammar_unmap(
+			t_lr_grammar_map *map
+			)
+{
+	free(map->prod_cb);
+	lr_io_unmap(map->data, map->size);
+	*map = (t_lr_grammar_map){0};
+}
@@ -0,0 +1,247 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   grammar_save.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 21:38:10 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 21:38:10 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file grammar_save.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Grammar file writer.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "lr_grammar.h"
+
+#include "lr_io.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Grammar file writer state.
+ */
+typedef struct s_lr_writer
+{
+	int		fd;		/**< Output file. */
+	size_t	offset;	/**< Bytes written so far. */
+	int		err;	/**< Non zero once a write failed. */
+}	t_lr_writer;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Write a buffer, unless a previous write failed.
+ */
+static void	_lr_write(
+				t_lr_writer *w,
+				const void *buf,
+				size_t size
+				)
+{
+	if (w->err == 0)
+		w->err = lr_io_write(w->fd, buf, size);
+	w->offset += size;
+}
+
+/**
+ * @brief Write an array, then pad it to 8 bytes.
+ */
+static void	_lr_put(
+				t_lr_writer *w,
+				const void *buf,
+				size_t size
+				)
+{
+	_lr_write(w, buf, size);
+	if (w->err == 0)
+		w->err = lr_io_pad(w->fd, &w->offset);
+}
+
+/**
+ * @brief Write the production sizes, a chunk at a time.
+ */
+static void	_lr_put_sizes(
+				t_lr_writer *w,
+				const t_lr_grammar *grammar
+				)
+{
+	uint32_t	buf[64];
+	size_t		n;
+	size_t		k;
+
+	k = 0;
+	while (k < grammar->prod_count)
+	{
+		n = 0;
+		while (n < sizeof(buf) / sizeof(*buf) && k < grammar->prod_count)
+			buf[n++] = grammar->prod_cb[k++].size;
+		_lr_write(w, buf, n * sizeof(*buf));
+	}
+	_lr_put(w, NULL, 0);
+}
+
+/**
+ * @brief Write the action table, packing a dense one if needed.
+ *
+ * @return LR_OK, or LR_BAD_ALLOC or LR_INTERNAL_ERROR from lr_pack_build.
+ */
+static t_lr_error	_lr_put_actions(
+						t_lr_writer *w,
+						const t_lr_grammar *grammar
+						)
+{
+	const t_lr_comb_action	*comb = grammar->action_comb;
+	t_lr_grammar			packed;
+	t_lr_error				err;
+
+	if (comb != NULL)
+	{
+		_lr_put(w, comb->base, grammar->state_count * sizeof(*comb->base));
+		_lr_put(w, comb->next, comb->size * sizeof(*comb->next));
+		_lr_put(w, comb->defaults,
+			grammar->state_count * sizeof(*comb->defaults));
+		_lr_put(w, comb->check, comb->size * sizeof(*comb->check));
+		return (LR_OK);
+	}
+	packed = *grammar;
+	if (grammar->packed_table == NULL)
+	{
+		err = lr_pack_build(&packed);
+		if (err != LR_OK)
+			return (err);
+	}
+	_lr_put(w, packed.packed_table, grammar->state_count
+		* lr_grammar_columns(grammar) * sizeof(*packed.packed_table));
+	if (grammar->packed_table == NULL)
+		lr_pack_destroy(&packed);
+	return (LR_OK);
+}
+
+/**
+ * @brief Write the goto table.
+ */
+static void	_lr_put_gotos(
+				t_lr_writer *w,
+				const t_lr_grammar *grammar
+				)
+{
+	const t_lr_comb_goto	*comb = grammar->goto_comb;
+
+	if (comb == NULL)
+	{
+		_lr_put(w, grammar->goto_table, grammar->state_count
+			* grammar->prod_count * sizeof(*grammar->goto_table));
+		return ;
+	}
+	_lr_put(w, comb->base, grammar->prod_count * sizeof(*comb->base));
+	_lr_put(w, comb->next, comb->size * sizeof(*comb->next));
+	_lr_put(w, comb->defaults, grammar->prod_count * sizeof(*comb->defaults));
+	_lr_put(w, comb->check, comb->size * sizeof(*comb->check));
+}
+
+/**
+ * @brief Fill the header of a grammar file.
+ */
+static void	_lr_grammar_header(
+				const t_lr_grammar *grammar,
+				t_lr_grammar_header *header
+				)
+{
+	*header = (t_lr_grammar_header){.magic = LR_GRAMMAR_MAGIC,
+		.version = LR_GRAMMAR_VERSION, .id_size = sizeof(t_lr_state_id),
+		.token_id_size = sizeof(t_lr_token_id),
+		.action_size = sizeof(t_lr_packed_action),
+		.word_size = sizeof(size_t), .state_count = grammar->state_count,
+		.token_count = grammar->token_count,
+		.column_count = lr_grammar_columns(grammar),
+		.prod_count = grammar->prod_count};
+	if (grammar->action_comb != NULL)
+	{
+		header->flags |= LR_GRAMMAR_ACTION_COMB;
+		header->action_slots = grammar->action_comb->size;
+	}
+	if (grammar->goto_comb != NULL)
+	{
+		header->flags |= LR_GRAMMAR_GOTO_COMB;
+		header->goto_slots = grammar->goto_comb->size;
+	}
+	if (grammar->default_reduce != NULL)
+		header->flags |= LR_GRAMMAR_DEFAULTS;
+	if (grammar->token_map != NULL)
+		header->flags |= LR_GRAMMAR_TOKEN_MAP;
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Save the tables of a grammar to a grammar file.
+ *
+ * @param grammar Grammar with prod_cb, an action and a goto table.
+ * @param path Path of the file, created or truncated.
+ * @return LR_OK on success, LR_IO_ERROR on failure, LR_INTERNAL_ERROR if
+ *         the grammar misses a table or an action does not fit in a
+ *         packed action.
+ */
+t_lr_error	lr_grammar_save(
+				const t_lr_grammar *grammar,
+				const char *path
+				)
+{
+	t_lr_grammar_header	header;
+	t_lr_writer			w;
+	t_lr_error			err;
+
+	if (grammar->prod_cb == NULL || (grammar->action_comb == NULL
+			&& grammar->packed_table == NULL && grammar->action_table == NULL)
+		|| (grammar->goto_comb == NULL && grammar->goto_table == NULL))
+		return (LR_INTERNAL_ERROR);
+	w = (t_lr_writer){.fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+	if (w.fd < 0)
+		return (LR_IO_ERROR);
+	_lr_grammar_header(grammar, &header);
+	_lr_put(&w, &header, sizeof(header));
+	_lr_put_sizes(&w, grammar);
+	err = _lr_put_actions(&w, grammar);
+	_lr_put_gotos(&w, grammar);
+	if (grammar->default_reduce != NULL)
+		_lr_put(&w, grammar->default_reduce,
+			grammar->state_count * sizeof(*grammar->default_reduce));
+	if (grammar->token_map != NULL)
+		_lr_put(&w, grammar->token_map,
+			grammar->token_count * sizeof(*grammar->token_map));
+	if (close(w.fd) < 0 || w.err != 0)
+		w.err = -1;
+	if (err != LR_OK)
+		return (err);
+	if (w.err != 0)
+		return (LR_IO_ERROR);
+	return (LR_OK);
+}
@@ -0,0 +1,130 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lookup.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 19:41:27 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 19:41:27 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file lookup.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Action and goto lookups in the grammar tables.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include "lr_grammar.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Look up the action in the action table.
+ *
+ * A state with a default reduction reduces without reading the token.
+ * Otherwise, maps the token to its column when the grammar holds a token
+ * map, then looks up the action for the state and column in the action
+ * table, or in the compressed or packed action table when the grammar holds
+ * one.
+ *
+ * @param grammar Grammar.
+ * @param state_id Current state ID.
+ * @param token_id Current token ID.
+ * @return The action to perform.
+ */
+t_lr_action	lr_grammar_action(
+				const t_lr_grammar *grammar,
+				t_lr_state_id state_id,
+				t_lr_token_id token_id
+				)
+{
+	const t_lr_comb_action	*comb = grammar->action_comb;
+	size_t					width;
+	size_t					slot;
+
+	if (grammar->default_reduce != NULL
+		&& grammar->default_reduce[state_id] != LR_PROD_NONE)
+		return ((t_lr_action){.type = ACTION_REDUCE,
+			.data.reduce_id = grammar->default_reduce[state_id]});
+	width = grammar->token_count;
+	if (grammar->token_map != NULL)
+	{
+		token_id = grammar->token_map[token_id];
+		width = grammar->column_count;
+	}
+	if (comb != NULL)
+	{
+		slot = comb->base[state_id] + token_id;
+		if (comb->check[slot] == token_id)
+			return (LR_UNPACK_ACTION(comb->next[slot]));
+		return (LR_UNPACK_ACTION(comb->defaults[state_id]));
+	}
+	slot = width * state_id + token_id;
+	if (grammar->packed_table != NULL)
+		return (LR_UNPACK_ACTION(grammar->packed_table[slot]));
+	return (grammar->action_table[slot]);
+}
+
+/**
+ * @brief Look up the goto state in the goto table.
+ *
+ * Calculates the index into the goto table based on the state and
+ * production ID, then returns the target state. When the grammar holds
+ * a compressed goto table, the comb is probed instead and falls back to the
+ * production default.
+ *
+ * @param grammar Grammar.
+ * @param state_id State ID under the reduced items.
+ * @param prod_id Production ID.
+ * @return Target state ID from the goto table.
+ */
+t_lr_state_id	lr_grammar_goto(
+					const t_lr_grammar *grammar,
+					t_lr_state_id state_id,
+					t_lr_prod_id prod_id
+					)
+{
+	const t_lr_comb_goto	*comb = grammar->goto_comb;
+	size_t					slot;
+
+	if (comb != NULL)
+	{
+		slot = comb->base[prod_id] + state_id;
+		if (comb->check[slot] == state_id)
+			return (comb->next[slot]);
+		return (comb->defaults[prod_id]);
+	}
+	return (grammar->goto_table[grammar->prod_count * state_id + prod_id]);
+}
+
+/**
+ * @brief Get the number of columns of the action tables.
+ *
+ * Tokens of the same class share a column, so a token map may leave
+ * fewer columns than tokens.
+ *
+ * @param grammar Grammar.
+ * @return column_count with a token map, token_count otherwise.
+ */
+size_t	lr_grammar_columns(
+			const t_lr_grammar *grammar
+			)
+{
+	if (grammar->token_map != NULL)
+		return (grammar->column_count);
+	return (grammar->token_count);
+}
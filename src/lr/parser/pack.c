@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pack.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 11:31:05 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 11:31:05 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file pack.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Packed action table conversion.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdlib.h>
+
+#include "lr_grammar.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Build the packed action table from the dense action table.
+ *
+ * Shift and reduce cells keep their ID as payload, error and accept cells
+ * carry a zero payload.
+ *
+ * @param grammar Grammar holding the dense tables.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_INTERNAL_ERROR if an ID does not fit in a packed action.
+ */
+t_lr_error	lr_pack_build(
+				t_lr_grammar *grammar
+				)
+{
+	const size_t		count = grammar->state_count
+		* lr_grammar_columns(grammar);
+	t_lr_packed_action	*packed;
+	t_lr_action			action;
+	size_t				k;
+
+	packed = malloc(count * sizeof(*packed));
+	if (packed == NULL)
+		return (LR_BAD_ALLOC);
+	k = 0;
+	while (k < count)
+	{
+		action = grammar->action_table[k];
+		if (action.type != ACTION_SHIFT && action.type != ACTION_REDUCE)
+			action.data.shift_id = 0;
+		packed[k] = LR_PACK_ACTION(action.type, action.data.shift_id);
+		if (LR_PACKED_ID(packed[k++]) != action.data.shift_id)
+			return (free(packed), LR_INTERNAL_ERROR);
+	}
+	grammar->packed_table = packed;
+	return (LR_OK);
+}
+
+/**
+ * @brief Free the packed action table.
+ *
+ * @param grammar Grammar.
+ */
+void	lr_pack_destroy(
+			t_lr_grammar *grammar
+			)
+{
+	free((void *)grammar->packed_table);
+	grammar->packed_table = NULL;
+}
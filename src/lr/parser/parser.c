@@ -35,41 +35,402 @@
 /**
  * @brief Initialize the LR parser context.
  *
- * Creates the parser stack with initial axiom state and sets up
- * all necessary callbacks and user pointer.
+ * Same as lr_parser_init_capacity with a capacity of 1 item.
  *
  * @param ctx Parser context to initialize.
+ * @param grammar Grammar to parse with.
  * @param usrptr User pointer to be passed to all callbacks.
  * @return LR_OK on success, error code on failure.
  */
 int	lr_parser_init(
 		t_lr_parser_ctx *ctx,
+		const t_lr_grammar *grammar,
 		void *usrptr
 		)
 {
-	t_lr_stack_item	axiom;
-	t_lr_error		err;
+	return (lr_parser_init_capacity(ctx, grammar, usrptr, 1));
+}
+
+/**
+ * @brief Initialize the LR parser context with a stack capacity hint.
+ *
+ * Same as lr_parser_init_allocator with the default allocator.
+ *
+ * @param ctx Parser context to initialize.
+ * @param grammar Grammar to parse with.
+ * @param usrptr User pointer to be passed to all callbacks.
+ * @param capacity Initial stack capacity in items.
+ * @return LR_OK on success, error code on failure.
+ */
+int	lr_parser_init_capacity(
+		t_lr_parser_ctx *ctx,
+		const t_lr_grammar *grammar,
+		void *usrptr,
+		size_t capacity
+		)
+{
+	return (lr_parser_init_allocator(ctx, grammar, usrptr, NULL, capacity));
+}
+
+/**
+ * @brief Initialize the LR parser context with an allocator.
+ *
+ * Creates the parser stack with room for capacity items, allocated with
+ * allocator, and the initial axiom state, and sets up the grammar and user
+ * pointer.
+ *
+ * @param ctx Parser context to initialize.
+ * @param grammar Grammar to parse with.
+ * @param usrptr User pointer to be passed to all callbacks.
+ * @param allocator Allocator of the context, NULL for the default one.
+ * @param capacity Initial stack capacity in items.
+ * @return LR_OK on success, error code on failure.
+ */
+int	lr_parser_init_allocator(
+		t_lr_parser_ctx *ctx,
+		const t_lr_grammar *grammar,
+		void *usrptr,
+		const t_lr_allocator *allocator,
+		size_t capacity
+		)
+{
+	t_lr_error	err;
 
-	err = lr_stack_init(&ctx->stack, ctx->token_free_cbs, usrptr);
+	ctx->grammar = grammar;
+	lr_arena_init(&ctx->arena, allocator, 0);
+	lr_tree_init(&ctx->tree, allocator);
+	err = lr_stack_init_capacity(&ctx->stack, grammar->token_free_cbs, ctx,
+			allocator, capacity);
 	if (err != LR_OK)
 		return (err);
-	axiom = (t_lr_stack_item){.type = ITEM_AXIOM, .data = {}, .state_id = 0};
-	err = lr_stack_push(&ctx->stack, &axiom);
+#ifdef MP_STATS
+	err = lr_stats_init(&ctx->stats, grammar->state_count,
+			grammar->prod_count, allocator);
 	if (err != LR_OK)
-	{
-		lr_stack_destroy(&ctx->stack);
-		return (err);
-	}
+		return (lr_stack_destroy(&ctx->stack), err);
+#endif
+#ifdef MP_TRACE
+	ctx->trace = NULL;
+#endif
+#ifdef MP_TOKEN_REF
+	ctx->tokens = NULL;
+	ctx->token_count = 0;
+#endif
 	ctx->usrptr = usrptr;
-	return (LR_OK);
+	err = lr_parser_reset(ctx);
+	if (err != LR_OK)
+		lr_parser_destroy(ctx);
+	return (err);
+}
+
+/**
+ * @brief Initialize the LR parser context on a caller stack buffer.
+ *
+ * Same as lr_parser_init_capacity, the stack items are stored in buf and
+ * nothing is allocated until it is full. With MP_STATS the counters are
+ * still allocated on the heap.
+ *
+ * @param ctx Parser context to initialize.
+ * @param grammar Grammar to parse with.
+ * @param usrptr User pointer to be passed to all callbacks.
+ * @param buf Caller stack buffer, which must outlive the context.
+ * @param size Size of buf in bytes.
+ * @param flags 0 to spill to the heap when buf is full, LR_STACK_NO_SPILL
+ *              to fail with LR_STACK_OVERFLOW instead.
+ * @return LR_OK on success, error code on failure.
+ */
+int	lr_parser_init_buffer(
+		t_lr_parser_ctx *ctx,
+		const t_lr_grammar *grammar,
+		void *usrptr,
+		void *buf,
+		size_t size,
+		int flags
+		)
+{
+	t_lr_error	err;
+
+	ctx->grammar = grammar;
+	lr_arena_init(&ctx->arena, NULL, 0);
+	lr_tree_init(&ctx->tree, NULL);
+	lr_stack_init_buffer(&ctx->stack, grammar->token_free_cbs, ctx, buf, size,
+		flags);
+#ifdef MP_STATS
+	err = lr_stats_init(&ctx->stats, grammar->state_count,
+			grammar->prod_count, NULL);
+	if (err != LR_OK)
+		return (lr_stack_destroy(&ctx->stack), err);
+#endif
+#ifdef MP_TRACE
+	ctx->trace = NULL;
+#endif
+#ifdef MP_TOKEN_REF
+	ctx->tokens = NULL;
+	ctx->token_count = 0;
+#endif
+	ctx->usrptr = usrptr;
+	err = lr_parser_reset(ctx);
+	if (err != LR_OK)
+		lr_parser_destroy(ctx);
+	return (err);
+}
+
+/**
+ * @brief Change the allocator of the LR parser context.
+ *
+ * The stack moves its heap buffer, if any, to the new allocator. The arena
+ * and the tree switch too while they own no memory.
+ *
+ * @param ctx Parser context.
+ * @param allocator New allocator, NULL for the default one.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error	lr_parser_set_allocator(
+				t_lr_parser_ctx *ctx,
+				const t_lr_allocator *allocator
+				)
+{
+	t_lr_error	err;
+
+	err = lr_stack_set_allocator(&ctx->stack, allocator);
+	if (err == LR_OK && ctx->arena.head == NULL)
+		ctx->arena.allocator = allocator;
+	if (err == LR_OK && ctx->tree.nodes == NULL)
+		ctx->tree.allocator = allocator;
+	return (err);
+}
+
+/**
+ * @brief Get the allocator of the LR parser context.
+ *
+ * @param ctx Parser context.
+ * @return The allocator, never NULL.
+ */
+const t_lr_allocator	*lr_parser_allocator(
+							const t_lr_parser_ctx *ctx
+							)
+{
+	return (ctx->stack.allocator);
+}
+
+/**
+ * @brief Switch the LR parser context to arena mode.
+ *
+ * Marks the stack so its derived values are never freed one by one and
+ * sizes the arena chunks, which are allocated on demand.
+ *
+ * @param ctx Parser context.
+ * @param chunk_size Minimum size in bytes of the arena chunks.
+ */
+void	lr_parser_use_arena(
+			t_lr_parser_ctx *ctx,
+			size_t chunk_size
+			)
+{
+	lr_arena_destroy(&ctx->arena);
+	lr_arena_init(&ctx->arena, ctx->stack.allocator, chunk_size);
+	ctx->stack.flags |= LR_STACK_ARENA;
+}
+
+/**
+ * @brief Allocate a semantic value in the arena of the LR parser context.
+ *
+ * @param ctx Parser context.
+ * @param size Size in bytes.
+ * @return Pointer to size bytes, or NULL on allocation failure.
+ */
+void	*lr_parser_arena_alloc(
+			t_lr_parser_ctx *ctx,
+			size_t size
+			)
+{
+	return (lr_arena_alloc(&ctx->arena, size));
+}
+
+/**
+ * @brief Switch the LR parser context to tree mode.
+ *
+ * Marks the stack so shifts and reductions build the tree of the context,
+ * which then comes from the allocator of the context.
+ *
+ * @param ctx Parser context.
+ */
+void	lr_parser_use_tree(
+			t_lr_parser_ctx *ctx
+			)
+{
+	lr_tree_destroy(&ctx->tree);
+	lr_tree_init(&ctx->tree, ctx->stack.allocator);
+	ctx->stack.flags |= LR_STACK_TREE;
+}
+
+/**
+ * @brief Take the parse tree out of the LR parser context.
+ *
+ * @param ctx Parser context.
+ * @param tree Output tree, owned by the caller.
+ */
+void	lr_parser_take_tree(
+			t_lr_parser_ctx *ctx,
+			t_lr_tree *tree
+			)
+{
+	*tree = ctx->tree;
+	lr_tree_init(&ctx->tree, tree->allocator);
+}
+
+/**
+ * @brief Take a snapshot of the hot path counters (MP_STATS).
+ *
+ * The stack reallocations are counted by the stack itself.
+ *
+ * @param ctx Parser context.
+ * @param snapshot Output counters, sized for the grammar.
+ * @return LR_OK on success, LR_INTERNAL_ERROR if snapshot is not sized for
+ *         the grammar or the library is built without MP_STATS.
+ */
+t_lr_error	lr_parser_stats(
+				const t_lr_parser_ctx *ctx,
+				t_lr_stats *snapshot
+				)
+{
+#ifdef MP_STATS
+	t_lr_error	err;
+
+	err = lr_stats_copy(snapshot, &ctx->stats);
+	if (err == LR_OK)
+		snapshot->grows = ctx->stack.grows;
+	return (err);
+#else
+	(void)ctx;
+	lr_stats_clear(snapshot);
+	return (LR_INTERNAL_ERROR);
+#endif
+}
+
+/**
+ * @brief Zero the hot path counters of the context (MP_STATS).
+ *
+ * @param ctx Parser context.
+ */
+void	lr_parser_stats_reset(
+			t_lr_parser_ctx *ctx
+			)
+{
+#ifdef MP_STATS
+	lr_stats_clear(&ctx->stats);
+	ctx->stack.grows = 0;
+#else
+	(void)ctx;
+#endif
+}
+
+/**
+ * @brief Record the actions of the context in a trace (MP_TRACE).
+ *
+ * @param ctx Parser context.
+ * @param trace Trace to append to, NULL to stop tracing.
+ */
+void	lr_parser_set_trace(
+			t_lr_parser_ctx *ctx,
+			t_lr_trace *trace
+			)
+{
+#ifdef MP_TRACE
+	ctx->trace = trace;
+#else
+	(void)ctx;
+	(void)trace;
+#endif
+}
+
+/**
+ * @brief Set the token buffer of the parse (MP_TOKEN_REF).
+ *
+ * @param ctx Parser context.
+ * @param tokens Token buffer.
+ * @param count Number of tokens in the buffer.
+ */
+void	lr_parser_set_tokens(
+			t_lr_parser_ctx *ctx,
+			const t_lr_token *tokens,
+			size_t count
+			)
+{
+#ifdef MP_TOKEN_REF
+	ctx->tokens = tokens;
+	ctx->token_count = count;
+	if (count > (size_t)UINT32_MAX + 1)
+		ctx->token_count = (size_t)UINT32_MAX + 1;
+#else
+	(void)ctx;
+	(void)tokens;
+	(void)count;
+#endif
+}
+
+/**
+ * @brief Get the token of a stack item.
+ *
+ * Resolves the index of the item in the token buffer with MP_TOKEN_REF,
+ * returns the token stored in the item otherwise.
+ *
+ * @param ctx Parser context.
+ * @param item Stack item of type ITEM_TOKEN.
+ * @return The token, NULL with MP_TOKEN_REF if no token buffer is set.
+ */
+const t_lr_token	*lr_parser_token(
+						const t_lr_parser_ctx *ctx,
+						const t_lr_stack_item *item
+						)
+{
+#ifdef MP_TOKEN_REF
+	if (ctx->tokens == NULL)
+		return (NULL);
+	return (ctx->tokens + item->data.token_ref);
+#else
+	(void)ctx;
+	return (&item->data.token);
+#endif
+}
+
+/**
+ * @brief Reset the LR parser context for a new parse.
+ *
+ * Frees the items left on the stack by an unfinished or failed parse and
+ * pushes the initial axiom state back. The stack buffer is kept, so no
+ * allocation happens while parses fit in its capacity. The arena is rewound
+ * in a single step, the tree emptied and the token buffer forgotten.
+ *
+ * @param ctx Parser context to reset.
+ * @return LR_OK on success, error code on failure.
+ */
+t_lr_error	lr_parser_reset(
+				t_lr_parser_ctx *ctx
+				)
+{
+	t_lr_stack_item	axiom;
+
+	lr_stack_clear(&ctx->stack);
+	lr_arena_reset(&ctx->arena);
+	lr_tree_clear(&ctx->tree);
+	ctx->shifted = 0;
+#ifdef MP_TOKEN_REF
+	ctx->tokens = NULL;
+	ctx->token_count = 0;
+#endif
+	axiom = (t_lr_stack_item){.type = ITEM_AXIOM, .data = {}};
+	return (lr_stack_push(&ctx->stack, &axiom, 0));
 }
 
 /**
  * @brief Execute the LR parser on a token.
  *
  * Processes the given token through the parser, performing all necessary
- * shifts and reductions. On successful parse completion (LR_ACCEPT),
- * extracts the final derived value from the stack.
+ * shifts and reductions with the grammar engine, or the table interpreter
+ * when it has none, unchecked if the grammar is verified. On successful
+ * parse completion (LR_ACCEPT), extracts the final derived value from the
+ * stack.
  *
  * @param ctx Parser context.
  * @param token Token to process.
@@ -84,23 +445,78 @@ t_lr_error	lr_parser_exec(
 {
 	t_lr_error	r;
 
-	r = _lr_parser_exec(ctx, token);
+	if (ctx->grammar->engine != NULL)
+		r = ctx->grammar->engine(ctx, token);
+	else if (ctx->grammar->verified)
+		r = _lr_parser_exec_verified(ctx, token);
+	else
+		r = _lr_parser_exec(ctx, token);
 	if (r != LR_ACCEPT)
 		return (r);
-	if (lr_stack_used(&ctx->stack) != 2)
+	return (_lr_parser_accept(ctx, derived));
+}
+
+/**
+ * @brief Execute the LR parser on a buffer of tokens.
+ *
+ * Feeds the tokens to the engine (or the table interpreter) in a single
+ * loop until one of them is rejected, the input is accepted or the buffer
+ * is exhausted. With MP_TOKEN_REF the tokens become the token buffer if none
+ * is set.
+ *
+ * @param ctx Parser context.
+ * @param tokens Tokens to process.
+ * @param count Number of tokens.
+ * @param derived Output pointer to receive the final derived value on accept.
+ * @param consumed Output number of processed tokens, the accepting token
+ *                 included and the rejected one excluded.
+ * @return LR_OK if every token is shifted, LR_ACCEPT on successful
+ *         completion, other error codes on failure.
+ */
+t_lr_error	lr_parser_exec_n(
+				t_lr_parser_ctx *ctx,
+				const t_lr_token *tokens,
+				size_t count,
+				void **derived,
+				size_t *consumed
+				)
+{
+	const t_lr_engine	engine = ctx->grammar->engine;
+	size_t				k;
+	t_lr_error			r;
+
+#ifdef MP_TOKEN_REF
+	if (ctx->tokens == NULL)
+		lr_parser_set_tokens(ctx, tokens, count);
+#endif
+	r = LR_OK;
+	k = 0;
+	if (engine != NULL)
 	{
-		lr_stack_destroy(&ctx->stack);
-		return (LR_INTERNAL_ERROR);
+		while (k < count && r == LR_OK)
+			r = engine(ctx, tokens + k++);
 	}
-	*derived = ctx->stack.data[1].data.derived.data;
-	ctx->stack.used = 1;
-	return (LR_ACCEPT);
+	else if (ctx->grammar->verified)
+	{
+		while (k < count && r == LR_OK)
+			r = _lr_parser_exec_verified(ctx, tokens + k++);
+	}
+	else
+	{
+		while (k < count && r == LR_OK)
+			r = _lr_parser_exec(ctx, tokens + k++);
+	}
+	*consumed = k - (r != LR_OK && r != LR_ACCEPT);
+	if (r != LR_ACCEPT)
+		return (r);
+	return (_lr_parser_accept(ctx, derived));
 }
 
 /**
  * @brief Destroy the parser context.
  *
- * Frees all resources associated with the parser, including the stack.
+ * Frees all resources associated with the parser, including the stack, the
+ * arena chunks and the tree.
  *
  * @param ctx Parser context to destroy.
  */
@@ -109,4 +525,48 @@ void	lr_parser_destroy(
 			)
 {
 	lr_stack_destroy(&ctx->stack);
+	lr_arena_destroy(&ctx->arena);
+	lr_tree_destroy(&ctx->tree);
+#ifdef MP_STATS
+	lr_stats_destroy(&ctx->stats);
+#endif
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Extract the derived value of an accepted input.
+ *
+ * The stack must hold the axiom and the derived start symbol, which is
+ * handed over to the caller. In tree mode the caller gets the tree. With
+ * MP_TRACE the accept is recorded first.
+ *
+ * @param ctx Parser context.
+ * @param derived Output pointer to receive the final derived value.
+ * @return LR_ACCEPT, or LR_INTERNAL_ERROR if the stack is malformed.
+ */
+t_lr_error	_lr_parser_accept(
+				t_lr_parser_ctx *ctx,
+				void **derived
+				)
+{
+#ifdef MP_TRACE
+	if (ctx->trace != NULL)
+		_lr_trace_put(ctx->trace, LR_TRACE_ACCEPT,
+			lr_stack_cur_state(&ctx->stack), 0);
+#endif
+	if (lr_stack_used(&ctx->stack) != 2)
+	{
+		lr_stack_clear(&ctx->stack);
+		return (LR_INTERNAL_ERROR);
+	}
+	*derived = ctx->stack.data[1].data.derived.data;
+	if (ctx->stack.flags & LR_STACK_TREE)
+		*derived = &ctx->tree;
+	ctx->stack.used = 1;
+	return (LR_ACCEPT);
 }
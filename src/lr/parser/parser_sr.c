@@ -26,6 +26,59 @@
 
 #include "lr_parser.h"
 
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Call the callback of a production, if it has one.
+ *
+ * With MP_STATS the reduction is counted by the state it reduces in and by
+ * production, and its callback, if any, is timed. With MP_TRACE it is
+ * recorded by that state after the callback. A chain passes the state of
+ * each of its steps, which the stack only holds after the last one.
+ *
+ * @param ctx Parser context.
+ * @param state_id State the production reduces in.
+ * @param prod_id Production reduced by.
+ * @param items Items of the production.
+ * @return The derived value, NULL without callback.
+ */
+static void	*_lr_parser_call(
+				t_lr_parser_ctx *ctx,
+				t_lr_state_id state_id,
+				t_lr_prod_id prod_id,
+				t_lr_stack_item *items
+				)
+{
+	const t_lr_prod_cb	*prod_cb = ctx->grammar->prod_cb + prod_id;
+	void				*data;
+#ifdef MP_STATS
+	uint64_t			ns;
+
+	ns = 0;
+	if (prod_cb->cb != NULL)
+		ns = _lr_stats_now();
+#endif
+	data = NULL;
+	if (prod_cb->cb != NULL)
+		data = prod_cb->cb(items, ctx);
+#ifdef MP_STATS
+	if (prod_cb->cb != NULL)
+		ns = _lr_stats_now() - ns;
+	_lr_stats_reduce(&ctx->stats, state_id, prod_id, ns);
+#endif
+#ifdef MP_TRACE
+	if (ctx->trace != NULL)
+		_lr_trace_put(ctx->trace, LR_TRACE_REDUCE, state_id, prod_id);
+#else
+	(void)state_id;
+#endif
+	return (data);
+}
+
 // ************************************************************************** //
 // *                                                                        * //
 // * Header function.                                                       * //
@@ -33,75 +86,182 @@
 // ************************************************************************** //
 
 /**
- * @brief Internal recursive parser execution.
+ * @brief Internal parser execution.
  *
- * Implements the core LR parsing algorithm. Gets the action for the current
- * state and token, then performs the appropriate operation. For reduce actions,
- * recursively processes the same token after reduction.
+ * Implements the core LR parsing algorithm. Performs every reduction the
+ * token triggers in a loop, then shifts the token, accepts or reports the
+ * syntax error. On failure the stack items are freed but its buffer is kept
+ * for lr_parser_reset. Every table entry is checked before it is used, and
+ * a token ID the grammar does not have is a syntax error.
  *
  * @param ctx Parser context.
  * @param token Current token to process.
- * @return LR_ACCEPT on success, error code on failure.
+ * @return LR_OK when the token is shifted, LR_ACCEPT on success, error code
+ *         on failure.
  */
 t_lr_error	_lr_parser_exec(
-						t_lr_parser_ctx *ctx,
-						const t_lr_token *token
-						)
+				t_lr_parser_ctx *ctx,
+				const t_lr_token *token
+				)
 {
-	const t_lr_action	action = _lr_parser_get_action(ctx, token);
+	const t_lr_chain	*chain;
+	t_lr_action			action;
 	t_lr_error			err;
 
-	if (action.type == ACTION_ACCEPT)
-		return (LR_ACCEPT);
-	else if (action.type == ACTION_SHIFT)
+	if (token->id < 0 || (size_t)token->id >= ctx->grammar->token_count)
+		return (_lr_parser_error(ctx, token));
+	action = _lr_parser_get_action(ctx, token);
+	while (action.type == ACTION_REDUCE)
 	{
-		err = _lr_parser_shift(ctx, *token, action.data.shift_id);
+		chain = _lr_parser_find_chain(ctx, token, action.data.reduce_id);
+		if (chain != NULL)
+			err = _lr_parser_run_chain(ctx, chain);
+		else
+			err = _lr_parser_reduce(ctx, action.data.reduce_id);
 		if (err != LR_OK)
-			return (lr_stack_destroy(&ctx->stack), err);
+			return (lr_stack_clear(&ctx->stack), err);
+		action = _lr_parser_get_action(ctx, token);
 	}
-	else if (action.type == ACTION_REDUCE)
+	if (action.type == ACTION_ACCEPT)
+		return (LR_ACCEPT);
+	if (action.type != ACTION_SHIFT)
+		return (_lr_parser_error(ctx, token));
+	if (action.data.shift_id >= ctx->grammar->state_count)
+		return (lr_stack_clear(&ctx->stack), LR_INTERNAL_ERROR);
+	err = _lr_parser_shift(ctx, token, action.data.shift_id);
+	if (err != LR_OK)
+		lr_stack_clear(&ctx->stack);
+	return (err);
+}
+
+/**
+ * @brief Internal parser execution for a verified grammar.
+ *
+ * Same as _lr_parser_exec without any check: lr_grammar_verify proved that
+ * every table entry is in range and that no reduction underflows the
+ * stack.
+ *
+ * @param ctx Parser context.
+ * @param token Current token to process.
+ * @return LR_OK when the token is shifted, LR_ACCEPT on success, error code
+ *         on failure.
+ */
+t_lr_error	_lr_parser_exec_verified(
+				t_lr_parser_ctx *ctx,
+				const t_lr_token *token
+				)
+{
+	const t_lr_grammar	*grammar = ctx->grammar;
+	const t_lr_chain	*chain;
+	t_lr_action			action;
+	t_lr_prod_id		prod_id;
+	t_lr_error			err;
+
+	action = _lr_parser_get_action(ctx, token);
+	while (action.type == ACTION_REDUCE)
 	{
-		err = _lr_parser_reduce(ctx, action.data.reduce_id);
+		prod_id = action.data.reduce_id;
+		chain = _lr_parser_find_chain(ctx, token, prod_id);
+		if (chain != NULL)
+			err = _lr_parser_run_chain(ctx, chain);
+		else
+			err = _lr_parser_derive(ctx, prod_id, lr_grammar_goto(grammar,
+						lr_stack_state_under(&ctx->stack,
+							grammar->prod_cb[prod_id].size), prod_id));
 		if (err != LR_OK)
-			return (lr_stack_destroy(&ctx->stack), err);
+			return (lr_stack_clear(&ctx->stack), err);
+		action = _lr_parser_get_action(ctx, token);
 	}
-	else if (action.type == ACTION_ERROR)
-		return (lr_stack_destroy(&ctx->stack), LR_SYNTAX_ERROR);
+	if (action.type == ACTION_ACCEPT)
+		return (LR_ACCEPT);
 	if (action.type != ACTION_SHIFT)
-		return (_lr_parser_exec(ctx, token));
-	return (LR_OK);
+		return (_lr_parser_error(ctx, token));
+	err = _lr_parser_shift(ctx, token, action.data.shift_id);
+	if (err != LR_OK)
+		lr_stack_clear(&ctx->stack);
+	return (err);
 }
 
 /**
  * @brief Perform a shift operation.
  *
- * Creates a new stack item with the given token and target state,
- * then pushes it onto the parser stack.
+ * Creates a new stack item with the given token, or its index in the token
+ * buffer with MP_TOKEN_REF, and pushes it with the target state. A token
+ * out of the token buffer is refused before anything is pushed. In tree
+ * mode its leaf is appended to the tree first. With MP_STATS the shift is
+ * counted by the state it leaves and the new stack depth, and with MP_TRACE
+ * it is recorded by that state.
  *
  * @param ctx Parser context.
  * @param token Token to shift.
  * @param state_id Target state ID.
- * @return LR_OK on success, error code on failure.
+ * @return LR_OK on success, LR_INTERNAL_ERROR if the token is not in the
+ *         token buffer, error code on failure.
  */
 t_lr_error	_lr_parser_shift(
 				t_lr_parser_ctx *ctx,
-				t_lr_token token,
+				const t_lr_token *token,
 				t_lr_state_id state_id
 				)
 {
 	t_lr_stack_item	item;
 
+#ifdef MP_TOKEN_REF
+	if (ctx->tokens == NULL || (uintptr_t)token < (uintptr_t)ctx->tokens
+		|| (size_t)(token - ctx->tokens) >= ctx->token_count)
+		return (LR_INTERNAL_ERROR);
+#endif
+	if ((ctx->stack.flags & LR_STACK_TREE) && _lr_parser_tree_shift(ctx))
+		return (LR_BAD_ALLOC);
 	item.type = ITEM_TOKEN;
-	item.data.token = token;
-	item.state_id = state_id;
-	return (lr_stack_push(&ctx->stack, &item));
+#ifdef MP_TOKEN_REF
+	item.data.token_ref = (t_lr_token_ref)(token - ctx->tokens);
+#else
+	item.data.token = *token;
+#endif
+#ifdef MP_STATS
+	_lr_stats_shift(&ctx->stats, lr_stack_cur_state(&ctx->stack),
+		ctx->stack.used + 1);
+#endif
+#ifdef MP_TRACE
+	if (ctx->trace != NULL)
+		_lr_trace_put(ctx->trace, LR_TRACE_SHIFT,
+			lr_stack_cur_state(&ctx->stack), token->id);
+#endif
+	return (lr_stack_push(&ctx->stack, &item, state_id));
+}
+
+/**
+ * @brief Reject a token.
+ *
+ * Frees the stack items, keeping its buffer for lr_parser_reset. With
+ * MP_TRACE the error is recorded by the state the token is rejected in.
+ *
+ * @param ctx Parser context.
+ * @param token Rejected token.
+ * @return LR_SYNTAX_ERROR.
+ */
+t_lr_error	_lr_parser_error(
+				t_lr_parser_ctx *ctx,
+				const t_lr_token *token
+				)
+{
+#ifdef MP_TRACE
+	if (ctx->trace != NULL)
+		_lr_trace_put(ctx->trace, LR_TRACE_ERROR,
+			lr_stack_cur_state(&ctx->stack), token->id);
+#else
+	(void)token;
+#endif
+	lr_stack_clear(&ctx->stack);
+	return (LR_SYNTAX_ERROR);
 }
 
 /**
  * @brief Perform a reduce operation.
  *
- * Invokes the production callback with the items to be reduced, pops them
- * from the stack, then pushes the derived value with the appropriate goto state.
+ * Checks the production, that the stack holds more items than it pops and
+ * the goto state under them, then reduces them with _lr_parser_derive.
  *
  * @param ctx Parser context.
  * @param prod_id Production rule ID to reduce by.
@@ -112,36 +272,171 @@ t_lr_error	_lr_parser_reduce(
 				t_lr_prod_id prod_id
 				)
 {
-	const t_lr_prod_cb	prod_cb = ctx->prod_cb[prod_id];
+	size_t			size;
+	t_lr_state_id	state_id;
+
+	if (prod_id >= ctx->grammar->prod_count)
+		return (LR_INTERNAL_ERROR);
+	size = ctx->grammar->prod_cb[prod_id].size;
+	if (lr_stack_used(&ctx->stack) <= size)
+		return (LR_INTERNAL_ERROR);
+	state_id = _lr_parser_get_goto(ctx,
+			lr_stack_state_under(&ctx->stack, size), prod_id);
+	if (state_id >= ctx->grammar->state_count)
+		return (LR_INTERNAL_ERROR);
+	return (_lr_parser_derive(ctx, prod_id, state_id));
+}
+
+/**
+ * @brief Perform a reduce operation to a known goto state.
+ *
+ * Checks that the stack holds more items than the production pops before
+ * anything runs, then reduces them with _lr_parser_derive.
+ *
+ * @param ctx Parser context.
+ * @param prod_id Production rule ID to reduce by.
+ * @param state_id Goto state of the derived value.
+ * @return LR_OK on success, error code on failure (including LR_PROD_ERROR).
+ */
+t_lr_error	_lr_parser_reduce_to(
+				t_lr_parser_ctx *ctx,
+				t_lr_prod_id prod_id,
+				t_lr_state_id state_id
+				)
+{
+	if (lr_stack_used(&ctx->stack) <= ctx->grammar->prod_cb[prod_id].size)
+		return (LR_INTERNAL_ERROR);
+	return (_lr_parser_derive(ctx, prod_id, state_id));
+}
+
+/**
+ * @brief Reduce the top items of the stack, without any check.
+ *
+ * Invokes the production callback with the items to be reduced, pops them
+ * from the stack, then pushes the derived value with the given state. A
+ * production without callback derives a NULL value. Tree mode builds a
+ * node instead, see _lr_parser_tree_reduce. The stack must hold more items
+ * than the production size.
+ *
+ * @param ctx Parser context.
+ * @param prod_id Production rule ID to reduce by.
+ * @param state_id Goto state of the derived value.
+ * @return LR_OK on success, error code on failure (including LR_PROD_ERROR).
+ */
+t_lr_error	_lr_parser_derive(
+				t_lr_parser_ctx *ctx,
+				t_lr_prod_id prod_id,
+				t_lr_state_id state_id
+				)
+{
+	const t_lr_prod_cb	prod_cb = ctx->grammar->prod_cb[prod_id];
 	void				*data;
 	t_lr_stack_item		item;
 
-	data = prod_cb.cb(ctx->stack.data + ctx->stack.used - prod_cb.size,
-			ctx->usrptr);
-	if (lr_stack_popn(&ctx->stack, prod_cb.size))
+	if (ctx->stack.flags & LR_STACK_TREE)
 	{
-		if (prod_cb.free_cb != NULL)
-			prod_cb.free_cb(data, ctx->usrptr);
-		return (1);
+#ifdef MP_STATS
+		_lr_stats_reduce(&ctx->stats, lr_stack_cur_state(&ctx->stack),
+			prod_id, 0);
+#endif
+#ifdef MP_TRACE
+		if (ctx->trace != NULL)
+			_lr_trace_put(ctx->trace, LR_TRACE_REDUCE,
+				lr_stack_cur_state(&ctx->stack), prod_id);
+#endif
+		return (_lr_parser_tree_reduce(ctx, prod_id, state_id));
 	}
+	data = _lr_parser_call(ctx, lr_stack_cur_state(&ctx->stack), prod_id,
+			ctx->stack.data + ctx->stack.used - prod_cb.size);
+	ctx->stack.used -= prod_cb.size;
 	if (prod_cb.cb != NULL && data == NULL)
-		return (1);
+		return (LR_PROD_ERROR);
 	item = (t_lr_stack_item){
 		.type = ITEM_DERIVED,
 		.data.derived = {
 		.data = data,
 		.prod_free_cb = prod_cb.free_cb,
 	},
-		_lr_parser_get_goto(ctx, lr_stack_cur_state(&ctx->stack), prod_id),
 	};
-	return (lr_stack_push(&ctx->stack, &item));
+	return (lr_stack_push(&ctx->stack, &item, state_id));
 }
 
 /**
- * @brief Look up the goto state in the goto table.
+ * @brief Find the reduce chain starting with a reduction, if any.
  *
- * Calculates the index into the goto table based on the current state
- * and production ID, then returns the target state.
+ * Only unit reductions of a grammar with chains start one, and never in
+ * tree mode, which needs a node per reduction.
+ *
+ * @param ctx Parser context.
+ * @param token Current token.
+ * @param prod_id Production the top item reduces by.
+ * @return The chain, or NULL to reduce one production at a time.
+ */
+const t_lr_chain	*_lr_parser_find_chain(
+						t_lr_parser_ctx *ctx,
+						const t_lr_token *token,
+						t_lr_prod_id prod_id
+						)
+{
+	const t_lr_grammar	*grammar = ctx->grammar;
+
+	if (grammar->chains == NULL || ctx->stack.used < 2
+		|| (ctx->stack.flags & LR_STACK_TREE)
+		|| prod_id >= grammar->prod_count
+		|| grammar->prod_cb[prod_id].size != 1)
+		return (NULL);
+	return (lr_grammar_chain(grammar, ctx->stack.states[ctx->stack.used - 2],
+			ctx->stack.states[ctx->stack.used - 1], token->id));
+}
+
+/**
+ * @brief Run a chain of unit reductions on the top item.
+ *
+ * Each production derives the top item in place, so the stack neither
+ * shrinks nor grows, and the state of the last goto is stored once. Each
+ * step is counted and traced by the state the chain stored for it. A
+ * production without callback derives a NULL value.
+ *
+ * @param ctx Parser context.
+ * @param chain Chain of the top item, from _lr_parser_find_chain.
+ * @return LR_OK on success, LR_PROD_ERROR if a callback fails.
+ */
+t_lr_error	_lr_parser_run_chain(
+				t_lr_parser_ctx *ctx,
+				const t_lr_chain *chain
+				)
+{
+	const t_lr_chains	*chains = ctx->grammar->chains;
+	const t_lr_state_id	*states = chains->states + chain->first;
+	const t_lr_prod_id	*prods = chains->prods + chain->first;
+	t_lr_stack_item		*top;
+	t_lr_prod_cb		prod_cb;
+	void				*data;
+	uint32_t			k;
+
+	top = ctx->stack.data + ctx->stack.used - 1;
+	k = 0;
+	while (k < chain->count)
+	{
+		prod_cb = ctx->grammar->prod_cb[prods[k]];
+		data = _lr_parser_call(ctx, states[k], prods[k], top);
+		++k;
+		if (prod_cb.cb != NULL && data == NULL)
+			return (--ctx->stack.used, LR_PROD_ERROR);
+		*top = (t_lr_stack_item){
+			.type = ITEM_DERIVED,
+			.data.derived = {
+			.data = data,
+			.prod_free_cb = prod_cb.free_cb,
+		},
+		};
+	}
+	ctx->stack.states[ctx->stack.used - 1] = chain->state;
+	return (LR_OK);
+}
+
+/**
+ * @brief Look up the goto state in the goto table.
  *
  * @param ctx Parser context.
  * @param state_id Current state ID.
@@ -154,14 +449,14 @@ t_lr_state_id	_lr_parser_get_goto(
 							t_lr_prod_id prod_id
 							)
 {
-	return (ctx->goto_table[ctx->prod_count * state_id + prod_id]);
+	return (lr_grammar_goto(ctx->grammar, state_id, prod_id));
 }
 
 /**
  * @brief Look up the action in the action table.
  *
- * Gets the current state from the stack, then looks up the action
- * for this state and the given token in the action table.
+ * Gets the current state from the stack, then looks up the action for
+ * this state and the given token in the grammar tables.
  *
  * @param ctx Parser context.
  * @param token Current token.
@@ -172,7 +467,6 @@ t_lr_action	_lr_parser_get_action(
 						const t_lr_token *token
 						)
 {
-	const t_lr_state_id	cur_state = lr_stack_cur_state(&ctx->stack);
-
-	return (ctx->action_table[ctx->token_count * cur_state + token->id]);
+	return (lr_grammar_action(ctx->grammar, lr_stack_cur_state(&ctx->stack),
+			token->id));
 }
@@ -0,0 +1,97 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   parser_tree.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 20:14:39 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 20:14:39 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file parser_tree.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief LR parser tree mode.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include "lr_parser.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Append the leaf of a shifted token to the parse tree.
+ *
+ * The leaf covers the next token of the input.
+ *
+ * @param ctx Parser context.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error	_lr_parser_tree_shift(
+				t_lr_parser_ctx *ctx
+				)
+{
+	const t_lr_tree_node	leaf = {.prod_id = LR_TREE_TOKEN, .size = 1,
+		.first_token = ctx->shifted, .token_count = 1};
+
+	if (lr_tree_push(&ctx->tree, &leaf) != LR_OK)
+		return (LR_BAD_ALLOC);
+	++ctx->shifted;
+	return (LR_OK);
+}
+
+/**
+ * @brief Perform a reduce action in tree mode.
+ *
+ * Each item above the axiom owns one subtree and the subtrees of the top
+ * items end the post-order array, so the children of the new node are
+ * found by jumping back over their sizes. The node covers the tokens from
+ * the first one of its first child, or the next input token for an empty
+ * production, up to the last shifted one. The stack must hold more items
+ * than the production size.
+ *
+ * @param ctx Parser context.
+ * @param prod_id Production rule ID to reduce by.
+ * @param state_id Goto state of the derived item.
+ * @return LR_OK on success, error code on failure.
+ */
+t_lr_error	_lr_parser_tree_reduce(
+				t_lr_parser_ctx *ctx,
+				t_lr_prod_id prod_id,
+				t_lr_state_id state_id
+				)
+{
+	const size_t	size = ctx->grammar->prod_cb[prod_id].size;
+	t_lr_tree_node	node;
+	t_lr_stack_item	item;
+	size_t			first;
+	size_t			k;
+
+	ctx->stack.used -= size;
+	first = ctx->tree.count;
+	k = 0;
+	while (k++ < size)
+		first -= ctx->tree.nodes[first - 1].size;
+	node = (t_lr_tree_node){.prod_id = prod_id, .child_count = size,
+		.size = ctx->tree.count - first + 1, .first_token = ctx->shifted};
+	if (size != 0)
+		node.first_token = ctx->tree.nodes[first].first_token;
+	node.token_count = ctx->shifted - node.first_token;
+	if (lr_tree_push(&ctx->tree, &node) != LR_OK)
+		return (LR_BAD_ALLOC);
+	item = (t_lr_stack_item){.type = ITEM_DERIVED, .data.derived = {}};
+	return (lr_stack_push(&ctx->stack, &item, state_id));
+}
@@ -0,0 +1,200 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   units.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 20:41:07 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 20:41:07 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file units.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Unit production elimination.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdlib.h>
+
+#include "lr_grammar.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Tell whether a production derives a NULL value and frees nothing.
+ */
+static int	_lr_null_prod(
+				const t_lr_grammar *grammar,
+				t_lr_prod_id prod_id
+				)
+{
+	return (grammar->prod_cb[prod_id].cb == NULL
+		&& grammar->prod_cb[prod_id].free_cb == NULL);
+}
+
+/**
+ * @brief Find the states whose only action is a callback-less unit
+ *        reduction.
+ *
+ * Unless LR_UNITS_BYPASS_ALL is given the production must not have a free
+ * callback either.
+ *
+ * @return The production per state, LR_PROD_NONE for the other states, or
+ *         NULL on allocation failure.
+ */
+static t_lr_prod_id	*_lr_unit_states(
+						const t_lr_grammar *grammar,
+						int flags
+						)
+{
+	t_lr_grammar	consistent;
+	t_lr_prod_id	*units;
+	size_t			k;
+
+	consistent = *grammar;
+	if (lr_defaults_build(&consistent) != LR_OK)
+		return (NULL);
+	units = (t_lr_prod_id *)consistent.default_reduce;
+	k = 0;
+	while (k < grammar->state_count)
+	{
+		if (units[k] != LR_PROD_NONE && (units[k] >= grammar->prod_count
+				|| grammar->prod_cb[units[k]].size != 1
+				|| grammar->prod_cb[units[k]].cb != NULL
+				|| (!(flags & LR_UNITS_BYPASS_ALL)
+					&& !_lr_null_prod(grammar, units[k]))))
+			units[k] = LR_PROD_NONE;
+		++k;
+	}
+	return (units);
+}
+
+/**
+ * @brief Follow the unit reductions of a state entered from another one.
+ *
+ * Stops on a goto out of range, leaving it to lr_grammar_verify, and after
+ * as many steps as there are states in case of a cycle.
+ *
+ * @return The first state that is not bypassed.
+ */
+static t_lr_state_id	_lr_bypass(
+							const t_lr_grammar *grammar,
+							const t_lr_prod_id *units,
+							t_lr_state_id under,
+							t_lr_state_id state_id
+							)
+{
+	t_lr_state_id	next;
+	size_t			steps;
+
+	steps = 0;
+	while (state_id < grammar->state_count && units[state_id] != LR_PROD_NONE
+		&& steps++ < grammar->state_count)
+	{
+		next = lr_grammar_goto(grammar, under, units[state_id]);
+		if (next >= grammar->state_count)
+			break ;
+		state_id = next;
+	}
+	return (state_id);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Rewrite the tables so callback-less unit productions are bypassed.
+ *
+ * Reads the tables through lr_grammar_action and lr_grammar_goto, so any
+ * of their forms may be used, and writes dense copies where every shift
+ * and goto into such a state targets the state its reductions lead to.
+ * Unless LR_UNITS_BYPASS_ALL is given only the gotos of productions
+ * deriving a NULL value without free callback are rewritten, so every item
+ * a callback gets is the same.
+ *
+ * @param grammar Grammar holding prod_cb and its tables.
+ * @param flags 0 or LR_UNITS_BYPASS_ALL.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_INTERNAL_ERROR if prod_cb is missing.
+ */
+t_lr_error	lr_units_build(
+				t_lr_grammar *grammar,
+				int flags
+				)
+{
+	const int		keep = !(flags & LR_UNITS_BYPASS_ALL);
+	t_lr_prod_id	*units;
+	t_lr_action		*actions;
+	t_lr_state_id	*gotos;
+	size_t			k;
+
+	if (grammar->prod_cb == NULL)
+		return (LR_INTERNAL_ERROR);
+	units = _lr_unit_states(grammar, flags);
+	actions = malloc(grammar->state_count * grammar->token_count
+			* sizeof(*actions) + 1);
+	gotos = malloc(grammar->state_count * grammar->prod_count
+			* sizeof(*gotos) + 1);
+	if (units == NULL || actions == NULL || gotos == NULL)
+		return (free(units), free(actions), free(gotos), LR_BAD_ALLOC);
+	k = 0;
+	while (k < grammar->state_count * grammar->token_count)
+	{
+		actions[k] = lr_grammar_action(grammar, k / grammar->token_count,
+				k % grammar->token_count);
+		if (actions[k].type == ACTION_SHIFT && !keep)
+			actions[k].data.shift_id = _lr_bypass(grammar, units,
+					k / grammar->token_count, actions[k].data.shift_id);
+		++k;
+	}
+	k = 0;
+	while (k < grammar->state_count * grammar->prod_count)
+	{
+		gotos[k] = lr_grammar_goto(grammar, k / grammar->prod_count,
+				k % grammar->prod_count);
+		if (!keep || _lr_null_prod(grammar, k % grammar->prod_count))
+			gotos[k] = _lr_bypass(grammar, units, k / grammar->prod_count,
+					gotos[k]);
+		++k;
+	}
+	free(units);
+	*grammar = (t_lr_grammar){.prod_cb = grammar->prod_cb,
+		.token_free_cbs = grammar->token_free_cbs, .action_table = actions,
+		.goto_table = gotos, .state_count = grammar->state_count,
+		.token_count = grammar->token_count,
+		.prod_count = grammar->prod_count,
+		.default_reduce = grammar->default_reduce};
+	return (LR_OK);
+}
+
+/**
+ * @brief Free the tables rewritten by lr_units_build.
+ *
+ * @param grammar Grammar.
+ */
+void	lr_units_destroy(
+			t_lr_grammar *grammar
+			)
+{
+	free((void *)grammar->action_table);
+	free((void *)grammar->goto_table);
+	grammar->action_table = NULL;
+	grammar->goto_table = NULL;
+}
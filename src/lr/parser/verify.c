@@ -0,0 +1,500 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   verify.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:31:07 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 22:31:07 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file verify.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Grammar table verification.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lr_grammar.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Stack depth analysis state.
+ *
+ * State sets are bit sets of words words each. pred holds the edges of the
+ * automaton found so far, a shift or a goto from u to t setting bit u of
+ * the set of t.
+ */
+typedef struct s_lr_verify
+{
+	const t_lr_grammar	*grammar;	/**< Grammar being verified. */
+	uint64_t			*pred;		/**< Predecessor set of every state. */
+	uint64_t			*from;		/**< States of a backward walk. */
+	uint64_t			*next;		/**< Next states of a backward walk. */
+	size_t				*dist;		/**< Shortest path from 0, or SIZE_MAX. */
+	size_t				*queue;		/**< Breadth first search queue. */
+	char				*seen;		/**< Productions checked in a state. */
+	size_t				words;		/**< Words of a state set. */
+	int					changed;	/**< An edge was added by this pass. */
+}	t_lr_verify;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Check packed actions against the counts.
+ */
+static int	_lr_actions_ok(
+				const t_lr_grammar *grammar,
+				const t_lr_packed_action *actions,
+				size_t count
+				)
+{
+	t_lr_action	action;
+	size_t		k;
+
+	k = 0;
+	while (k < count)
+	{
+		action = LR_UNPACK_ACTION(actions[k]);
+		if ((action.type == ACTION_SHIFT
+				&& action.data.shift_id >= grammar->state_count)
+			|| (action.type == ACTION_REDUCE
+				&& action.data.reduce_id >= grammar->prod_count))
+			return (0);
+		++k;
+	}
+	return (1);
+}
+
+/**
+ * @brief Check the unpacked dense action table against the counts.
+ */
+static int	_lr_dense_ok(
+				const t_lr_grammar *grammar
+				)
+{
+	const size_t	count = grammar->state_count
+		* lr_grammar_columns(grammar);
+	t_lr_action		action;
+	size_t			k;
+
+	k = 0;
+	while (k < count)
+	{
+		action = grammar->action_table[k++];
+		if ((action.type == ACTION_SHIFT
+				&& action.data.shift_id >= grammar->state_count)
+			|| (action.type == ACTION_REDUCE
+				&& action.data.reduce_id >= grammar->prod_count)
+			|| action.type >= ACTION__COUNT)
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * @brief Check that comb rows of a given width fit in the slots.
+ */
+static int	_lr_bases_ok(
+				const size_t *base,
+				size_t count,
+				size_t width,
+				size_t slots
+				)
+{
+	size_t	k;
+
+	if (width > slots)
+		return (0);
+	k = 0;
+	while (k < count && base[k] <= slots - width)
+		++k;
+	return (k == count);
+}
+
+/**
+ * @brief Check goto states against the state count.
+ */
+static int	_lr_states_ok(
+				const t_lr_state_id *states,
+				size_t count,
+				size_t state_count
+				)
+{
+	size_t	k;
+
+	k = 0;
+	while (k < count && states[k] < state_count)
+		++k;
+	return (k == count);
+}
+
+/**
+ * @brief Check the comb slots a lookup can reach.
+ *
+ * A slot is only read when its check is a valid column, free slots may
+ * hold anything.
+ */
+static int	_lr_slots_ok(
+				const t_lr_grammar *grammar,
+				const t_lr_comb_action *action,
+				const t_lr_comb_goto *goto_comb
+				)
+{
+	size_t	k;
+
+	k = 0;
+	while (action != NULL && k < action->size)
+	{
+		if (action->check[k] >= 0
+			&& (size_t)action->check[k] < lr_grammar_columns(grammar)
+			&& !_lr_actions_ok(grammar, &action->next[k], 1))
+			return (0);
+		++k;
+	}
+	k = 0;
+	while (goto_comb != NULL && k < goto_comb->size)
+	{
+		if (goto_comb->check[k] < grammar->state_count
+			&& goto_comb->next[k] >= grammar->state_count)
+			return (0);
+		++k;
+	}
+	return (1);
+}
+
+/**
+ * @brief Check the default reductions against the production count.
+ */
+static int	_lr_defaults_ok(
+				const t_lr_grammar *grammar
+				)
+{
+	t_lr_prod_id	prod_id;
+	size_t			k;
+
+	k = 0;
+	while (k < grammar->state_count)
+	{
+		prod_id = grammar->default_reduce[k++];
+		if (prod_id != LR_PROD_NONE && prod_id >= grammar->prod_count)
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * @brief Check that every token maps to an action column.
+ */
+static int	_lr_token_map_ok(
+				const t_lr_grammar *grammar
+				)
+{
+	t_lr_token_id	column;
+	size_t			k;
+
+	k = 0;
+	while (k < grammar->token_count)
+	{
+		column = grammar->token_map[k++];
+		if (column < 0 || (size_t)column >= grammar->column_count)
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * @brief Check every table entry a lookup can read.
+ */
+static int	_lr_tables_ok(
+				const t_lr_grammar *grammar
+				)
+{
+	const t_lr_comb_action	*action = grammar->action_comb;
+	const t_lr_comb_goto	*goto_comb = grammar->goto_comb;
+	const size_t			cells = grammar->state_count * grammar->prod_count;
+	const size_t			columns = lr_grammar_columns(grammar);
+
+	if (action != NULL && (!_lr_bases_ok(action->base, grammar->state_count,
+				columns, action->size)
+			|| !_lr_actions_ok(grammar, action->defaults,
+				grammar->state_count)))
+		return (0);
+	if (goto_comb != NULL && (!_lr_bases_ok(goto_comb->base,
+				grammar->prod_count, grammar->state_count, goto_comb->size)
+			|| !_lr_states_ok(goto_comb->defaults, grammar->prod_count,
+				grammar->state_count)))
+		return (0);
+	if (action == NULL && grammar->packed_table != NULL
+		&& !_lr_actions_ok(grammar, grammar->packed_table,
+			grammar->state_count * columns))
+		return (0);
+	if (action == NULL && grammar->packed_table == NULL
+		&& !_lr_dense_ok(grammar))
+		return (0);
+	if (goto_comb == NULL
+		&& !_lr_states_ok(grammar->goto_table, cells, grammar->state_count))
+		return (0);
+	if (grammar->default_reduce != NULL
+		&& !_lr_defaults_ok(grammar))
+		return (0);
+	if (grammar->token_map != NULL && !_lr_token_map_ok(grammar))
+		return (0);
+	return (_lr_slots_ok(grammar, action, goto_comb));
+}
+
+/**
+ * @brief Compute the shortest path from state 0 to every state.
+ *
+ * A state at distance d is on top of at least d + 1 stack items, the
+ * axiom included, whatever the path to it.
+ */
+static void	_lr_distances(
+				t_lr_verify *v
+				)
+{
+	const size_t	count = v->grammar->state_count;
+	size_t			head;
+	size_t			tail;
+	size_t			u;
+	size_t			t;
+
+	memset(v->dist, 0xff, count * sizeof(*v->dist));
+	v->dist[0] = 0;
+	v->queue[0] = 0;
+	head = 0;
+	tail = 1;
+	while (head < tail)
+	{
+		u = v->queue[head++];
+		t = 0;
+		while (t < count)
+		{
+			if (v->dist[t] == SIZE_MAX
+				&& (v->pred[t * v->words + u / 64] >> (u % 64) & 1))
+			{
+				v->dist[t] = v->dist[u] + 1;
+				v->queue[tail++] = t;
+			}
+			++t;
+		}
+	}
+}
+
+/**
+ * @brief Find the reachable states n edges under a state.
+ *
+ * Those are the states a reduction of size n in state s may expose, the
+ * result is left in v->from.
+ */
+static void	_lr_walk_back(
+				t_lr_verify *v,
+				size_t s,
+				size_t n
+				)
+{
+	uint64_t	*swap;
+	size_t		t;
+	size_t		w;
+
+	memset(v->from, 0, v->words * sizeof(*v->from));
+	v->from[s / 64] |= (uint64_t)1 << (s % 64);
+	while (n-- != 0)
+	{
+		memset(v->next, 0, v->words * sizeof(*v->next));
+		t = 0;
+		while (t < v->grammar->state_count)
+		{
+			w = 0;
+			while ((v->from[t / 64] >> (t % 64) & 1) && w < v->words)
+			{
+				v->next[w] |= v->pred[t * v->words + w];
+				++w;
+			}
+			++t;
+		}
+		swap = v->from;
+		v->from = v->next;
+		v->next = swap;
+	}
+}
+
+/**
+ * @brief Add the goto edges of a reduction from the states in v->from.
+ */
+static void	_lr_add_gotos(
+				t_lr_verify *v,
+				t_lr_prod_id prod_id
+				)
+{
+	uint64_t	*set;
+	size_t		u;
+	size_t		t;
+
+	u = 0;
+	while (u < v->grammar->state_count)
+	{
+		if ((v->from[u / 64] >> (u % 64) & 1) && v->dist[u] != SIZE_MAX)
+		{
+			t = lr_grammar_goto(v->grammar, u, prod_id);
+			set = v->pred + t * v->words + u / 64;
+			if (!(*set >> (u % 64) & 1))
+				v->changed = 1;
+			*set |= (uint64_t)1 << (u % 64);
+		}
+		++u;
+	}
+}
+
+/**
+ * @brief Check the reductions of a reachable state.
+ *
+ * Every reduction must find more items than its size on the stack, even
+ * on the shortest path to the state.
+ */
+static int	_lr_state_ok(
+				t_lr_verify *v,
+				size_t s
+				)
+{
+	const t_lr_grammar	*grammar = v->grammar;
+	t_lr_action			action;
+	size_t				size;
+	size_t				k;
+
+	memset(v->seen, 0, grammar->prod_count);
+	k = 0;
+	while (k < grammar->token_count)
+	{
+		action = lr_grammar_action(grammar, s, k++);
+		if (action.type != ACTION_REDUCE || v->seen[action.data.reduce_id])
+			continue ;
+		v->seen[action.data.reduce_id] = 1;
+		size = grammar->prod_cb[action.data.reduce_id].size;
+		if (v->dist[s] < size)
+			return (0);
+		_lr_walk_back(v, s, size);
+		_lr_add_gotos(v, action.data.reduce_id);
+	}
+	return (1);
+}
+
+/**
+ * @brief Prove that no reduction can underflow the stack.
+ *
+ * Starts from the shift edges and adds the goto edges of every reduction
+ * of every reachable state until none is found anymore.
+ */
+static int	_lr_depth_ok(
+				t_lr_verify *v
+				)
+{
+	const t_lr_grammar	*grammar = v->grammar;
+	t_lr_action			action;
+	size_t				s;
+	size_t				k;
+
+	k = 0;
+	while (k < grammar->state_count * grammar->token_count)
+	{
+		s = k / grammar->token_count;
+		action = lr_grammar_action(grammar, s, k++ % grammar->token_count);
+		if (action.type == ACTION_SHIFT)
+			v->pred[action.data.shift_id * v->words + s / 64]
+				|= (uint64_t)1 << (s % 64);
+	}
+	v->changed = 1;
+	while (v->changed)
+	{
+		v->changed = 0;
+		_lr_distances(v);
+		s = 0;
+		while (s < grammar->state_count)
+		{
+			if (v->dist[s] != SIZE_MAX && !_lr_state_ok(v, s))
+				return (0);
+			++s;
+		}
+	}
+	return (1);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Verify the tables of a grammar and mark it as verified.
+ *
+ * Checks that every table entry a lookup can read is in range, then walks
+ * the automaton from state 0 to prove that every reduction of every
+ * reachable state finds enough items on the stack. On success, sets
+ * grammar->verified so that parsers skip their runtime checks.
+ *
+ * @param grammar Grammar to verify.
+ * @return LR_OK if the grammar is verified, LR_INTERNAL_ERROR if its tables
+ *         are missing or malformed, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error	lr_grammar_verify(
+				t_lr_grammar *grammar
+				)
+{
+	t_lr_verify	v;
+	int			ok;
+
+	grammar->verified = 0;
+	if (grammar->prod_cb == NULL || grammar->state_count == 0
+		|| (grammar->action_comb == NULL && grammar->packed_table == NULL
+			&& grammar->action_table == NULL)
+		|| (grammar->goto_comb == NULL && grammar->goto_table == NULL)
+		|| !_lr_tables_ok(grammar))
+		return (LR_INTERNAL_ERROR);
+	v = (t_lr_verify){.grammar = grammar,
+		.words = (grammar->state_count + 63) / 64};
+	v.pred = calloc(grammar->state_count * v.words, sizeof(*v.pred));
+	v.from = malloc(v.words * sizeof(*v.from));
+	v.next = malloc(v.words * sizeof(*v.next));
+	v.dist = malloc(grammar->state_count * sizeof(*v.dist));
+	v.queue = malloc(grammar->state_count * sizeof(*v.queue));
+	v.seen = malloc(grammar->prod_count + 1);
+	ok = -1;
+	if (v.pred != NULL && v.from != NULL && v.next != NULL && v.dist != NULL
+		&& v.queue != NULL && v.seen != NULL)
+		ok = _lr_depth_ok(&v);
+	free(v.pred);
+	free(v.from);
+	free(v.next);
+	free(v.dist);
+	free(v.queue);
+	free(v.seen);
+	if (ok < 0)
+		return (LR_BAD_ALLOC);
+	if (ok == 0)
+		return (LR_INTERNAL_ERROR);
+	grammar->verified = 1;
+	return (LR_OK);
+}
@@ -0,0 +1,215 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   recognizer.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 19:48:02 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 19:48:02 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file recognizer.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief LR recognizer implementation.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include "lr_recognizer.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Initialize an LR recognizer.
+ *
+ * Allocates the state stack and pushes the initial state.
+ *
+ * @param rec Recognizer to initialize.
+ * @param grammar Grammar to recognize.
+ * @param allocator Allocator of the state stack, NULL for the default one.
+ * @param capacity Initial stack capacity in states, 0 is treated as 1.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_INTERNAL_ERROR if the grammar has no action table.
+ */
+t_lr_error	lr_recognizer_init(
+				t_lr_recognizer *rec,
+				const t_lr_grammar *grammar,
+				const t_lr_allocator *allocator,
+				size_t capacity
+				)
+{
+	if (grammar->action_comb == NULL && grammar->packed_table == NULL
+		&& grammar->action_table == NULL)
+		return (LR_INTERNAL_ERROR);
+	rec->grammar = grammar;
+	rec->allocator = allocator;
+	rec->alloced = capacity + (capacity == 0);
+	rec->states = lr_alloc(allocator, rec->alloced * sizeof(*rec->states));
+	if (rec->states == NULL)
+		return (LR_BAD_ALLOC);
+	lr_recognizer_reset(rec);
+	return (LR_OK);
+}
+
+/**
+ * @brief Reset an LR recognizer for a new input.
+ *
+ * Leaves the initial state alone on the stack.
+ *
+ * @param rec Recognizer.
+ */
+void	lr_recognizer_reset(
+			t_lr_recognizer *rec
+			)
+{
+	rec->states[0] = 0;
+	rec->used = 1;
+}
+
+/**
+ * @brief Feed one token ID to an LR recognizer.
+ *
+ * Performs the reductions the token triggers by popping states and pushing
+ * their goto, then shifts the token state, accepts or reports the syntax
+ * error. Unless the grammar is verified, every table entry is checked
+ * before it is used, as by lr_parser_exec, and a token ID the grammar does
+ * not have is a syntax error.
+ *
+ * @param rec Recognizer.
+ * @param token_id Token ID.
+ * @return LR_OK when the token is shifted, LR_ACCEPT on success,
+ *         LR_INTERNAL_ERROR on a table entry out of range, error code on
+ *         other failures.
+ */
+t_lr_error	lr_recognizer_exec(
+				t_lr_recognizer *rec,
+				t_lr_token_id token_id
+				)
+{
+	const t_lr_grammar	*grammar = rec->grammar;
+	const int			checked = !grammar->verified;
+	t_lr_action			action;
+	t_lr_state_id		state_id;
+	size_t				size;
+	t_lr_error			err;
+
+	if (checked && (token_id < 0 || (size_t)token_id >= grammar->token_count))
+		return (LR_SYNTAX_ERROR);
+	action = lr_grammar_action(grammar, rec->states[rec->used - 1], token_id);
+	while (action.type == ACTION_REDUCE)
+	{
+		if (checked && action.data.reduce_id >= grammar->prod_count)
+			return (LR_INTERNAL_ERROR);
+		size = grammar->prod_cb[action.data.reduce_id].size;
+		if (size >= rec->used)
+			return (LR_INTERNAL_ERROR);
+		rec->used -= size;
+		state_id = lr_grammar_goto(grammar, rec->states[rec->used - 1],
+				action.data.reduce_id);
+		if (checked && state_id >= grammar->state_count)
+			return (LR_INTERNAL_ERROR);
+		err = _lr_recognizer_push(rec, state_id);
+		if (err != LR_OK)
+			return (err);
+		action = lr_grammar_action(grammar, rec->states[rec->used - 1],
+				token_id);
+	}
+	if (action.type == ACTION_ACCEPT)
+		return (LR_ACCEPT);
+	if (action.type != ACTION_SHIFT)
+		return (LR_SYNTAX_ERROR);
+	if (checked && action.data.shift_id >= grammar->state_count)
+		return (LR_INTERNAL_ERROR);
+	return (_lr_recognizer_push(rec, action.data.shift_id));
+}
+
+/**
+ * @brief Feed a buffer of tokens to an LR recognizer.
+ *
+ * @param rec Recognizer.
+ * @param tokens Tokens to process.
+ * @param count Number of tokens.
+ * @param consumed Output number of processed tokens, the accepting token
+ *                 included and the rejected one excluded.
+ * @return LR_OK if every token is shifted, LR_ACCEPT on success, error code
+ *         on failure.
+ */
+t_lr_error	lr_recognizer_exec_n(
+				t_lr_recognizer *rec,
+				const t_lr_token *tokens,
+				size_t count,
+				size_t *consumed
+				)
+{
+	size_t		k;
+	t_lr_error	r;
+
+	r = LR_OK;
+	k = 0;
+	while (k < count && r == LR_OK)
+		r = lr_recognizer_exec(rec, tokens[k++].id);
+	*consumed = k - (r != LR_OK && r != LR_ACCEPT);
+	return (r);
+}
+
+/**
+ * @brief Destroy an LR recognizer.
+ *
+ * @param rec Recognizer to destroy.
+ */
+void	lr_recognizer_destroy(
+			t_lr_recognizer *rec
+			)
+{
+	lr_free(rec->allocator, rec->states, rec->alloced * sizeof(*rec->states));
+	rec->states = NULL;
+	rec->alloced = 0;
+	rec->used = 0;
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Push a state, doubling the stack capacity when it is full.
+ *
+ * @param rec Recognizer.
+ * @param state_id State ID to push.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error	_lr_recognizer_push(
+				t_lr_recognizer *rec,
+				t_lr_state_id state_id
+				)
+{
+	t_lr_state_id	*states;
+
+	if (rec->used >= rec->alloced)
+	{
+		states = lr_realloc(rec->allocator, rec->states,
+				rec->alloced * sizeof(*states),
+				rec->alloced * 2 * sizeof(*states));
+		if (states == NULL)
+			return (LR_BAD_ALLOC);
+		rec->states = states;
+		rec->alloced *= 2;
+	}
+	rec->states[rec->used++] = state_id;
+	return (LR_OK);
+}
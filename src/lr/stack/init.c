@@ -24,9 +24,9 @@
 // *                                                                        * //
 // ************************************************************************** //
 
-#include "lr_stack.h"
+#include <stdint.h>
 
-#include "lr_utils.h"
+#include "lr_stack.h"
 
 // ************************************************************************** //
 // *                                                                        * //
@@ -37,58 +37,200 @@
 /**
  * @brief Initialize a parser stack.
  *
- * Allocates initial memory for the stack and sets up the token free callbacks.
- * The stack starts with an initial capacity of 1 item.
+ * Allocates initial memory for the stack with the default allocator and
+ * sets up the token free callbacks. The stack starts with an initial
+ * capacity of 1 item.
  *
  * @param stack Pointer to the stack to initialize.
  * @param token_free_cbs Array of token free callbacks indexed by token ID.
- * @param usrptr User pointer passed to all callbacks.
+ * @param ctx Parser context passed to the derived value callbacks.
  * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
  */
 t_lr_error	lr_stack_init(
 				t_lr_stack *stack,
-				t_lr_token_free_cb *token_free_cbs,
-				void *usrptr
+				const t_lr_token_free_cb *token_free_cbs,
+				t_lr_parser_ctx *ctx
+				)
+{
+	return (lr_stack_init_capacity(stack, token_free_cbs, ctx, NULL, 1));
+}
+
+/**
+ * @brief Initialize a parser stack with an allocator and a capacity.
+ *
+ * Same as lr_stack_init, the stack starts with room for capacity items so
+ * parses that stay under it never grow it, and its heap buffers come from
+ * allocator. A capacity that fits in the inline items uses them instead of
+ * allocating.
+ *
+ * @param stack Pointer to the stack to initialize.
+ * @param token_free_cbs Array of token free callbacks indexed by token ID.
+ * @param ctx Parser context passed to the derived value callbacks.
+ * @param allocator Allocator of the heap buffers, NULL for the default one.
+ * @param capacity Initial capacity in items, 0 is treated as 1.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error	lr_stack_init_capacity(
+				t_lr_stack *stack,
+				const t_lr_token_free_cb *token_free_cbs,
+				t_lr_parser_ctx *ctx,
+				const t_lr_allocator *allocator,
+				size_t capacity
 				)
 {
+	if (allocator == NULL)
+		allocator = &g_lr_default_allocator;
+	stack->used = 0;
+	stack->alloced = 0;
+	stack->token_free_cbs = token_free_cbs;
+	stack->ctx = ctx;
+	stack->allocator = allocator;
+	stack->flags = 0;
+	stack->data = NULL;
+	stack->states = NULL;
+#ifdef MP_STATS
+	stack->grows = 0;
+#endif
+#if MP_STACK_INLINE_CAPACITY > 0
+	if (capacity <= MP_STACK_INLINE_CAPACITY)
+	{
+		stack->alloced = MP_STACK_INLINE_CAPACITY;
+		stack->data = stack->inline_items;
+		stack->states = stack->inline_states;
+		return (LR_OK);
+	}
+#endif
+	return (_lr_stack_move(stack, allocator, capacity + (capacity == 0)));
+}
+
+/**
+ * @brief Initialize a parser stack on a caller buffer.
+ *
+ * Aligns buf for stack items and uses as many items as fit in the rest,
+ * their states following them.
+ *
+ * @param stack Pointer to the stack to initialize.
+ * @param token_free_cbs Array of token free callbacks indexed by token ID.
+ * @param ctx Parser context passed to the derived value callbacks.
+ * @param buf Caller buffer.
+ * @param size Size of buf in bytes.
+ * @param flags 0 or LR_STACK_NO_SPILL.
+ */
+void	lr_stack_init_buffer(
+			t_lr_stack *stack,
+			const t_lr_token_free_cb *token_free_cbs,
+			t_lr_parser_ctx *ctx,
+			void *buf,
+			size_t size,
+			int flags
+			)
+{
+	const size_t	pad = -(uintptr_t)buf & (_Alignof(t_lr_stack_item) - 1);
+
 	stack->used = 0;
-	stack->alloced = 1;
+	stack->alloced = 0;
+	if (size > pad)
+		stack->alloced = (size - pad) / LR_STACK_SLOT_SIZE;
 	stack->token_free_cbs = token_free_cbs;
-	stack->usrptr = usrptr;
-	stack->data = malloc(stack->alloced * sizeof(*stack->data));
-	if (stack->data == NULL)
-		return (LR_BAD_ALLOC);
+	stack->ctx = ctx;
+	stack->allocator = &g_lr_default_allocator;
+	stack->flags = flags & LR_STACK_NO_SPILL;
+#ifdef MP_STATS
+	stack->grows = 0;
+#endif
+	stack->data = (t_lr_stack_item *)((char *)buf + pad);
+	stack->states = (t_lr_state_id *)(stack->data + stack->alloced);
+}
+
+/**
+ * @brief Change the allocator of a parser stack.
+ *
+ * A heap buffer is copied to a block of the new allocator and released
+ * to the old one. Inline and caller buffers are left in place, only their
+ * future spill uses the new allocator.
+ *
+ * @param stack Pointer to the stack.
+ * @param allocator New allocator, NULL for the default one.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error	lr_stack_set_allocator(
+				t_lr_stack *stack,
+				const t_lr_allocator *allocator
+				)
+{
+	if (allocator == NULL)
+		allocator = &g_lr_default_allocator;
+	if ((stack->flags & LR_STACK_HEAP) && allocator != stack->allocator)
+		return (_lr_stack_move(stack, allocator, stack->alloced));
+	stack->allocator = allocator;
 	return (LR_OK);
 }
 
 /**
- * @brief Destroy a parser stack and free all resources.
+ * @brief Free every item of a parser stack and keep its buffer.
  *
  * Iterates through all items on the stack and frees them by calling their
- * appropriate callbacks. Then frees the stack array itself and resets counters.
+ * appropriate callbacks. The stack is left empty with its capacity intact.
+ * Derived values of an arena stack are not visited, so there is nothing to
+ * walk when no token needs freeing either. Referenced tokens
+ * (MP_TOKEN_REF) belong to the caller and are never freed, and so do the
+ * tokens of a tree stack, whose derived items hold no value.
  *
- * @param stack Pointer to the stack to destroy.
+ * @param stack Pointer to the stack to clear.
  */
-void	lr_stack_destroy(
+void	lr_stack_clear(
 			t_lr_stack *stack
 			)
 {
 	size_t	k;
 
 	k = 0;
+	if (stack->flags & LR_STACK_TREE)
+		k = stack->used;
+#ifdef MP_TOKEN_REF
+	if (stack->flags & LR_STACK_ARENA)
+		k = stack->used;
+#else
+	if ((stack->flags & LR_STACK_ARENA) && stack->token_free_cbs == NULL)
+		k = stack->used;
+#endif
 	while (k < stack->used)
 	{
 		if (stack->data[k].type == ITEM_DERIVED
+			&& !(stack->flags & LR_STACK_ARENA)
 			&& stack->data[k].data.derived.prod_free_cb != NULL)
 			stack->data[k].data.derived.prod_free_cb(
-				stack->data[k].data.derived.data, stack->usrptr);
+				stack->data[k].data.derived.data, stack->ctx);
+#ifndef MP_TOKEN_REF
 		else if (stack->data[k].type == ITEM_TOKEN
+			&& stack->token_free_cbs != NULL
 			&& stack->token_free_cbs[stack->data[k].data.token.id] != NULL)
 			stack->token_free_cbs[stack->data[k].data.token.id](
 				&stack->data[k].data.token.data);
+#endif
 		++k;
 	}
-	free(stack->data);
 	stack->used = 0;
+}
+
+/**
+ * @brief Destroy a parser stack and free all resources.
+ *
+ * Clears the stack, then frees the stack array itself when it is heap
+ * allocated and resets counters.
+ *
+ * @param stack Pointer to the stack to destroy.
+ */
+void	lr_stack_destroy(
+			t_lr_stack *stack
+			)
+{
+	lr_stack_clear(stack);
+	if (stack->flags & LR_STACK_HEAP)
+		lr_free(stack->allocator, stack->data,
+			stack->alloced * LR_STACK_SLOT_SIZE);
+	stack->data = NULL;
+	stack->states = NULL;
+	stack->flags = 0;
 	stack->alloced = 0;
 }
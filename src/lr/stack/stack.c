@@ -24,6 +24,8 @@
 // *                                                                        * //
 // ************************************************************************** //
 
+#include <string.h>
+
 #include "lr_stack.h"
 
 #include "lr_utils.h"
@@ -50,35 +52,32 @@ size_t	lr_stack_used(
 /**
  * @brief Push an item onto the stack.
  *
- * Copies the given item onto the top of the stack. If the stack is full,
+ * Copies the given item and its state onto the top of the stack. If the
+ * stack is full,
  * it is automatically grown by doubling its capacity.
  *
  * @param stack Pointer to the stack.
  * @param item Pointer to the item to push.
- * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ * @param state_id Parser state ID of the new level.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_STACK_OVERFLOW if the buffer is full and may not spill.
  */
 t_lr_error	lr_stack_push(
 				t_lr_stack *stack,
-				const t_lr_stack_item *item
+				const t_lr_stack_item *item,
+				t_lr_state_id state_id
 				)
 {
-	t_lr_stack_item	*tmp;
+	t_lr_error	err;
 
 	if (stack->used >= stack->alloced)
 	{
-		tmp = stack->data;
-		stack->data
-			= ft_realloc(stack->data, stack->alloced * sizeof(*stack->data),
-				stack->alloced * 2 * sizeof(*stack->data));
-		stack->alloced *= 2;
-		if (stack->data == NULL)
-		{
-			stack->data = tmp;
-			return (LR_BAD_ALLOC);
-		}
+		err = _lr_stack_grow(stack);
+		if (err != LR_OK)
+			return (err);
 	}
-	ft_memcpy(stack->data + stack->used, item, sizeof(*item));
-	++stack->used;
+	stack->data[stack->used] = *item;
+	stack->states[stack->used++] = state_id;
 	return (LR_OK);
 }
 
@@ -109,25 +108,21 @@ t_lr_error	lr_stack_pop(
  * @brief Pop multiple items from the stack.
  *
  * Removes count items from the top of the stack without freeing them.
- * This is used during reduce operations.
+ * This is used during reduce operations and only moves the top index.
  *
  * @param stack Pointer to the stack.
  * @param count Number of items to pop.
- * @return LR_OK on success, LR_INTERNAL_ERROR if not enough items on stack.
+ * @return LR_OK on success, LR_INTERNAL_ERROR if not enough items on stack
+ *         (the stack is then left as it is).
  */
 t_lr_error	lr_stack_popn(
 				t_lr_stack *stack,
 				size_t count
 				)
 {
-	t_lr_error	err;
-
-	while (count-- != 0)
-	{
-		err = lr_stack_pop(stack, NULL);
-		if (err != LR_OK)
-			return (err);
-	}
+	if (count > stack->used)
+		return (LR_INTERNAL_ERROR);
+	stack->used -= count;
 	return (LR_OK);
 }
 
@@ -144,5 +139,131 @@ t_lr_state_id	lr_stack_cur_state(
 					t_lr_stack *stack
 					)
 {
-	return (stack->data[stack->used - 1].state_id);
+	return (stack->states[stack->used - 1]);
+}
+
+/**
+ * @brief Get the state ID exposed once count items are popped.
+ *
+ * Used to resolve the goto of a reduction before popping its items.
+ *
+ * @param stack Pointer to the stack.
+ * @param count Number of top items to look under.
+ * @return The state ID of the item under the top count items.
+ */
+t_lr_state_id	lr_stack_state_under(
+					const t_lr_stack *stack,
+					size_t count
+					)
+{
+	return (stack->states[stack->used - count - 1]);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Resize the heap buffer of the stack.
+ *
+ * The states follow the payloads in the buffer, so once it is resized they
+ * are moved from the end of the old payloads to the end of the new ones.
+ *
+ * @param stack Pointer to the stack, owning a heap buffer.
+ * @param alloced New capacity, at least the used items.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+static t_lr_error	_lr_stack_realloc(
+						t_lr_stack *stack,
+						size_t alloced
+						)
+{
+	t_lr_stack_item	*data;
+
+	data = lr_realloc(stack->allocator, stack->data,
+			stack->alloced * LR_STACK_SLOT_SIZE, alloced * LR_STACK_SLOT_SIZE);
+	if (data == NULL)
+		return (LR_BAD_ALLOC);
+	stack->states = (t_lr_state_id *)(data + alloced);
+	memmove(stack->states, data + stack->alloced,
+		stack->used * sizeof(*stack->states));
+	stack->data = data;
+	stack->alloced = alloced;
+	return (LR_OK);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private header functions.                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Double the capacity of a full stack.
+ *
+ * A heap buffer is reallocated by the stack allocator. An inline or caller
+ * buffer is spilled to a new heap buffer, which the stack owns from then
+ * on, unless the stack has LR_STACK_NO_SPILL.
+ *
+ * @param stack Pointer to the stack.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure,
+ *         LR_STACK_OVERFLOW if the buffer may not spill.
+ */
+t_lr_error	_lr_stack_grow(
+				t_lr_stack *stack
+				)
+{
+	if (stack->flags & LR_STACK_NO_SPILL)
+		return (LR_STACK_OVERFLOW);
+#ifdef MP_STATS
+	++stack->grows;
+#endif
+	if (stack->flags & LR_STACK_HEAP)
+		return (_lr_stack_realloc(stack, stack->alloced * 2));
+	return (_lr_stack_move(stack, stack->allocator,
+			stack->alloced * 2 + (stack->alloced == 0)));
+}
+
+/**
+ * @brief Move the stack to a new heap buffer.
+ *
+ * Allocates room for alloced payloads followed by their states, copies the
+ * used levels of both arrays and releases the previous buffer if the stack
+ * owned it. Used to spill an inline or caller buffer and to change the
+ * allocator, a heap buffer of the same allocator is reallocated instead.
+ *
+ * @param stack Pointer to the stack.
+ * @param allocator Allocator of the new buffer, becomes the stack one.
+ * @param alloced Capacity of the new buffer, at least the used items.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error	_lr_stack_move(
+				t_lr_stack *stack,
+				const t_lr_allocator *allocator,
+				size_t alloced
+				)
+{
+	t_lr_stack_item	*data;
+	t_lr_state_id	*states;
+
+	data = lr_alloc(allocator, alloced * LR_STACK_SLOT_SIZE);
+	if (data == NULL)
+		return (LR_BAD_ALLOC);
+	states = (t_lr_state_id *)(data + alloced);
+	if (stack->used != 0)
+	{
+		memcpy(data, stack->data, stack->used * sizeof(*data));
+		memcpy(states, stack->states, stack->used * sizeof(*states));
+	}
+	if (stack->flags & LR_STACK_HEAP)
+		lr_free(stack->allocator, stack->data,
+			stack->alloced * LR_STACK_SLOT_SIZE);
+	stack->data = data;
+	stack->states = states;
+	stack->alloced = alloced;
+	stack->allocator = allocator;
+	stack->flags |= LR_STACK_HEAP;
+	return (LR_OK);
 }
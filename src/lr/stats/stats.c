@@ -0,0 +1,202 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:41:26 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 23:41:26 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file stats.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Parser hot path counters implementation.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <string.h>
+#include <time.h>
+
+#include "lr_stats.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Size of the arrays of counters in bytes.
+ */
+static size_t	_lr_stats_size(
+					const t_lr_stats *stats
+					)
+{
+	return ((stats->state_count + stats->prod_count) * 2 * sizeof(uint64_t));
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Initialize zeroed counters for a grammar.
+ *
+ * @param stats Counters to initialize.
+ * @param state_count Number of states of the grammar.
+ * @param prod_count Number of productions of the grammar.
+ * @param allocator Allocator of the arrays, NULL for the default one.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error	lr_stats_init(
+				t_lr_stats *stats,
+				size_t state_count,
+				size_t prod_count,
+				const t_lr_allocator *allocator
+				)
+{
+	stats->state_count = state_count;
+	stats->prod_count = prod_count;
+	stats->allocator = allocator;
+	stats->state_shifts = lr_alloc(allocator, _lr_stats_size(stats) + 1);
+	if (stats->state_shifts == NULL)
+		return (LR_BAD_ALLOC);
+	stats->state_reductions = stats->state_shifts + state_count;
+	stats->prod_reductions = stats->state_reductions + state_count;
+	stats->prod_ns = stats->prod_reductions + prod_count;
+	lr_stats_clear(stats);
+	return (LR_OK);
+}
+
+/**
+ * @brief Zero the counters.
+ *
+ * @param stats Counters.
+ */
+void	lr_stats_clear(
+			t_lr_stats *stats
+			)
+{
+	memset(stats->state_shifts, 0, _lr_stats_size(stats));
+	memset(stats->depth, 0, sizeof(stats->depth));
+	stats->max_depth = 0;
+	stats->grows = 0;
+}
+
+/**
+ * @brief Copy counters into others of the same grammar.
+ *
+ * @param dst Destination counters.
+ * @param src Source counters.
+ * @return LR_OK on success, LR_INTERNAL_ERROR if their sizes differ.
+ */
+t_lr_error	lr_stats_copy(
+				t_lr_stats *dst,
+				const t_lr_stats *src
+				)
+{
+	if (dst->state_count != src->state_count
+		|| dst->prod_count != src->prod_count)
+		return (LR_INTERNAL_ERROR);
+	memcpy(dst->state_shifts, src->state_shifts, _lr_stats_size(src));
+	memcpy(dst->depth, src->depth, sizeof(dst->depth));
+	dst->max_depth = src->max_depth;
+	dst->grows = src->grows;
+	return (LR_OK);
+}
+
+/**
+ * @brief Free the arrays of counters.
+ *
+ * @param stats Counters.
+ */
+void	lr_stats_destroy(
+			t_lr_stats *stats
+			)
+{
+	lr_free(stats->allocator, stats->state_shifts, _lr_stats_size(stats) + 1);
+	stats->state_shifts = NULL;
+	stats->state_reductions = NULL;
+	stats->prod_reductions = NULL;
+	stats->prod_ns = NULL;
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private header functions.                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Count a shift.
+ *
+ * @param stats Counters.
+ * @param state_id State the shift leaves.
+ * @param depth Stack depth after the shift.
+ */
+void	_lr_stats_shift(
+			t_lr_stats *stats,
+			t_lr_state_id state_id,
+			size_t depth
+			)
+{
+	size_t	bucket;
+	size_t	d;
+
+	++stats->state_shifts[state_id];
+	if (depth > stats->max_depth)
+		stats->max_depth = depth;
+	bucket = 0;
+	d = depth;
+	while (d > 1 && bucket < LR_STATS_DEPTH_BUCKETS - 1)
+	{
+		d >>= 1;
+		++bucket;
+	}
+	++stats->depth[bucket];
+}
+
+/**
+ * @brief Count a reduction.
+ *
+ * @param stats Counters.
+ * @param state_id State the reduction happens in.
+ * @param prod_id Production reduced by.
+ * @param ns Nanoseconds spent in its callback.
+ */
+void	_lr_stats_reduce(
+			t_lr_stats *stats,
+			t_lr_state_id state_id,
+			t_lr_prod_id prod_id,
+			uint64_t ns
+			)
+{
+	++stats->state_reductions[state_id];
+	++stats->prod_reductions[prod_id];
+	stats->prod_ns[prod_id] += ns;
+}
+
+/**
+ * @brief Read the monotonic clock timing the callbacks.
+ *
+ * @return Nanoseconds.
+ */
+uint64_t	_lr_stats_now(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
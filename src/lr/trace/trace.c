@@ -0,0 +1,275 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:58:12 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 23:58:12 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file trace.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Parser action trace ring and its file.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+# include <x86intrin.h>
+#endif
+
+#include "lr_trace.h"
+
+#include "lr_io.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Size of the ring in bytes, timestamps included.
+ */
+static size_t	_lr_trace_size(
+					const t_lr_trace *trace
+					)
+{
+	size_t	size;
+
+	size = sizeof(t_lr_trace_record);
+	if (trace->flags & LR_TRACE_TSC)
+		size += sizeof(uint64_t);
+	return ((trace->mask + 1) * size);
+}
+
+/**
+ * @brief Read the timestamp of a record.
+ *
+ * The time stamp counter costs a few cycles where there is one, the
+ * monotonic clock in nanoseconds stands in elsewhere.
+ */
+static uint64_t	_lr_trace_now(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return (__rdtsc());
+#else
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+#endif
+}
+
+/**
+ * @brief Write the kept entries of a ring array, oldest first.
+ *
+ * @param trace Trace.
+ * @param fd File descriptor.
+ * @param array Ring array.
+ * @param size Size of an entry in bytes.
+ * @return 0 on success, -1 on failure.
+ */
+static int	_lr_trace_write(
+				const t_lr_trace *trace,
+				int fd,
+				const void *array,
+				size_t size
+				)
+{
+	const char	*bytes = array;
+	size_t		start;
+
+	if (trace->head <= trace->mask)
+		return (lr_io_write(fd, bytes, trace->head * size));
+	start = trace->head & trace->mask;
+	if (lr_io_write(fd, bytes + start * size,
+			(trace->mask + 1 - start) * size) < 0)
+		return (-1);
+	return (lr_io_write(fd, bytes, start * size));
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Initialize an empty trace.
+ *
+ * The records and the timestamps share a single allocation.
+ *
+ * @param trace Trace to initialize.
+ * @param capacity Records kept, rounded up to a power of two.
+ * @param flags 0 or LR_TRACE_TSC.
+ * @param allocator Allocator of the ring, NULL for the default one.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error	lr_trace_init(
+				t_lr_trace *trace,
+				size_t capacity,
+				int flags,
+				const t_lr_allocator *allocator
+				)
+{
+	trace->mask = 0;
+	while (trace->mask + 1 < capacity)
+		trace->mask = trace->mask << 1 | 1;
+	trace->flags = flags;
+	trace->allocator = allocator;
+	trace->head = 0;
+	trace->tsc = NULL;
+	trace->records = lr_alloc(allocator, _lr_trace_size(trace));
+	if (trace->records == NULL)
+		return (LR_BAD_ALLOC);
+	if (flags & LR_TRACE_TSC)
+		trace->tsc = (uint64_t *)(trace->records + trace->mask + 1);
+	return (LR_OK);
+}
+
+/**
+ * @brief Drop every record of a trace.
+ *
+ * @param trace Trace.
+ */
+void	lr_trace_clear(
+			t_lr_trace *trace
+			)
+{
+	trace->head = 0;
+}
+
+/**
+ * @brief Free the ring of a trace.
+ *
+ * @param trace Trace.
+ */
+void	lr_trace_destroy(
+			t_lr_trace *trace
+			)
+{
+	lr_free(trace->allocator, trace->records, _lr_trace_size(trace));
+	trace->records = NULL;
+	trace->tsc = NULL;
+	trace->head = 0;
+}
+
+/**
+ * @brief Save the records of a trace to a file, oldest first.
+ *
+ * Writes the header, the records kept by the ring, then their timestamps.
+ *
+ * @param trace Trace.
+ * @param path Path of the file.
+ * @return LR_OK on success, LR_IO_ERROR on failure.
+ */
+t_lr_error	lr_trace_save(
+				const t_lr_trace *trace,
+				const char *path
+				)
+{
+	t_lr_trace_header	header;
+	int					fd;
+	int					r;
+
+	header = (t_lr_trace_header){.magic = LR_TRACE_MAGIC,
+		.version = LR_TRACE_VERSION, .flags = trace->flags & LR_TRACE_TSC,
+		.record_size = sizeof(t_lr_trace_record), .count = trace->head};
+	if (trace->head > trace->mask + 1)
+		header.count = trace->mask + 1;
+	header.dropped = trace->head - header.count;
+	fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return (LR_IO_ERROR);
+	r = lr_io_write(fd, &header, sizeof(header));
+	if (r == 0)
+		r = _lr_trace_write(trace, fd, trace->records,
+				sizeof(t_lr_trace_record));
+	if (r == 0 && trace->tsc != NULL)
+		r = _lr_trace_write(trace, fd, trace->tsc, sizeof(uint64_t));
+	if (close(fd) < 0 || r < 0)
+		return (LR_IO_ERROR);
+	return (LR_OK);
+}
+
+/**
+ * @brief Read a saved trace in place.
+ *
+ * @param view Output view.
+ * @param data Saved trace.
+ * @param size Size of data in bytes.
+ * @return LR_OK on success, LR_BAD_FORMAT if data is not a valid trace.
+ */
+t_lr_error	lr_trace_view(
+				t_lr_trace_view *view,
+				const void *data,
+				size_t size
+				)
+{
+	const t_lr_trace_header	*header = data;
+	size_t					entry;
+
+	if (size < sizeof(*header) || header->magic != LR_TRACE_MAGIC
+		|| header->version != LR_TRACE_VERSION
+		|| header->record_size != sizeof(t_lr_trace_record)
+		|| (header->flags & ~LR_TRACE_TSC) != 0)
+		return (LR_BAD_FORMAT);
+	entry = sizeof(t_lr_trace_record);
+	if (header->flags & LR_TRACE_TSC)
+		entry += sizeof(uint64_t);
+	if ((size - sizeof(*header)) % entry != 0
+		|| header->count != (size - sizeof(*header)) / entry)
+		return (LR_BAD_FORMAT);
+	view->records = (const t_lr_trace_record *)(header + 1);
+	view->tsc = NULL;
+	if (header->flags & LR_TRACE_TSC)
+		view->tsc = (const uint64_t *)(view->records + header->count);
+	view->count = header->count;
+	view->dropped = header->dropped;
+	return (LR_OK);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private header function.                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Append a record to a trace.
+ *
+ * Overwrites the oldest record once the ring is full.
+ *
+ * @param trace Trace.
+ * @param type Parser action.
+ * @param state_id State on top of the stack.
+ * @param id Token or production ID, 0 for an accept.
+ */
+void	_lr_trace_put(
+			t_lr_trace *trace,
+			t_lr_trace_type type,
+			t_lr_state_id state_id,
+			uint32_t id
+			)
+{
+	const size_t	k = trace->head++ & trace->mask;
+
+	trace->records[k] = (t_lr_trace_record){.state = state_id,
+		.data = (uint32_t)type << LR_TRACE_ID_BITS | (id & LR_TRACE_ID_MAX)};
+	if (trace->tsc != NULL)
+		trace->tsc[k] = _lr_trace_now();
+}
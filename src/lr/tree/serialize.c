@@ -0,0 +1,234 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   serialize.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 20:52:18 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 20:52:18 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file serialize.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Parse tree serialization and mapping.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "lr_tree.h"
+
+#include "lr_io.h"
+#include "lr_utils.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Fill the header of a serialized tree.
+ */
+static void	_lr_tree_header(
+				const t_lr_tree *tree,
+				t_lr_tree_header *header
+				)
+{
+	*header = (t_lr_tree_header){.magic = LR_TREE_MAGIC,
+		.version = LR_TREE_VERSION, .prod_id_size = sizeof(t_lr_prod_id),
+		.node_size = sizeof(t_lr_tree_node), .count = tree->count};
+}
+
+/**
+ * @brief Check that the children of node i exactly fill its subtree.
+ *
+ * The nodes before i are already checked, so the jumps stay in bounds.
+ *
+ * @return 0 if the node is consistent, -1 otherwise.
+ */
+static int	_lr_tree_check_node(
+				const t_lr_tree_node *nodes,
+				size_t i
+				)
+{
+	const t_lr_tree_node	*node = nodes + i;
+	size_t					left;
+	size_t					k;
+
+	if (node->size == 0 || node->size > i + 1
+		|| node->token_count > UINT32_MAX - node->first_token)
+		return (-1);
+	if (node->prod_id == LR_TREE_TOKEN)
+		return (-(node->child_count != 0 || node->size != 1));
+	left = node->size - 1;
+	k = 0;
+	while (k++ < node->child_count)
+	{
+		if (left == 0 || nodes[i - 1].size > left)
+			return (-1);
+		left -= nodes[i - 1].size;
+		i -= nodes[i - 1].size;
+	}
+	return (-(left != 0));
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Get the size of a serialized parse tree.
+ *
+ * @param tree Tree.
+ * @return Size in bytes, header included.
+ */
+size_t	lr_tree_serialized_size(
+			const t_lr_tree *tree
+			)
+{
+	return (sizeof(t_lr_tree_header) + tree->count * sizeof(t_lr_tree_node));
+}
+
+/**
+ * @brief Serialize a parse tree.
+ *
+ * Writes the header, then copies the nodes as they are.
+ *
+ * @param tree Tree.
+ * @param buf Output buffer of lr_tree_serialized_size bytes.
+ * @return Number of bytes written.
+ */
+size_t	lr_tree_serialize(
+			const t_lr_tree *tree,
+			void *buf
+			)
+{
+	_lr_tree_header(tree, buf);
+	ft_memcpy((t_lr_tree_header *)buf + 1, tree->nodes,
+		tree->count * sizeof(t_lr_tree_node));
+	return (lr_tree_serialized_size(tree));
+}
+
+/**
+ * @brief Read a serialized parse tree in place.
+ *
+ * Checks the header against this build, then every node in order so that
+ * walking the view by subtree sizes never leaves the array.
+ *
+ * @param tree Output tree view.
+ * @param data Serialized tree.
+ * @param size Size of data in bytes.
+ * @return LR_OK on success, LR_BAD_FORMAT if data is not a valid tree.
+ */
+t_lr_error	lr_tree_view(
+				t_lr_tree *tree,
+				const void *data,
+				size_t size
+				)
+{
+	const t_lr_tree_header	*header = data;
+	const t_lr_tree_node	*nodes = (const t_lr_tree_node *)(header + 1);
+	size_t					k;
+
+	if (size < sizeof(*header) || header->magic != LR_TREE_MAGIC
+		|| header->version != LR_TREE_VERSION
+		|| header->prod_id_size != sizeof(t_lr_prod_id)
+		|| header->node_size != sizeof(t_lr_tree_node)
+		|| header->count != (size - sizeof(*header)) / sizeof(*nodes)
+		|| (size - sizeof(*header)) % sizeof(*nodes) != 0)
+		return (LR_BAD_FORMAT);
+	k = 0;
+	while (k < header->count)
+		if (_lr_tree_check_node(nodes, k++) < 0)
+			return (LR_BAD_FORMAT);
+	lr_tree_init(tree, NULL);
+	tree->nodes = (t_lr_tree_node *)nodes;
+	tree->count = header->count;
+	return (LR_OK);
+}
+
+/**
+ * @brief Save a parse tree to a file.
+ *
+ * @param tree Tree.
+ * @param path Path of the file.
+ * @return LR_OK on success, LR_IO_ERROR on failure.
+ */
+t_lr_error	lr_tree_save(
+				const t_lr_tree *tree,
+				const char *path
+				)
+{
+	t_lr_tree_header	header;
+	int					fd;
+	int					r;
+
+	fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return (LR_IO_ERROR);
+	_lr_tree_header(tree, &header);
+	r = lr_io_write(fd, &header, sizeof(header));
+	if (r == 0)
+		r = lr_io_write(fd, tree->nodes,
+				tree->count * sizeof(t_lr_tree_node));
+	if (close(fd) < 0 || r < 0)
+		return (LR_IO_ERROR);
+	return (LR_OK);
+}
+
+/**
+ * @brief Map a saved parse tree read-only.
+ *
+ * @param tree Output tree view.
+ * @param path Path of the file.
+ * @return LR_OK on success, LR_IO_ERROR if the file cannot be mapped,
+ *         LR_BAD_FORMAT if it is not a valid tree.
+ */
+t_lr_error	lr_tree_map(
+				t_lr_tree *tree,
+				const char *path
+				)
+{
+	void		*data;
+	size_t		size;
+	t_lr_error	err;
+
+	data = lr_io_map(path, &size);
+	if (data == NULL)
+		return (LR_IO_ERROR);
+	err = lr_tree_view(tree, data, size);
+	if (err != LR_OK)
+		lr_io_unmap(data, size);
+	return (err);
+}
+
+/**
+ * @brief Unmap a parse tree mapped by lr_tree_map.
+ *
+ * The mapping starts with the header, right before the nodes, and has the
+ * exact size of the serialized tree.
+ *
+ * @param tree Tree view.
+ */
+void	lr_tree_unmap(
+			t_lr_tree *tree
+			)
+{
+	lr_io_unmap((t_lr_tree_header *)tree->nodes - 1,
+		lr_tree_serialized_size(tree));
+	lr_tree_init(tree, NULL);
+}
@@ -0,0 +1,155 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tree.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 20:14:39 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 20:14:39 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file tree.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Flat post-order parse tree implementation.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include "lr_tree.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Initialize an empty parse tree.
+ *
+ * Nothing is allocated until the first node is appended.
+ *
+ * @param tree Tree to initialize.
+ * @param allocator Allocator of the nodes, NULL for the default one.
+ */
+void	lr_tree_init(
+			t_lr_tree *tree,
+			const t_lr_allocator *allocator
+			)
+{
+	tree->nodes = NULL;
+	tree->count = 0;
+	tree->alloced = 0;
+	tree->allocator = allocator;
+}
+
+/**
+ * @brief Append a node to a parse tree.
+ *
+ * Doubles the capacity of a full tree.
+ *
+ * @param tree Tree.
+ * @param node Node to append.
+ * @return LR_OK on success, LR_BAD_ALLOC on allocation failure.
+ */
+t_lr_error	lr_tree_push(
+				t_lr_tree *tree,
+				const t_lr_tree_node *node
+				)
+{
+	const size_t	alloced = tree->alloced * 2 + 16 * (tree->alloced == 0);
+	t_lr_tree_node	*nodes;
+
+	if (tree->count >= tree->alloced)
+	{
+		nodes = lr_realloc(tree->allocator, tree->nodes,
+				tree->alloced * sizeof(*nodes), alloced * sizeof(*nodes));
+		if (nodes == NULL)
+			return (LR_BAD_ALLOC);
+		tree->nodes = nodes;
+		tree->alloced = alloced;
+	}
+	tree->nodes[tree->count++] = *node;
+	return (LR_OK);
+}
+
+/**
+ * @brief Get the index of the root of a parse tree.
+ *
+ * @param tree Non empty tree.
+ * @return Index of the root node, the last one.
+ */
+size_t	lr_tree_root(
+			const t_lr_tree *tree
+			)
+{
+	return (tree->count - 1);
+}
+
+/**
+ * @brief Get the index of the last child of a node.
+ *
+ * @param tree Tree.
+ * @param node Index of a node with children.
+ * @return Index of its last child, right before it.
+ */
+size_t	lr_tree_last_child(
+			const t_lr_tree *tree,
+			size_t node
+			)
+{
+	(void)tree;
+	return (node - 1);
+}
+
+/**
+ * @brief Get the index of the previous sibling of a node.
+ *
+ * @param tree Tree.
+ * @param node Index of a node that is not the first child of its parent.
+ * @return Index of its previous sibling, right before its subtree.
+ */
+size_t	lr_tree_prev_sibling(
+			const t_lr_tree *tree,
+			size_t node
+			)
+{
+	return (node - tree->nodes[node].size);
+}
+
+/**
+ * @brief Remove every node of a parse tree and keep its buffer.
+ *
+ * @param tree Tree.
+ */
+void	lr_tree_clear(
+			t_lr_tree *tree
+			)
+{
+	tree->count = 0;
+}
+
+/**
+ * @brief Free the nodes of a parse tree.
+ *
+ * A view has no capacity, its nodes belong to the serialized data.
+ *
+ * @param tree Tree.
+ */
+void	lr_tree_destroy(
+			t_lr_tree *tree
+			)
+{
+	if (tree->alloced == 0)
+		return ;
+	lr_free(tree->allocator, tree->nodes, tree->alloced * sizeof(*tree->nodes));
+	lr_tree_init(tree, tree->allocator);
+}
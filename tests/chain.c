@@ -0,0 +1,367 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   chain.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 09:12:40 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/18 09:12:40 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file chain.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Traces and counters of a grammar with reduce chains.
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdio.h>
+#include <string.h>
+
+#include "expr_tables.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Defines.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Records kept by the traces, enough for the whole input.
+ */
+#define TEST_TRACE_SIZE	1024
+
+/**
+ * @brief Number of tokens of the input, the end of input included.
+ */
+#define TEST_INPUT_COUNT	16
+
+/**
+ * @brief Bound on the chains of the grammar, about 70 can be taken.
+ *
+ * Chaining every goto entry of the tables instead gives about 200.
+ */
+#define TEST_CHAIN_COUNT	100
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Replay of a trace on the tables.
+ */
+typedef struct s_test_replay
+{
+	const t_lr_grammar	*grammar;	/**< Grammar traced. */
+	t_lr_state_id		states[TEST_INPUT_COUNT + 1];	/**< Stack. */
+	size_t				used;		/**< States on the stack. */
+	size_t				next;		/**< Next token of the input. */
+}	t_test_replay;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Grammar.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Derive a non-NULL value.
+ */
+static void	*_value(
+				t_lr_stack_item *items,
+				t_lr_parser_ctx *ctx
+				)
+{
+	(void)items;
+	(void)ctx;
+	return ((void *)1);
+}
+
+static const t_lr_prod_cb	g_prods[EXPR_PROD_COUNT] = {
+	EXPR_PROD(EXPR_0, _value, NULL),
+	EXPR_PROD(EXPR_1, _value, NULL),
+	EXPR_PROD(TERM_0, _value, NULL),
+	EXPR_PROD(TERM_1, NULL, NULL),
+	EXPR_PROD(UNARY_0, _value, NULL),
+	EXPR_PROD(UNARY_1, NULL, NULL),
+	EXPR_PROD(ATOM_0, _value, NULL),
+	EXPR_PROD(ATOM_1, _value, NULL),
+};
+
+static const t_lr_grammar	g_grammar = {EXPR_TABLES, .prod_cb = g_prods};
+
+/**
+ * @brief 1 + 2 * 3 + -(4 + -5) * 6
+ */
+static const t_lr_token_id	g_input[TEST_INPUT_COUNT] = {
+	EXPR_TOK_NUM, EXPR_TOK_PLUS, EXPR_TOK_NUM, EXPR_TOK_STAR, EXPR_TOK_NUM,
+	EXPR_TOK_PLUS, EXPR_TOK_MINUS, EXPR_TOK_LPAREN, EXPR_TOK_NUM,
+	EXPR_TOK_PLUS, EXPR_TOK_MINUS, EXPR_TOK_NUM, EXPR_TOK_RPAREN,
+	EXPR_TOK_STAR, EXPR_TOK_NUM, EXPR_TOK_END,
+};
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Checks.                                                                * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Parse the input into a trace and counters.
+ *
+ * @return 0 if the input is accepted, -1 otherwise.
+ */
+static int	_parse(
+				const t_lr_grammar *grammar,
+				t_lr_trace *trace,
+				t_lr_stats *stats
+				)
+{
+	t_lr_parser_ctx	ctx;
+	t_lr_token		tokens[TEST_INPUT_COUNT];
+	void			*derived;
+	size_t			consumed;
+	t_lr_error		err;
+	size_t			k;
+
+	k = 0;
+	while (k < TEST_INPUT_COUNT)
+	{
+		tokens[k] = (t_lr_token){.id = g_input[k]};
+		++k;
+	}
+	if (lr_parser_init(&ctx, grammar, NULL) != LR_OK)
+		return (-1);
+	lr_parser_set_trace(&ctx, trace);
+	lr_parser_set_tokens(&ctx, tokens, TEST_INPUT_COUNT);
+	err = lr_parser_exec_n(&ctx, tokens, TEST_INPUT_COUNT, &derived,
+			&consumed);
+	if (err == LR_ACCEPT && lr_parser_stats(&ctx, stats) != LR_OK)
+		err = LR_INTERNAL_ERROR;
+	lr_parser_destroy(&ctx);
+	return (-(err != LR_ACCEPT));
+}
+
+/**
+ * @brief Replay a record on the stack of states.
+ *
+ * The record must be in the state on top of the stack and be its action on
+ * the next token of the input.
+ *
+ * @return 0 on success, -1 if the record does not match the tables.
+ */
+static int	_step(
+				t_test_replay *r,
+				t_lr_trace_record record
+				)
+{
+	static const t_lr_action_type	expected[] = {ACTION_SHIFT,
+		ACTION_REDUCE, ACTION_ACCEPT, ACTION_ERROR};
+	const uint32_t					id = LR_TRACE_ID(record);
+	const t_lr_state_id				top = r->states[r->used - 1];
+	t_lr_action						action;
+
+	action = lr_grammar_action(r->grammar, top, g_input[r->next]);
+	if (record.state != top || action.type != expected[LR_TRACE_TYPE(record)])
+		return (-1);
+	if (action.type == ACTION_SHIFT && id != (uint32_t)g_input[r->next])
+		return (-1);
+	if (action.type == ACTION_SHIFT)
+		r->states[r->used++] = action.data.shift_id;
+	if (action.type == ACTION_SHIFT)
+		++r->next;
+	if (action.type != ACTION_REDUCE)
+		return (0);
+	if (action.data.reduce_id != id
+		|| r->used <= r->grammar->prod_cb[id].size)
+		return (-1);
+	r->used -= r->grammar->prod_cb[id].size;
+	r->states[r->used] = lr_grammar_goto(r->grammar,
+			r->states[r->used - 1], id);
+	++r->used;
+	return (0);
+}
+
+/**
+ * @brief Replay a trace of the input on the tables of a grammar.
+ *
+ * @return 0 if every record matches the tables, in order, down to the
+ *         accept of the whole input, -1 otherwise.
+ */
+static int	_replay(
+				const t_lr_grammar *grammar,
+				const t_lr_trace *trace
+				)
+{
+	t_test_replay	r;
+	size_t			k;
+
+	if (trace->head == 0 || trace->head > trace->mask + 1)
+		return (-1);
+	r = (t_test_replay){.grammar = grammar, .used = 1};
+	k = 0;
+	while (k < trace->head)
+		if (_step(&r, trace->records[k++]) < 0)
+			return (-1);
+	if (LR_TRACE_TYPE(trace->records[k - 1]) != LR_TRACE_ACCEPT
+		|| r.next != TEST_INPUT_COUNT - 1)
+		return (-1);
+	return (0);
+}
+
+/**
+ * @brief Compare the reduction counters of two parses.
+ *
+ * @return 1 if they count the same reductions in every state and by every
+ *         production, 0 otherwise.
+ */
+static int	_same_counts(
+				const t_lr_stats *a,
+				const t_lr_stats *b
+				)
+{
+	return (memcmp(a->state_reductions, b->state_reductions,
+			a->state_count * sizeof(*a->state_reductions)) == 0
+		&& memcmp(a->prod_reductions, b->prod_reductions,
+			a->prod_count * sizeof(*a->prod_reductions)) == 0
+		&& memcmp(a->state_shifts, b->state_shifts,
+			a->state_count * sizeof(*a->state_shifts)) == 0);
+}
+
+/**
+ * @brief Check that a state moves to another by a shift or a goto.
+ *
+ * @return 1 if some transition of from enters to, 0 otherwise.
+ */
+static int	_edge(
+				const t_lr_grammar *grammar,
+				t_lr_state_id from,
+				t_lr_state_id to
+				)
+{
+	t_lr_action	action;
+	size_t		k;
+
+	k = 0;
+	while (k < grammar->token_count)
+	{
+		action = lr_grammar_action(grammar, from, (t_lr_token_id)k++);
+		if (action.type == ACTION_SHIFT && action.data.shift_id == to)
+			return (1);
+	}
+	k = 0;
+	while (k < grammar->prod_count)
+		if (lr_grammar_goto(grammar, from, (t_lr_prod_id)k++) == to)
+			return (1);
+	return (0);
+}
+
+/**
+ * @brief Check that a grammar holds only the chains the input can take.
+ *
+ * Every chain must start with a transition of the automaton, on a token its
+ * top reduces by a unit production, and run two reductions or more. The
+ * table must stay within TEST_CHAIN_COUNT chains and four slots a chain.
+ *
+ * @return 1 if so, 0 otherwise.
+ */
+static int	_small(
+				const t_lr_grammar *grammar
+				)
+{
+	const t_lr_chains	*chains = grammar->chains;
+	const t_lr_chain	*chain;
+	t_lr_action			action;
+	size_t				used;
+	size_t				k;
+
+	if (chains->count > TEST_CHAIN_COUNT
+		|| chains->mask + 1 > 4 * chains->count)
+		return (0);
+	used = 0;
+	k = 0;
+	while (k <= chains->mask)
+	{
+		chain = chains->slots + k++;
+		if (chain->token_id == -1)
+			continue ;
+		action = lr_grammar_action(grammar, chain->top, chain->token_id);
+		if (chain->count < 2 || action.type != ACTION_REDUCE
+			|| action.data.reduce_id != chains->prods[chain->first]
+			|| grammar->prod_cb[action.data.reduce_id].size != 1
+			|| !_edge(grammar, chain->under, chain->top))
+			return (0);
+		++used;
+	}
+	return (used == chains->count);
+}
+
+/**
+ * @brief Report a failed check.
+ *
+ * @return 0 if ok, 1 otherwise.
+ */
+static int	_check(
+				const char *name,
+				int ok
+				)
+{
+	if (!ok)
+		fprintf(stderr, "chain: %s: FAILED\n", name);
+	return (!ok);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Entry point.                                                           * //
+// *                                                                        * //
+// ************************************************************************** //
+
+int	main(void)
+{
+	t_lr_grammar	chained;
+	t_lr_trace		plain;
+	t_lr_trace		chain;
+	t_lr_stats		plain_stats;
+	t_lr_stats		chain_stats;
+	int				status;
+
+	chained = g_grammar;
+	if (lr_chains_build(&chained) != LR_OK
+		|| lr_trace_init(&plain, TEST_TRACE_SIZE, 0, NULL) != LR_OK
+		|| lr_trace_init(&chain, TEST_TRACE_SIZE, 0, NULL) != LR_OK
+		|| lr_stats_init(&plain_stats, EXPR_STATE_COUNT, EXPR_PROD_COUNT,
+			NULL) != LR_OK
+		|| lr_stats_init(&chain_stats, EXPR_STATE_COUNT, EXPR_PROD_COUNT,
+			NULL) != LR_OK)
+		return (_check("init", 0));
+	status = _check("chains built", chained.chains != NULL);
+	if (status == 0)
+		status = _check("chains reachable and bounded", _small(&chained));
+	status |= _check("parse", _parse(&g_grammar, &plain, &plain_stats) == 0);
+	status |= _check("parse with chains",
+			_parse(&chained, &chain, &chain_stats) == 0);
+	status |= _check("replay", _replay(&g_grammar, &plain) == 0);
+	status |= _check("replay with chains", _replay(&chained, &chain) == 0);
+	status |= _check("same records", plain.head == chain.head
+			&& memcmp(plain.records, chain.records,
+				plain.head * sizeof(*plain.records)) == 0);
+	status |= _check("same counters", _same_counts(&plain_stats, &chain_stats));
+	lr_stats_destroy(&plain_stats);
+	lr_stats_destroy(&chain_stats);
+	lr_trace_destroy(&plain);
+	lr_trace_destroy(&chain);
+	lr_chains_destroy(&chained);
+	return (status);
+}
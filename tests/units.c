@@ -0,0 +1,279 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   units.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 10:04:17 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/18 10:04:17 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file units.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief What callbacks see once unit productions are bypassed.
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdio.h>
+#include <string.h>
+
+#include "expr_tables.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Defines.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Items the callbacks of a parse may see.
+ */
+#define TEST_LOG_SIZE	64
+
+/**
+ * @brief Number of tokens of the input, the end of input included.
+ */
+#define TEST_INPUT_COUNT	16
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Items seen by the callbacks of a parse, in order.
+ */
+typedef struct s_test_log
+{
+	const void	*seen[TEST_LOG_SIZE];	/**< Derived values, g_token for tokens. */
+	size_t		count;					/**< Items seen. */
+}	t_test_log;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Grammar.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Values derived by the callbacks, one per callback.
+ */
+static int	g_values[5];
+
+/**
+ * @brief Marker of a token item in the log.
+ */
+static int	g_token;
+
+/**
+ * @brief Log an item seen by a callback.
+ */
+static void	_see(
+				t_lr_parser_ctx *ctx,
+				const t_lr_stack_item *item
+				)
+{
+	t_test_log	*log = ctx->usrptr;
+
+	if (log->count == TEST_LOG_SIZE)
+		return ;
+	if (item->type == ITEM_DERIVED)
+		log->seen[log->count++] = item->data.derived.data;
+	else
+		log->seen[log->count++] = &g_token;
+}
+
+/**
+ * @brief expr : expr PLUS term and term : term STAR unary.
+ */
+static void	*_binary(
+				t_lr_stack_item *items,
+				t_lr_parser_ctx *ctx
+				)
+{
+	_see(ctx, items);
+	_see(ctx, items + 2);
+	return (g_values);
+}
+
+/**
+ * @brief expr : term.
+ */
+static void	*_unit(
+				t_lr_stack_item *items,
+				t_lr_parser_ctx *ctx
+				)
+{
+	_see(ctx, items);
+	return (g_values + 1);
+}
+
+/**
+ * @brief unary : MINUS unary and atom : LPAREN expr RPAREN.
+ */
+static void	*_inner(
+				t_lr_stack_item *items,
+				t_lr_parser_ctx *ctx
+				)
+{
+	_see(ctx, items + 1);
+	return (g_values + 2);
+}
+
+/**
+ * @brief atom : NUM.
+ */
+static void	*_num(
+				t_lr_stack_item *items,
+				t_lr_parser_ctx *ctx
+				)
+{
+	_see(ctx, items);
+	return (g_values + 3);
+}
+
+static const t_lr_prod_cb	g_prods[EXPR_PROD_COUNT] = {
+	EXPR_PROD(EXPR_0, _binary, NULL),
+	EXPR_PROD(EXPR_1, _unit, NULL),
+	EXPR_PROD(TERM_0, _binary, NULL),
+	EXPR_PROD(TERM_1, NULL, NULL),
+	EXPR_PROD(UNARY_0, _inner, NULL),
+	EXPR_PROD(UNARY_1, NULL, NULL),
+	EXPR_PROD(ATOM_0, _inner, NULL),
+	EXPR_PROD(ATOM_1, _num, NULL),
+};
+
+static const t_lr_grammar	g_grammar = {EXPR_TABLES, .prod_cb = g_prods};
+
+/**
+ * @brief 1 + 2 * 3 + -(4 + -5) * 6
+ */
+static const t_lr_token_id	g_input[TEST_INPUT_COUNT] = {
+	EXPR_TOK_NUM, EXPR_TOK_PLUS, EXPR_TOK_NUM, EXPR_TOK_STAR, EXPR_TOK_NUM,
+	EXPR_TOK_PLUS, EXPR_TOK_MINUS, EXPR_TOK_LPAREN, EXPR_TOK_NUM,
+	EXPR_TOK_PLUS, EXPR_TOK_MINUS, EXPR_TOK_NUM, EXPR_TOK_RPAREN,
+	EXPR_TOK_STAR, EXPR_TOK_NUM, EXPR_TOK_END,
+};
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Checks.                                                                * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Parse the input, logging what the callbacks see.
+ *
+ * @return The number of reductions, 0 if the input is not accepted.
+ */
+static uint64_t	_parse(
+					const t_lr_grammar *grammar,
+					t_test_log *log
+					)
+{
+	t_lr_parser_ctx	ctx;
+	t_lr_token		tokens[TEST_INPUT_COUNT];
+	t_lr_stats		stats;
+	void			*derived;
+	size_t			consumed;
+	uint64_t		reductions;
+	int				accepted;
+	size_t			k;
+
+	k = 0;
+	while (k < TEST_INPUT_COUNT)
+	{
+		tokens[k] = (t_lr_token){.id = g_input[k]};
+		++k;
+	}
+	*log = (t_test_log){0};
+	if (lr_stats_init(&stats, EXPR_STATE_COUNT, EXPR_PROD_COUNT, NULL)
+		!= LR_OK)
+		return (0);
+	accepted = 0;
+	if (lr_parser_init(&ctx, grammar, log) == LR_OK)
+	{
+		lr_parser_set_tokens(&ctx, tokens, TEST_INPUT_COUNT);
+		accepted = lr_parser_exec_n(&ctx, tokens, TEST_INPUT_COUNT, &derived,
+				&consumed) == LR_ACCEPT
+			&& lr_parser_stats(&ctx, &stats) == LR_OK;
+		lr_parser_destroy(&ctx);
+	}
+	reductions = 0;
+	k = 0;
+	while (accepted && k < EXPR_PROD_COUNT)
+		reductions += stats.prod_reductions[k++];
+	lr_stats_destroy(&stats);
+	return (reductions);
+}
+
+/**
+ * @brief Tell whether two parses saw the same items.
+ */
+static int	_same_log(
+				const t_test_log *a,
+				const t_test_log *b
+				)
+{
+	return (a->count == b->count
+		&& memcmp(a->seen, b->seen, a->count * sizeof(*a->seen)) == 0);
+}
+
+/**
+ * @brief Report a failed check.
+ *
+ * @return 0 if ok, 1 otherwise.
+ */
+static int	_check(
+				const char *name,
+				int ok
+				)
+{
+	if (!ok)
+		fprintf(stderr, "units: %s: FAILED\n", name);
+	return (!ok);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Entry point.                                                           * //
+// *                                                                        * //
+// ************************************************************************** //
+
+int	main(void)
+{
+	t_lr_grammar	keep;
+	t_lr_grammar	all;
+	t_test_log		logs[3];
+	uint64_t		reductions[3];
+	int				status;
+
+	keep = g_grammar;
+	all = g_grammar;
+	if (lr_units_build(&keep, 0) != LR_OK
+		|| lr_units_build(&all, LR_UNITS_BYPASS_ALL) != LR_OK)
+		return (_check("build", 0));
+	reductions[0] = _parse(&g_grammar, logs);
+	reductions[1] = _parse(&keep, logs + 1);
+	reductions[2] = _parse(&all, logs + 2);
+	status = _check("parse", reductions[0] != 0 && reductions[1] != 0
+			&& reductions[2] != 0);
+	status |= _check("keep values", _same_log(logs, logs + 1));
+	status |= _check("keep values bypass", reductions[1] < reductions[0]);
+	status |= _check("bypass changes values", !_same_log(logs, logs + 2));
+	status |= _check("bypass all", reductions[2] < reductions[1]);
+	lr_units_destroy(&keep);
+	lr_units_destroy(&all);
+	return (status);
+}
@@ -0,0 +1,149 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   arith.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:47:52 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 22:47:52 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file arith.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Arithmetic expression reference language.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include "bench.h"
+#include "arith_tables.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Grammar.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+static const t_lr_prod_cb	g_prods[ARITH_PROD_COUNT] = {
+	ARITH_PROD(EXPR_0, bench_reduce, NULL),
+	ARITH_PROD(EXPR_1, bench_reduce, NULL),
+	ARITH_PROD(EXPR_2, bench_reduce, NULL),
+	ARITH_PROD(TERM_0, bench_reduce, NULL),
+	ARITH_PROD(TERM_1, bench_reduce, NULL),
+	ARITH_PROD(TERM_2, bench_reduce, NULL),
+	ARITH_PROD(FACTOR_0, bench_reduce, NULL),
+	ARITH_PROD(FACTOR_1, bench_reduce, NULL),
+	ARITH_PROD(FACTOR_2, bench_reduce, NULL),
+};
+
+static const t_lr_grammar	g_grammar = {ARITH_TABLES, .prod_cb = g_prods};
+
+static const t_lr_token_id	g_add[] = {ARITH_TOK_PLUS, ARITH_TOK_MINUS};
+static const t_lr_token_id	g_mul[] = {ARITH_TOK_STAR, ARITH_TOK_SLASH};
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Generator.                                                             * //
+// *                                                                        * //
+// ************************************************************************** //
+
+static void	_expr(
+				t_bench_doc *doc,
+				int depth
+				);
+
+/**
+ * @brief Generate a factor, parentheses nest at most 8 deep.
+ */
+static void	_factor(
+				t_bench_doc *doc,
+				int depth
+				)
+{
+	size_t	r;
+
+	r = bench_rand(doc, 8);
+	while (r == 1)
+	{
+		bench_push(doc, ARITH_TOK_MINUS);
+		r = bench_rand(doc, 8);
+	}
+	if (r == 0 && depth < 8)
+	{
+		bench_push(doc, ARITH_TOK_LPAREN);
+		_expr(doc, depth + 1);
+		bench_push(doc, ARITH_TOK_RPAREN);
+	}
+	else
+		bench_push(doc, ARITH_TOK_NUM);
+}
+
+/**
+ * @brief Generate a term.
+ */
+static void	_term(
+				t_bench_doc *doc,
+				int depth
+				)
+{
+	_factor(doc, depth);
+	while (bench_rand(doc, 3) == 0)
+	{
+		bench_push(doc, g_mul[bench_rand(doc, 2)]);
+		_factor(doc, depth);
+	}
+}
+
+/**
+ * @brief Generate an expression.
+ */
+static void	_expr(
+				t_bench_doc *doc,
+				int depth
+				)
+{
+	_term(doc, depth);
+	while (bench_rand(doc, 2) == 0)
+	{
+		bench_push(doc, g_add[bench_rand(doc, 2)]);
+		_term(doc, depth);
+	}
+}
+
+/**
+ * @brief Generate a sum of terms of about tokens tokens.
+ */
+static void	_gen(
+				t_bench_doc *doc,
+				size_t tokens
+				)
+{
+	_term(doc, 0);
+	while (doc->count < tokens)
+	{
+		bench_push(doc, g_add[bench_rand(doc, 2)]);
+		_term(doc, 0);
+	}
+	bench_push(doc, ARITH_TOK_END);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Global variables.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+const t_bench_lang	g_bench_arith = {
+	.name = "arith",
+	.grammar = &g_grammar,
+	.gen = _gen,
+};
@@ -0,0 +1,158 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench.h                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:41:07 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 22:41:07 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file bench.h
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief The parser benchmark definition.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef BENCH_H
+# define BENCH_H
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+# include <stddef.h>
+# include <stdint.h>
+
+# include "lr_parser.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Token document being generated.
+ */
+typedef struct s_bench_doc
+{
+	t_lr_token	*tokens;	/**< Tokens, END included once complete. */
+	size_t		count;		/**< Number of tokens. */
+	size_t		alloced;	/**< Allocated capacity. */
+	uint64_t	rng;		/**< State of the random generator. */
+}	t_bench_doc;
+
+/**
+ * @brief Reference language of the benchmark.
+ */
+typedef struct s_bench_lang
+{
+	const char			*name;		/**< Name of the language. */
+	const t_lr_grammar	*grammar;	/**< Grammar with counting callbacks. */
+	void				(*gen)(t_bench_doc *doc, size_t tokens);	/**< Generate a document. */
+}	t_bench_lang;
+
+/**
+ * @brief Counters of a parse, reached through the user pointer.
+ */
+typedef struct s_bench_parse
+{
+	uint64_t	reductions;		/**< Reductions. */
+	size_t		depth;			/**< Peak stack depth. */
+	uint64_t	allocs;			/**< Allocations of the allocator. */
+	uint64_t	reallocs;		/**< Reallocations of the allocator. */
+}	t_bench_parse;
+
+/**
+ * @brief Benchmark options.
+ */
+typedef struct s_bench_opts
+{
+	const char	*lang;			/**< Only language to run, or NULL. */
+	size_t		sizes[16];		/**< Corpus sizes in bytes of tokens. */
+	size_t		size_count;		/**< Number of corpus sizes. */
+	size_t		doc_tokens;		/**< Tokens of a document. */
+	size_t		capacity;		/**< Initial stack capacity. */
+	uint64_t	seed;			/**< Seed of the corpora. */
+	size_t		trace_records;	/**< Records of the trace ring, or 0. */
+	int			trace_flags;	/**< Flags of the trace ring. */
+	const char	*trace_path;	/**< File to save the trace to, or NULL. */
+	t_lr_trace	*trace;			/**< Trace of every parse, or NULL. */
+}	t_bench_opts;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Global variables.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+extern const t_bench_lang	g_bench_arith;
+extern const t_bench_lang	g_bench_json;
+extern const t_bench_lang	g_bench_stmt;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Function prototypes.                                                   * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Draw a random number.
+ *
+ * @param doc Document holding the generator state.
+ * @param n Bound, non zero.
+ * @return A number in [0, n).
+ */
+size_t	bench_rand(
+			t_bench_doc *doc,
+			size_t n
+			);
+
+/**
+ * @brief Append a token to a document, exits on allocation failure.
+ *
+ * @param doc Document.
+ * @param id Token ID.
+ */
+void	bench_push(
+			t_bench_doc *doc,
+			t_lr_token_id id
+			);
+
+/**
+ * @brief Production callback of the reference grammars.
+ *
+ * Counts the reduction and the stack depth in the t_bench_parse of the
+ * user pointer. The peak depth is always reached right before a reduction.
+ *
+ * @param items Right hand side items.
+ * @param ctx Parser context.
+ * @return A non NULL dummy value.
+ */
+void	*bench_reduce(
+			t_lr_stack_item *items,
+			t_lr_parser_ctx *ctx
+			);
+
+/**
+ * @brief Run a language over a corpus and print the report.
+ *
+ * @param lang Language.
+ * @param opts Options.
+ * @param size Corpus size in bytes of tokens.
+ * @return 0 on success, -1 if a document is rejected.
+ */
+int		bench_run(
+			const t_bench_lang *lang,
+			const t_bench_opts *opts,
+			size_t size
+			);
+
+#endif
@@ -0,0 +1,82 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   corpus.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:44:19 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 22:44:19 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file corpus.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Token corpus generation helpers.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Draw a random number with xorshift64*.
+ *
+ * @param doc Document holding the generator state.
+ * @param n Bound, non zero.
+ * @return A number in [0, n).
+ */
+size_t	bench_rand(
+			t_bench_doc *doc,
+			size_t n
+			)
+{
+	doc->rng ^= doc->rng >> 12;
+	doc->rng ^= doc->rng << 25;
+	doc->rng ^= doc->rng >> 27;
+	return (((doc->rng * 0x2545f4914f6cdd1du) >> 32) % n);
+}
+
+/**
+ * @brief Append a token to a document, exits on allocation failure.
+ *
+ * @param doc Document.
+ * @param id Token ID.
+ */
+void	bench_push(
+			t_bench_doc *doc,
+			t_lr_token_id id
+			)
+{
+	t_lr_token	*tokens;
+
+	if (doc->count == doc->alloced)
+	{
+		tokens = realloc(doc->tokens, (doc->alloced * 2 + 64)
+				* sizeof(*tokens));
+		if (tokens == NULL)
+		{
+			perror("mp-bench");
+			exit(EXIT_FAILURE);
+		}
+		doc->tokens = tokens;
+		doc->alloced = doc->alloced * 2 + 64;
+	}
+	doc->tokens[doc->count++] = (t_lr_token){.id = id};
+}
@@ -0,0 +1,164 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   json.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:53:30 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 22:53:30 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file json.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief JSON reference language.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include "bench.h"
+#include "json_tables.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Grammar.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+static const t_lr_prod_cb	g_prods[JSON_PROD_COUNT] = {
+	JSON_PROD(VALUE_0, bench_reduce, NULL),
+	JSON_PROD(VALUE_1, bench_reduce, NULL),
+	JSON_PROD(VALUE_2, bench_reduce, NULL),
+	JSON_PROD(VALUE_3, bench_reduce, NULL),
+	JSON_PROD(VALUE_4, bench_reduce, NULL),
+	JSON_PROD(VALUE_5, bench_reduce, NULL),
+	JSON_PROD(VALUE_6, bench_reduce, NULL),
+	JSON_PROD(OBJECT_0, bench_reduce, NULL),
+	JSON_PROD(OBJECT_1, bench_reduce, NULL),
+	JSON_PROD(MEMBERS_0, bench_reduce, NULL),
+	JSON_PROD(MEMBERS_1, bench_reduce, NULL),
+	JSON_PROD(PAIR_0, bench_reduce, NULL),
+	JSON_PROD(ARRAY_0, bench_reduce, NULL),
+	JSON_PROD(ARRAY_1, bench_reduce, NULL),
+	JSON_PROD(ELEMENTS_0, bench_reduce, NULL),
+	JSON_PROD(ELEMENTS_1, bench_reduce, NULL),
+};
+
+static const t_lr_grammar	g_grammar = {JSON_TABLES, .prod_cb = g_prods};
+
+static const t_lr_token_id	g_scalars[] = {JSON_TOK_STRING, JSON_TOK_NUMBER,
+	JSON_TOK_STRING, JSON_TOK_NUMBER, JSON_TOK_TRUE, JSON_TOK_FALSE,
+	JSON_TOK_NULL};
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Generator.                                                             * //
+// *                                                                        * //
+// ************************************************************************** //
+
+static void	_value(
+				t_bench_doc *doc,
+				int depth
+				);
+
+/**
+ * @brief Generate an object of up to 6 members.
+ */
+static void	_object(
+				t_bench_doc *doc,
+				int depth
+				)
+{
+	size_t	n;
+
+	bench_push(doc, JSON_TOK_LBRACE);
+	n = bench_rand(doc, 7);
+	while (n != 0)
+	{
+		bench_push(doc, JSON_TOK_STRING);
+		bench_push(doc, JSON_TOK_COLON);
+		_value(doc, depth + 1);
+		if (--n != 0)
+			bench_push(doc, JSON_TOK_COMMA);
+	}
+	bench_push(doc, JSON_TOK_RBRACE);
+}
+
+/**
+ * @brief Generate an array of up to 8 elements.
+ */
+static void	_array(
+				t_bench_doc *doc,
+				int depth
+				)
+{
+	size_t	n;
+
+	bench_push(doc, JSON_TOK_LBRACKET);
+	n = bench_rand(doc, 9);
+	while (n != 0)
+	{
+		_value(doc, depth + 1);
+		if (--n != 0)
+			bench_push(doc, JSON_TOK_COMMA);
+	}
+	bench_push(doc, JSON_TOK_RBRACKET);
+}
+
+/**
+ * @brief Generate a value, containers nest at most 6 deep.
+ */
+static void	_value(
+				t_bench_doc *doc,
+				int depth
+				)
+{
+	size_t	r;
+
+	r = bench_rand(doc, 10);
+	if (r == 0 && depth < 6)
+		_object(doc, depth);
+	else if (r == 1 && depth < 6)
+		_array(doc, depth);
+	else
+		bench_push(doc, g_scalars[bench_rand(doc, 7)]);
+}
+
+/**
+ * @brief Generate an array of records of about tokens tokens.
+ */
+static void	_gen(
+				t_bench_doc *doc,
+				size_t tokens
+				)
+{
+	bench_push(doc, JSON_TOK_LBRACKET);
+	_object(doc, 1);
+	while (doc->count < tokens)
+	{
+		bench_push(doc, JSON_TOK_COMMA);
+		_object(doc, 1);
+	}
+	bench_push(doc, JSON_TOK_RBRACKET);
+	bench_push(doc, JSON_TOK_END);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Global variables.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+const t_bench_lang	g_bench_json = {
+	.name = "json",
+	.grammar = &g_grammar,
+	.gen = _gen,
+};
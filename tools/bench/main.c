@@ -0,0 +1,212 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   main.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:15:02 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 23:15:02 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file main.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief mp-bench entry point.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Options.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Print the usage and exit.
+ */
+static void	_usage(
+				int status
+				)
+{
+	fprintf(stderr,
+		"Usage: mp-bench [OPTION]...\n"
+		"Benchmark the parser on generated corpora of reference grammars.\n"
+		"  -g NAME    only run the NAME grammar: arith, json or stmt\n"
+		"  -c SIZE    corpus size in bytes of tokens, with an optional K, M\n"
+		"             or G suffix (repeatable, default: 64K and 4M)\n"
+		"  -d TOKENS  tokens of a parsed document (default: 4096)\n"
+		"  -k ITEMS   initial stack capacity of a parse (default: 1)\n"
+		"  -s SEED    seed of the corpora (default: 1)\n"
+		"  -t RECORDS trace every parse in a ring of RECORDS records\n"
+		"             (MP_TRACE builds)\n"
+		"  -S         timestamp the trace records\n"
+		"  -T FILE    save the trace to FILE, for mp-gen --replay\n");
+	exit(status);
+}
+
+/**
+ * @brief Parse a number with an optional K, M or G suffix.
+ *
+ * @return The number, 0 if invalid.
+ */
+static size_t	_size(
+					const char *s
+					)
+{
+	char	*end;
+	size_t	n;
+
+	n = strtoull(s, &end, 10);
+	if (*end == 'K' || *end == 'k')
+		n <<= 10;
+	else if (*end == 'M' || *end == 'm')
+		n <<= 20;
+	else if (*end == 'G' || *end == 'g')
+		n <<= 30;
+	else if (*end != '\0')
+		return (0);
+	if (*end != '\0' && end[1] != '\0')
+		return (0);
+	return (n);
+}
+
+/**
+ * @brief Parse the command line.
+ */
+static void	_opts(
+				t_bench_opts *opts,
+				int argc,
+				char **argv
+				)
+{
+	int	k;
+
+	k = 1;
+	while (k < argc)
+	{
+		if (strcmp(argv[k], "-g") == 0 && k + 1 < argc)
+			opts->lang = argv[++k];
+		else if (strcmp(argv[k], "-c") == 0 && k + 1 < argc
+			&& opts->size_count < 16)
+			opts->sizes[opts->size_count++] = _size(argv[++k]);
+		else if (strcmp(argv[k], "-d") == 0 && k + 1 < argc)
+			opts->doc_tokens = _size(argv[++k]);
+		else if (strcmp(argv[k], "-k") == 0 && k + 1 < argc)
+			opts->capacity = _size(argv[++k]);
+		else if (strcmp(argv[k], "-s") == 0 && k + 1 < argc)
+			opts->seed = _size(argv[++k]);
+		else if (strcmp(argv[k], "-t") == 0 && k + 1 < argc)
+			opts->trace_records = _size(argv[++k]);
+		else if (strcmp(argv[k], "-S") == 0)
+			opts->trace_flags = LR_TRACE_TSC;
+		else if (strcmp(argv[k], "-T") == 0 && k + 1 < argc)
+			opts->trace_path = argv[++k];
+		else if (strcmp(argv[k], "-h") == 0)
+			_usage(EXIT_SUCCESS);
+		else
+			_usage(EXIT_FAILURE);
+		++k;
+	}
+	if (opts->size_count == 0)
+	{
+		opts->sizes[opts->size_count++] = 64 << 10;
+		opts->sizes[opts->size_count++] = 4 << 20;
+	}
+	k = 0;
+	while ((size_t)k < opts->size_count)
+		if (opts->sizes[k++] == 0)
+			_usage(EXIT_FAILURE);
+	if (opts->doc_tokens == 0 || opts->capacity == 0
+		|| (opts->trace_path != NULL && opts->trace_records == 0))
+		_usage(EXIT_FAILURE);
+}
+
+/**
+ * @brief Run the selected languages over every corpus size.
+ *
+ * @return The number of languages run, or -1 if a document is rejected.
+ */
+static long	_run(
+				const t_bench_opts *opts
+				)
+{
+	const t_bench_lang	*langs[] = {&g_bench_arith, &g_bench_json,
+		&g_bench_stmt, NULL};
+	size_t				k;
+	size_t				s;
+	long				ran;
+	int					failed;
+
+	failed = 0;
+	ran = 0;
+	k = 0;
+	while (langs[k] != NULL)
+	{
+		s = 0;
+		if (opts->lang != NULL && strcmp(opts->lang, langs[k]->name) != 0)
+			s = opts->size_count;
+		else
+			++ran;
+		while (s < opts->size_count)
+			if (bench_run(langs[k], opts, opts->sizes[s++]) < 0)
+				failed = 1;
+		++k;
+	}
+	if (failed)
+		return (-1);
+	return (ran);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Entry point.                                                           * //
+// *                                                                        * //
+// ************************************************************************** //
+
+int	main(
+		int argc,
+		char **argv
+		)
+{
+	t_bench_opts		opts;
+	t_lr_trace			trace;
+	long				ran;
+
+	opts = (t_bench_opts){.doc_tokens = 4096, .capacity = 1, .seed = 1};
+	_opts(&opts, argc, argv);
+	if (opts.trace_records != 0 && lr_trace_init(&trace, opts.trace_records,
+			opts.trace_flags, NULL) != LR_OK)
+		return (perror("mp-bench"), EXIT_FAILURE);
+	if (opts.trace_records != 0)
+		opts.trace = &trace;
+	ran = _run(&opts);
+	if (ran != 0 && opts.trace_path != NULL
+		&& lr_trace_save(&trace, opts.trace_path) != LR_OK)
+	{
+		fprintf(stderr, "mp-bench: %s: cannot write the trace\n",
+			opts.trace_path);
+		ran = -1;
+	}
+	if (opts.trace != NULL)
+		lr_trace_destroy(&trace);
+	if (ran == 0)
+		_usage(EXIT_FAILURE);
+	if (ran < 0)
+		return (EXIT_FAILURE);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,343 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   run.c                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:06:40 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 23:06:40 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file run.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Timed parses of a corpus and their report.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Defines.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Documents needed before percentiles of their costs are printed.
+ */
+#define BENCH_PERCENTILE_DOCS	1000
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Totals of the parses of a corpus.
+ */
+typedef struct s_bench_totals
+{
+	double		*ns_token;		/**< Nanoseconds per token of each parse. */
+	size_t		docs;			/**< Number of parses. */
+	size_t		alloced;		/**< Allocated capacity of ns_token. */
+	uint64_t	tokens;			/**< Tokens, END included. */
+	uint64_t	init;			/**< Nanoseconds spent in init. */
+	uint64_t	exec;			/**< Nanoseconds spent in exec. */
+	uint64_t	destroy;		/**< Nanoseconds spent in destroy. */
+	uint64_t	reductions;		/**< Reductions. */
+	size_t		depth;			/**< Peak stack depth. */
+	uint64_t	allocs;			/**< Allocations. */
+	uint64_t	reallocs;		/**< Reallocations. */
+}	t_bench_totals;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Counting allocator.                                                    * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Count an allocation of the parser.
+ */
+static void	*_alloc(
+				void *state,
+				size_t size
+				)
+{
+	++((t_bench_parse *)state)->allocs;
+	return (malloc(size));
+}
+
+/**
+ * @brief Count a reallocation of the parser.
+ */
+static void	*_realloc(
+				void *state,
+				void *ptr,
+				size_t oldsize,
+				size_t newsize
+				)
+{
+	(void)oldsize;
+	++((t_bench_parse *)state)->reallocs;
+	return (realloc(ptr, newsize));
+}
+
+/**
+ * @brief Free a block of the parser.
+ */
+static void	_free(
+				void *state,
+				void *ptr,
+				size_t size
+				)
+{
+	(void)state;
+	(void)size;
+	free(ptr);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Read the monotonic clock.
+ *
+ * @return Nanoseconds.
+ */
+static uint64_t	_now(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
+
+/**
+ * @brief Order two samples.
+ */
+static int	_sample_cmp(
+				const void *a,
+				const void *b
+				)
+{
+	return ((*(const double *)a > *(const double *)b)
+		- (*(const double *)a < *(const double *)b));
+}
+
+/**
+ * @brief Add the counters of a parse to the totals, exits on allocation
+ *        failure.
+ */
+static void	_add(
+				t_bench_totals *tot,
+				const t_bench_parse *p,
+				const uint64_t t[4],
+				size_t tokens
+				)
+{
+	double	*samples;
+
+	if (tot->docs == tot->alloced)
+	{
+		samples = realloc(tot->ns_token, (tot->alloced * 2 + 64)
+				* sizeof(*samples));
+		if (samples == NULL)
+		{
+			perror("mp-bench");
+			exit(EXIT_FAILURE);
+		}
+		tot->ns_token = samples;
+		tot->alloced = tot->alloced * 2 + 64;
+	}
+	tot->ns_token[tot->docs++] = (double)(t[3] - t[0]) / tokens;
+	tot->tokens += tokens;
+	tot->init += t[1] - t[0];
+	tot->exec += t[2] - t[1];
+	tot->destroy += t[3] - t[2];
+	tot->reductions += p->reductions;
+	if (p->depth > tot->depth)
+		tot->depth = p->depth;
+	tot->allocs += p->allocs;
+	tot->reallocs += p->reallocs;
+}
+
+/**
+ * @brief Time the init, exec and destroy of the parse of a document.
+ *
+ * @return 0 on success, -1 if the document is rejected.
+ */
+static int	_parse(
+				const t_bench_lang *lang,
+				const t_bench_opts *opts,
+				const t_bench_doc *doc,
+				t_bench_totals *tot
+				)
+{
+	t_lr_parser		ctx;
+	t_bench_parse	p;
+	t_lr_allocator	allocator;
+	uint64_t		t[4];
+	t_lr_error		err;
+	void			*derived;
+	size_t			consumed;
+
+	p = (t_bench_parse){0};
+	allocator = (t_lr_allocator){_alloc, _realloc, _free, &p};
+	t[0] = _now();
+	err = lr_parser_init_allocator(&ctx, lang->grammar, &p, &allocator,
+			opts->capacity);
+	if (err != LR_OK)
+		return (-1);
+	lr_parser_set_tokens(&ctx, doc->tokens, doc->count);
+	lr_parser_set_trace(&ctx, opts->trace);
+	t[1] = _now();
+	err = lr_parser_exec_n(&ctx, doc->tokens, doc->count, &derived,
+			&consumed);
+	t[2] = _now();
+	lr_parser_destroy(&ctx);
+	t[3] = _now();
+	if (err != LR_ACCEPT)
+		return (-1);
+	_add(tot, &p, t, doc->count);
+	return (0);
+}
+
+/**
+ * @brief Print the report of a corpus.
+ *
+ * The percentiles are over the cost per token of each document, so they
+ * are only printed with BENCH_PERCENTILE_DOCS documents or more.
+ */
+static void	_report(
+				const t_bench_lang *lang,
+				size_t size,
+				t_bench_totals *tot
+				)
+{
+	static const char	*units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+	const double		ns = tot->init + tot->exec + tot->destroy;
+	const double		n = tot->docs;
+	double				shown;
+	size_t				unit;
+
+	shown = size;
+	unit = 0;
+	while (shown >= 1024 && unit < 4)
+	{
+		shown /= 1024;
+		++unit;
+	}
+	qsort(tot->ns_token, tot->docs, sizeof(*tot->ns_token), _sample_cmp);
+	printf("%s %.1f %s: %llu tokens in %zu parses\n"
+		"  %.2f Mtokens/s, %.2f Mreductions/s\n",
+		lang->name, shown, units[unit], (unsigned long long)tot->tokens,
+		tot->docs, tot->tokens * 1e3 / ns, tot->reductions * 1e3 / ns);
+	if (tot->docs >= BENCH_PERCENTILE_DOCS)
+		printf("  ns/token per document  p50 %.2f  p90 %.2f  p99 %.2f  "
+			"max %.2f\n", tot->ns_token[(tot->docs - 1) / 2],
+			tot->ns_token[(tot->docs - 1) * 9 / 10],
+			tot->ns_token[(tot->docs - 1) * 99 / 100],
+			tot->ns_token[tot->docs - 1]);
+	else
+		printf("  ns/token per document  no percentiles under %d "
+			"documents, lower -d\n", BENCH_PERCENTILE_DOCS);
+	printf("  ns/parse  init %.0f  exec %.0f  destroy %.0f\n"
+		"  per parse peak depth %zu, %.2f allocations, %.2f reallocations\n",
+		tot->init / n, tot->exec / n, tot->destroy / n,
+		tot->depth, tot->allocs / n, tot->reallocs / n);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Production callback of the reference grammars.
+ *
+ * Counts the reduction and the stack depth in the t_bench_parse of the
+ * user pointer. The peak depth is always reached right before a reduction.
+ *
+ * @param items Right hand side items.
+ * @param ctx Parser context.
+ * @return A non NULL dummy value.
+ */
+void	*bench_reduce(
+			t_lr_stack_item *items,
+			t_lr_parser_ctx *ctx
+			)
+{
+	t_bench_parse	*p;
+
+	(void)items;
+	p = ctx->usrptr;
+	++p->reductions;
+	if (ctx->stack.used > p->depth)
+		p->depth = ctx->stack.used;
+	return (p);
+}
+
+/**
+ * @brief Run a language over a corpus and print the report.
+ *
+ * The corpus is generated a document at a time and each document is
+ * parsed by its own context, so corpora far larger than memory run in the
+ * space of one document. Only the parses are timed.
+ *
+ * @param lang Language.
+ * @param opts Options.
+ * @param size Corpus size in bytes of tokens.
+ * @return 0 on success, -1 if a document is rejected.
+ */
+int	bench_run(
+		const t_bench_lang *lang,
+		const t_bench_opts *opts,
+		size_t size
+		)
+{
+	const uint64_t	target = size / sizeof(t_lr_token);
+	t_bench_doc		doc;
+	t_bench_totals	tot;
+	int				ret;
+
+	doc = (t_bench_doc){.rng = opts->seed ^ 0x9e3779b97f4a7c15u};
+	tot = (t_bench_totals){0};
+	ret = 0;
+	while (ret == 0 && (tot.docs == 0 || tot.tokens < target))
+	{
+		doc.count = 0;
+		if (target - tot.tokens < opts->doc_tokens && tot.tokens < target)
+			lang->gen(&doc, target - tot.tokens);
+		else
+			lang->gen(&doc, opts->doc_tokens);
+		ret = _parse(lang, opts, &doc, &tot);
+	}
+	if (ret == 0)
+		_report(lang, size, &tot);
+	else
+		fprintf(stderr, "mp-bench: %s: document %zu rejected\n",
+			lang->name, tot.docs);
+	free(doc.tokens);
+	free(tot.ns_token);
+	return (ret);
+}
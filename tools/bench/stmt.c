@@ -0,0 +1,317 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stmt.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:58:14 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 22:58:14 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file stmt.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief C-like statement reference language.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include "bench.h"
+#include "stmt_tables.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Grammar.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+static const t_lr_prod_cb	g_prods[STMT_PROD_COUNT] = {
+	STMT_PROD(PROGRAM_0, bench_reduce, NULL),
+	STMT_PROD(STMTS_0, bench_reduce, NULL),
+	STMT_PROD(STMTS_1, bench_reduce, NULL),
+	STMT_PROD(STMT_0, bench_reduce, NULL),
+	STMT_PROD(STMT_1, bench_reduce, NULL),
+	STMT_PROD(STMT_2, bench_reduce, NULL),
+	STMT_PROD(STMT_3, bench_reduce, NULL),
+	STMT_PROD(STMT_4, bench_reduce, NULL),
+	STMT_PROD(STMT_5, bench_reduce, NULL),
+	STMT_PROD(STMT_6, bench_reduce, NULL),
+	STMT_PROD(BLOCK_0, bench_reduce, NULL),
+	STMT_PROD(BLOCK_1, bench_reduce, NULL),
+	STMT_PROD(EXPR_0, bench_reduce, NULL),
+	STMT_PROD(EXPR_1, bench_reduce, NULL),
+	STMT_PROD(CMP_0, bench_reduce, NULL),
+	STMT_PROD(CMP_1, bench_reduce, NULL),
+	STMT_PROD(CMP_2, bench_reduce, NULL),
+	STMT_PROD(SUM_0, bench_reduce, NULL),
+	STMT_PROD(SUM_1, bench_reduce, NULL),
+	STMT_PROD(SUM_2, bench_reduce, NULL),
+	STMT_PROD(PROD_0, bench_reduce, NULL),
+	STMT_PROD(PROD_1, bench_reduce, NULL),
+	STMT_PROD(PROD_2, bench_reduce, NULL),
+	STMT_PROD(UNARY_0, bench_reduce, NULL),
+	STMT_PROD(UNARY_1, bench_reduce, NULL),
+	STMT_PROD(PRIMARY_0, bench_reduce, NULL),
+	STMT_PROD(PRIMARY_1, bench_reduce, NULL),
+	STMT_PROD(PRIMARY_2, bench_reduce, NULL),
+	STMT_PROD(PRIMARY_3, bench_reduce, NULL),
+	STMT_PROD(PRIMARY_4, bench_reduce, NULL),
+	STMT_PROD(ARGS_0, bench_reduce, NULL),
+	STMT_PROD(ARGS_1, bench_reduce, NULL),
+};
+
+static const t_lr_grammar	g_grammar = {STMT_TABLES, .prod_cb = g_prods};
+
+static const t_lr_token_id	g_cmp[] = {STMT_TOK_LT, STMT_TOK_EQ};
+static const t_lr_token_id	g_add[] = {STMT_TOK_PLUS, STMT_TOK_MINUS};
+static const t_lr_token_id	g_mul[] = {STMT_TOK_STAR, STMT_TOK_SLASH};
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Expression generator.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+static void	_expr(
+				t_bench_doc *doc,
+				int depth
+				);
+
+/**
+ * @brief Generate a call with up to 3 arguments.
+ */
+static void	_call(
+				t_bench_doc *doc,
+				int depth
+				)
+{
+	size_t	n;
+
+	bench_push(doc, STMT_TOK_ID);
+	bench_push(doc, STMT_TOK_LPAREN);
+	n = bench_rand(doc, 4);
+	while (n != 0)
+	{
+		_expr(doc, depth + 1);
+		if (--n != 0)
+			bench_push(doc, STMT_TOK_COMMA);
+	}
+	bench_push(doc, STMT_TOK_RPAREN);
+}
+
+/**
+ * @brief Generate a primary expression, nesting at most 4 deep.
+ */
+static void	_primary(
+				t_bench_doc *doc,
+				int depth
+				)
+{
+	size_t	r;
+
+	r = bench_rand(doc, 8);
+	if (r == 0 && depth < 4)
+	{
+		bench_push(doc, STMT_TOK_LPAREN);
+		_expr(doc, depth + 1);
+		bench_push(doc, STMT_TOK_RPAREN);
+	}
+	else if (r == 1 && depth < 4)
+		_call(doc, depth);
+	else if (r < 5)
+		bench_push(doc, STMT_TOK_NUM);
+	else
+		bench_push(doc, STMT_TOK_ID);
+}
+
+/**
+ * @brief Generate a product of unary expressions.
+ */
+static void	_prod(
+				t_bench_doc *doc,
+				int depth
+				)
+{
+	while (bench_rand(doc, 8) == 0)
+		bench_push(doc, STMT_TOK_MINUS);
+	_primary(doc, depth);
+	while (bench_rand(doc, 3) == 0)
+	{
+		bench_push(doc, g_mul[bench_rand(doc, 2)]);
+		while (bench_rand(doc, 8) == 0)
+			bench_push(doc, STMT_TOK_MINUS);
+		_primary(doc, depth);
+	}
+}
+
+/**
+ * @brief Generate a sum of products.
+ */
+static void	_sum(
+				t_bench_doc *doc,
+				int depth
+				)
+{
+	_prod(doc, depth);
+	while (bench_rand(doc, 2) == 0)
+	{
+		bench_push(doc, g_add[bench_rand(doc, 2)]);
+		_prod(doc, depth);
+	}
+}
+
+/**
+ * @brief Generate a conjunction of comparisons.
+ */
+static void	_expr(
+				t_bench_doc *doc,
+				int depth
+				)
+{
+	_sum(doc, depth);
+	if (bench_rand(doc, 3) == 0)
+	{
+		bench_push(doc, g_cmp[bench_rand(doc, 2)]);
+		_sum(doc, depth);
+	}
+	while (bench_rand(doc, 4) == 0)
+	{
+		bench_push(doc, STMT_TOK_AND);
+		_sum(doc, depth);
+	}
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Statement generator.                                                   * //
+// *                                                                        * //
+// ************************************************************************** //
+
+static void	_stmt(
+				t_bench_doc *doc,
+				int depth
+				);
+
+/**
+ * @brief Generate a block of up to 4 statements.
+ */
+static void	_block(
+				t_bench_doc *doc,
+				int depth
+				)
+{
+	size_t	n;
+
+	bench_push(doc, STMT_TOK_LBRACE);
+	n = bench_rand(doc, 5);
+	while (n-- != 0)
+		_stmt(doc, depth + 1);
+	bench_push(doc, STMT_TOK_RBRACE);
+}
+
+/**
+ * @brief Generate an if, with an else branch half of the time.
+ */
+static void	_if(
+				t_bench_doc *doc,
+				int depth
+				)
+{
+	bench_push(doc, STMT_TOK_IF);
+	bench_push(doc, STMT_TOK_LPAREN);
+	_expr(doc, 0);
+	bench_push(doc, STMT_TOK_RPAREN);
+	_block(doc, depth);
+	if (bench_rand(doc, 2) == 0)
+	{
+		bench_push(doc, STMT_TOK_ELSE);
+		_block(doc, depth);
+	}
+}
+
+/**
+ * @brief Generate a return, a call or an assignment statement.
+ */
+static void	_simple(
+				t_bench_doc *doc,
+				size_t r
+				)
+{
+	if (r == 3)
+	{
+		bench_push(doc, STMT_TOK_RETURN);
+		_expr(doc, 0);
+	}
+	else if (r < 6)
+		_call(doc, 0);
+	else
+	{
+		bench_push(doc, STMT_TOK_ID);
+		bench_push(doc, STMT_TOK_ASSIGN);
+		_expr(doc, 0);
+	}
+	bench_push(doc, STMT_TOK_SEMI);
+}
+
+/**
+ * @brief Generate a statement, blocks nesting at most 4 deep.
+ */
+static void	_stmt(
+				t_bench_doc *doc,
+				int depth
+				)
+{
+	size_t	r;
+
+	r = bench_rand(doc, 10);
+	if (r < 3 && depth >= 4)
+		r = 4;
+	if (r == 0)
+		_if(doc, depth);
+	else if (r == 1)
+	{
+		bench_push(doc, STMT_TOK_WHILE);
+		bench_push(doc, STMT_TOK_LPAREN);
+		_expr(doc, 0);
+		bench_push(doc, STMT_TOK_RPAREN);
+		_block(doc, depth);
+	}
+	else if (r == 2)
+		_block(doc, depth);
+	else
+		_simple(doc, r);
+}
+
+/**
+ * @brief Generate a program of about tokens tokens.
+ */
+static void	_gen(
+				t_bench_doc *doc,
+				size_t tokens
+				)
+{
+	_stmt(doc, 0);
+	while (doc->count < tokens)
+		_stmt(doc, 0);
+	bench_push(doc, STMT_TOK_END);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Global variables.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+const t_bench_lang	g_bench_stmt = {
+	.name = "stmt",
+	.grammar = &g_grammar,
+	.gen = _gen,
+};
@@ -0,0 +1,343 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   direct.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 16:02:41 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 16:02:41 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file direct.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Direct-coded engine emission.
+ *
+ * The engine has one block per state. The block of the current state is
+ * entered through a computed goto, switches on the token and jumps to the
+ * shift, to the block of the reduced production or to the error. After a
+ * reduction the goto state is resolved by a switch on the state under the
+ * reduced items and the engine jumps straight to its block, so a token never
+ * goes back through a table lookup. The most frequent reduction of a state
+ * is its default case, error entries keep their own case so errors are
+ * detected as early as with the dense tables.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdlib.h>
+
+#include "mp_gen.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Direct-coded engine emission state.
+ */
+typedef struct s_mpg_direct
+{
+	FILE					*out;		/**< Output stream. */
+	const t_mpg_opts		*opts;		/**< Generator options. */
+	const t_mpg_grammar		*g;			/**< Grammar. */
+	const t_lr_grammar		*tables;	/**< Dense and compressed tables. */
+	char					*reduced;	/**< Non zero for reduced productions. */
+	size_t					*count;		/**< Goto target counters per state. */
+	char					*done;		/**< Already emitted cases. */
+	int						shift;		/**< Non zero if some state shifts. */
+	int						error;		/**< Non zero if some state errors. */
+}	t_mpg_direct;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Print the jump performed by an action.
+ */
+static void	_jump(
+				t_mpg_direct *d,
+				t_lr_packed_action packed,
+				const char *indent
+				)
+{
+	if (LR_PACKED_TYPE(packed) == ACTION_SHIFT)
+	{
+		fprintf(d->out, "%sst = %lu;\n%sgoto shift;\n", indent,
+			(unsigned long)LR_PACKED_ID(packed), indent);
+		d->shift = 1;
+	}
+	else if (LR_PACKED_TYPE(packed) == ACTION_REDUCE)
+	{
+		fprintf(d->out, "%sgoto r%lu;\n", indent,
+			(unsigned long)LR_PACKED_ID(packed));
+		d->reduced[LR_PACKED_ID(packed)] = 1;
+	}
+	else if (LR_PACKED_TYPE(packed) == ACTION_ACCEPT)
+		fprintf(d->out, "%sreturn (LR_ACCEPT);\n", indent);
+	else
+	{
+		fprintf(d->out, "%sgoto error;\n", indent);
+		d->error = 1;
+	}
+}
+
+/**
+ * @brief Print the block of a state.
+ *
+ * Tokens sharing an action share their case, the tokens of the default
+ * action fall in the default case.
+ */
+static void	_state(
+				t_mpg_direct *d,
+				size_t state
+				)
+{
+	const size_t				n = d->tables->token_count;
+	const t_lr_packed_action	*row = d->tables->packed_table + state * n;
+	const t_lr_packed_action	def = d->tables->action_comb->defaults[state];
+	size_t						k;
+	size_t						i;
+
+	fprintf(d->out, "s%zu:\n\tswitch (token->id)\n\t{\n", state);
+	k = 0;
+	while (k < n)
+		d->done[k++] = 0;
+	k = 0;
+	while (k < n)
+	{
+		if (!d->done[k] && row[k] != def)
+		{
+			i = k;
+			while (i < n)
+			{
+				if (row[i] == row[k])
+				{
+					d->done[i] = 1;
+					fputs("\t\tcase ", d->out);
+					mpg_put_upper(d->out, d->opts->prefix);
+					fputs("_TOK_", d->out);
+					mpg_put_upper(d->out, d->g->syms[i].name);
+					fputs(":\n", d->out);
+				}
+				++i;
+			}
+			_jump(d, row[k], "\t\t\t");
+		}
+		++k;
+	}
+	fputs("\t\tdefault:\n", d->out);
+	_jump(d, def, "\t\t\t");
+	fputs("\t}\n", d->out);
+}
+
+/**
+ * @brief Find the most frequent goto target of a production.
+ *
+ * Gotos that the automaton never takes are state 0, which no goto targets.
+ */
+static t_lr_state_id	_goto_default(
+							t_mpg_direct *d,
+							size_t prod
+							)
+{
+	const size_t		n = d->tables->state_count;
+	const size_t		m = d->tables->prod_count;
+	const t_lr_state_id	*col = d->tables->goto_table + prod;
+	t_lr_state_id		best;
+	size_t				k;
+
+	best = 0;
+	k = 0;
+	while (k < n)
+		d->count[k++] = 0;
+	k = 0;
+	while (k < n)
+	{
+		if (col[k * m] != 0
+			&& ++d->count[col[k * m]] > d->count[best])
+			best = col[k * m];
+		++k;
+	}
+	return (best);
+}
+
+/**
+ * @brief Print the block of a reduced production.
+ */
+static void	_reduce(
+				t_mpg_direct *d,
+				size_t prod
+				)
+{
+	const size_t		n = d->tables->state_count;
+	const size_t		m = d->tables->prod_count;
+	const t_lr_state_id	*col = d->tables->goto_table + prod;
+	const t_lr_state_id	def = _goto_default(d, prod);
+	const t_mpg_prod	*p = d->g->prods + prod;
+	size_t				k;
+	size_t				i;
+
+	fprintf(d->out, "r%zu:\n\tprod = ", prod);
+	mpg_put_upper(d->out, d->opts->prefix);
+	fputs("_PROD_", d->out);
+	mpg_put_upper(d->out, d->g->syms[p->lhs].name);
+	fprintf(d->out, "_%d;\n", p->alt);
+	k = 0;
+	while (k < n && (col[k * m] == 0
+			|| col[k * m] == def))
+		d->done[k++] = 0;
+	if (k == n)
+	{
+		fprintf(d->out, "\tst = %lu;\n\tgoto reduce;\n", (unsigned long)def);
+		return ;
+	}
+	while (k < n)
+		d->done[k++] = 0;
+	fprintf(d->out, "\tswitch (lr_stack_state_under(&ctx->stack, %zu))\n\t{\n",
+		p->len);
+	k = 0;
+	while (k < n)
+	{
+		if (!d->done[k] && col[k * m] != 0
+			&& col[k * m] != def)
+		{
+			i = k;
+			while (i < n)
+			{
+				if (col[i * m] == col[k * m])
+				{
+					d->done[i] = 1;
+					fprintf(d->out, "\t\tcase %zu:\n", i);
+				}
+				++i;
+			}
+			fprintf(d->out, "\t\t\tst = %lu;\n\t\t\tgoto reduce;\n",
+				(unsigned long)col[k * m]);
+		}
+		++k;
+	}
+	fprintf(d->out, "\t\tdefault:\n\t\t\tst = %lu;\n\t\t\tgoto reduce;\n\t}\n",
+		(unsigned long)def);
+}
+
+/**
+ * @brief Print the blocks shared by every state.
+ */
+static void	_tail(
+				t_mpg_direct *d,
+				int reduce
+				)
+{
+	if (reduce)
+		fputs("reduce:\n\terr = _lr_parser_reduce_to(ctx, prod, st);\n"
+			"\tif (err != LR_OK)\n\t\tgoto fail;\n\tgoto *states[st];\n",
+			d->out);
+	if (d->shift)
+		fputs("shift:\n\terr = _lr_parser_shift(ctx, token, st);\n"
+			"\tif (err != LR_OK)\n\t\tgoto fail;\n\treturn (LR_OK);\n", d->out);
+	if (d->error)
+		fputs("error:\n\treturn (_lr_parser_error(ctx, token));\n",
+			d->out);
+	if (reduce || d->shift)
+		fputs("fail:\n\tlr_stack_clear(&ctx->stack);\n\treturn (err);\n",
+			d->out);
+}
+
+/**
+ * @brief Print the engine body after its declarations.
+ */
+static void	_body(
+				t_mpg_direct *d
+				)
+{
+	size_t	k;
+	int		reduce;
+
+	fputs("\tgoto *states[lr_stack_cur_state(&ctx->stack)];\n", d->out);
+	k = 0;
+	while (k < d->tables->state_count)
+		_state(d, k++);
+	reduce = 0;
+	k = 0;
+	while (k < d->g->prod_count)
+	{
+		if (d->reduced[k])
+		{
+			_reduce(d, k);
+			reduce = 1;
+		}
+		++k;
+	}
+	_tail(d, reduce);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Emit a direct-coded engine and its NAME_TABLES initializer.
+ *
+ * The engine is a static function named after the prefix, it uses the
+ * labels as values extension of GNU C.
+ *
+ * @param out Output stream.
+ * @param opts Generator options.
+ * @param g Grammar.
+ * @param t Tables.
+ */
+void	mpg_emit_direct(
+			FILE *out,
+			const t_mpg_opts *opts,
+			const t_mpg_grammar *g,
+			const t_mpg_tables *t
+			)
+{
+	t_mpg_direct	d;
+	size_t			col;
+	size_t			k;
+	char			buf[32];
+
+	d = (t_mpg_direct){.out = out, .opts = opts, .g = g, .tables = &t->tables};
+	d.reduced = mpg_xcalloc(g->prod_count + 1);
+	d.count = mpg_xcalloc(t->tables.state_count * sizeof(*d.count));
+	d.done = mpg_xcalloc(t->tables.state_count + g->token_count);
+	fprintf(out, "# ifndef __GNUC__\n#  error \"%s engine needs GNU C labels "
+		"as values\"\n# endif\n\n/**\n * @brief Direct-coded engine, one block"
+		" per state.\n */\nstatic t_lr_error\t%s_engine(\n\t\t\t\t\t"
+		"t_lr_parser_ctx *ctx,\n\t\t\t\t\tconst t_lr_token *token\n\t\t\t\t\t"
+		")\n{\n\tstatic const void *const\tstates[] = {\n", opts->prefix,
+		opts->prefix);
+	col = 0;
+	k = 0;
+	while (k < t->tables.state_count)
+	{
+		snprintf(buf, sizeof(buf), "&&s%zu", k++);
+		mpg_put_elem(out, buf, &col);
+	}
+	fputs(",\n\t};\n\tt_lr_prod_id\t\t\t\tprod;\n\tt_lr_state_id\t\t\t\tst;\n"
+		"\tt_lr_error\t\t\t\t\terr;\n\n", out);
+	_body(&d);
+	fprintf(out, "}\n\n/**\n * @brief Initializer of the fields of a "
+		"t_lr_grammar.\n */\n# define %s_TABLES\t.engine = &%s_engine, ",
+		opts->upper, opts->prefix);
+	free(d.reduced);
+	free(d.count);
+	free(d.done);
+}
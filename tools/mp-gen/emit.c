@@ -0,0 +1,389 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   emit.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:11:09 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 14:11:09 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file emit.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief C header emission of the generated tables.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <ctype.h>
+#include <string.h>
+
+#include "mp_gen.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Print a packed action with the emitted action macros.
+ */
+static void	_packed(
+				FILE *out,
+				const t_mpg_opts *opts,
+				t_lr_packed_action packed,
+				size_t *col
+				)
+{
+	char	buf[64];
+
+	if (LR_PACKED_TYPE(packed) == ACTION_SHIFT)
+		snprintf(buf, sizeof(buf), "%s_SHIFT(%lu)", opts->upper,
+			(unsigned long)LR_PACKED_ID(packed));
+	else if (LR_PACKED_TYPE(packed) == ACTION_REDUCE)
+		snprintf(buf, sizeof(buf), "%s_REDUCE(%lu)", opts->upper,
+			(unsigned long)LR_PACKED_ID(packed));
+	else if (LR_PACKED_TYPE(packed) == ACTION_ACCEPT)
+		snprintf(buf, sizeof(buf), "%s_ACCEPT", opts->upper);
+	else
+		snprintf(buf, sizeof(buf), "%s_ERROR", opts->upper);
+	mpg_put_elem(out, buf, col);
+}
+
+/**
+ * @brief Print an array of integers.
+ *
+ * @param kind 0 for size_t, 1 for token IDs, 2 for state IDs, 3 for
+ *             production IDs.
+ */
+static void	_ints(
+				FILE *out,
+				const void *data,
+				size_t count,
+				int kind
+				)
+{
+	char	buf[32];
+	size_t	col;
+	size_t	k;
+	long	v;
+
+	col = 0;
+	fputs("{\n", out);
+	k = 0;
+	while (k < count)
+	{
+		if (kind == 0)
+			v = (long)((const size_t *)data)[k];
+		else if (kind == 1)
+			v = ((const t_lr_token_id *)data)[k];
+		else if (kind == 2)
+			v = ((const t_lr_state_id *)data)[k];
+		else
+			v = ((const t_lr_prod_id *)data)[k];
+		if (kind == 2 && ((const t_lr_state_id *)data)[k] == LR_STATE_NONE)
+			snprintf(buf, sizeof(buf), "LR_STATE_NONE");
+		else if (kind == 3 && ((const t_lr_prod_id *)data)[k] == LR_PROD_NONE)
+			snprintf(buf, sizeof(buf), "LR_PROD_NONE");
+		else
+			snprintf(buf, sizeof(buf), "%ld", v);
+		mpg_put_elem(out, buf, &col);
+		++k;
+	}
+	fputs(",\n};\n\n", out);
+}
+
+/**
+ * @brief Print an array of packed actions.
+ */
+static void	_actions(
+				FILE *out,
+				const t_mpg_opts *opts,
+				const t_lr_packed_action *data,
+				size_t count
+				)
+{
+	size_t	col;
+	size_t	k;
+
+	col = 0;
+	fputs("{\n", out);
+	k = 0;
+	while (k < count)
+		_packed(out, opts, data[k++], &col);
+	fputs(",\n};\n\n", out);
+}
+
+/**
+ * @brief Print the token and production enumerations.
+ */
+static void	_enums(
+				FILE *out,
+				const t_mpg_opts *opts,
+				const t_mpg_grammar *g
+				)
+{
+	size_t	k;
+	size_t	i;
+
+	fprintf(out, "/**\n * @brief Token IDs.\n */\nenum e_%s_token\n{\n",
+		opts->prefix);
+	k = 0;
+	while (k < g->token_count)
+	{
+		fputc('\t', out);
+		mpg_put_upper(out, opts->prefix);
+		fputs("_TOK_", out);
+		mpg_put_upper(out, g->syms[k++].name);
+		fputs(",\n", out);
+	}
+	fputs("};\n\n/**\n * @brief Production IDs.\n */\nenum e_", out);
+	fprintf(out, "%s_prod\n{\n", opts->prefix);
+	k = 0;
+	while (k < g->prod_count)
+	{
+		fputc('\t', out);
+		mpg_put_upper(out, opts->prefix);
+		fputs("_PROD_", out);
+		mpg_put_upper(out, g->syms[g->prods[k].lhs].name);
+		fprintf(out, "_%d,\t/**< %s :", g->prods[k].alt,
+			g->syms[g->prods[k].lhs].name);
+		i = 0;
+		while (i < g->prods[k].len)
+			fprintf(out, " %s", g->syms[g->prods[k].rhs[i++]].name);
+		fprintf(out, "%s */\n", g->prods[k++].len == 0 ? " %empty" : "");
+	}
+	fputs("};\n\n", out);
+}
+
+/**
+ * @brief Print the counts, production sizes and width checks.
+ */
+static void	_macros(
+				FILE *out,
+				const t_mpg_opts *opts,
+				const t_mpg_grammar *g,
+				const t_mpg_tables *t
+				)
+{
+	const char	*p = opts->upper;
+	size_t		k;
+
+	fprintf(out, "# define %s_TOKEN_COUNT\t%zu\n", p, g->token_count);
+	fprintf(out, "# define %s_PROD_COUNT\t%zu\n", p, g->prod_count);
+	fprintf(out, "# define %s_STATE_COUNT\t%zu\n\n", p, t->tables.state_count);
+	k = 0;
+	while (k < g->prod_count)
+	{
+		fprintf(out, "# define %s_PROD_", p);
+		mpg_put_upper(out, g->syms[g->prods[k].lhs].name);
+		fprintf(out, "_%d_SIZE\t%zu\n", g->prods[k].alt, g->prods[k].len);
+		++k;
+	}
+	fprintf(out, "\n# if (MP_ID_BITS == 8 && (%s_STATE_COUNT >= 255 \\\n"
+		"\t|| %s_PROD_COUNT >= 255)) || (MP_ID_BITS == 16 \\\n"
+		"\t&& (%s_STATE_COUNT >= 65535 || %s_PROD_COUNT >= 65535))\n"
+		"#  error \"%s tables need a larger MP_ID_BITS\"\n# endif\n"
+		"# if MP_ACTION_BITS == 16 && (%s_STATE_COUNT > 16384 \\\n"
+		"\t|| %s_PROD_COUNT > 16384)\n"
+		"#  error \"%s tables need MP_ACTION_BITS == 32\"\n# endif\n\n",
+		p, p, p, p, opts->prefix, p, p, opts->prefix);
+	fprintf(out, "# define %s_SHIFT(id)\tLR_PACK_ACTION(ACTION_SHIFT, id)\n"
+		"# define %s_REDUCE(id)\tLR_PACK_ACTION(ACTION_REDUCE, id)\n"
+		"# define %s_ERROR\tLR_PACK_ACTION(ACTION_ERROR, 0)\n"
+		"# define %s_ACCEPT\tLR_PACK_ACTION(ACTION_ACCEPT, 0)\n\n",
+		p, p, p, p);
+}
+
+/**
+ * @brief Print the default reductions and the token map, if any.
+ */
+static void	_defaults(
+				FILE *out,
+				const t_mpg_opts *opts,
+				const t_mpg_tables *t
+				)
+{
+	fprintf(out, "static const t_lr_prod_id\t%s_default_reduce[] = ",
+		opts->prefix);
+	_ints(out, t->tables.default_reduce, t->tables.state_count, 3);
+	if (t->tables.token_map == NULL)
+		return ;
+	fprintf(out, "static const t_lr_token_id\t%s_token_map[] = ",
+		opts->prefix);
+	_ints(out, t->tables.token_map, t->tables.token_count, 1);
+}
+
+/**
+ * @brief Print the compressed tables.
+ */
+static void	_combs(
+				FILE *out,
+				const t_mpg_opts *opts,
+				const t_mpg_tables *t
+				)
+{
+	const t_lr_comb_action	*a = t->tables.action_comb;
+	const t_lr_comb_goto	*g = t->tables.goto_comb;
+	const char				*n = opts->prefix;
+
+	fprintf(out, "static const size_t\t%s_action_base[] = ", n);
+	_ints(out, a->base, t->tables.state_count, 0);
+	fprintf(out, "static const t_lr_packed_action\t%s_action_next[] = ", n);
+	_actions(out, opts, a->next, a->size);
+	fprintf(out, "static const t_lr_packed_action\t%s_action_defaults[] = ", n);
+	_actions(out, opts, a->defaults, t->tables.state_count);
+	fprintf(out, "static const t_lr_token_id\t%s_action_check[] = ", n);
+	_ints(out, a->check, a->size, 1);
+	fprintf(out, "static const size_t\t%s_goto_base[] = ", n);
+	_ints(out, g->base, t->tables.prod_count, 0);
+	fprintf(out, "static const t_lr_state_id\t%s_goto_next[] = ", n);
+	_ints(out, g->next, g->size, 2);
+	fprintf(out, "static const t_lr_state_id\t%s_goto_defaults[] = ", n);
+	_ints(out, g->defaults, t->tables.prod_count, 2);
+	fprintf(out, "static const t_lr_state_id\t%s_goto_check[] = ", n);
+	_ints(out, g->check, g->size, 2);
+	fprintf(out, "static const t_lr_comb_action\t%s_action_comb = {\n\t"
+		"%s_action_"
+		"base, %s_action_next, %s_action_defaults,\n\t%s_action_check, %zu,"
+		"\n};\n\n", n, n, n, n, n, a->size);
+	fprintf(out, "static const t_lr_comb_goto\t%s_goto_comb = {\n\t"
+		"%s_goto_base,"
+		" %s_goto_next, %s_goto_defaults,\n\t%s_goto_check, %zu,\n};\n\n",
+		n, n, n, n, n, g->size);
+	fprintf(out, "/**\n * @brief Initializer of the fields of a t_lr_grammar."
+		"\n */\n# define %s_TABLES\t.action_comb = &%s_action_comb, "
+		"\\\n\t.goto_comb = &%s_goto_comb, ", opts->upper, n, n);
+}
+
+/**
+ * @brief Print the dense tables.
+ */
+static void	_dense(
+				FILE *out,
+				const t_mpg_opts *opts,
+				const t_mpg_tables *t
+				)
+{
+	const char	*n = opts->prefix;
+
+	fprintf(out, "static const t_lr_packed_action\t%s_action_table[] = ", n);
+	_actions(out, opts, t->tables.packed_table,
+		t->tables.state_count * lr_grammar_columns(&t->tables));
+	fprintf(out, "static const t_lr_state_id\t%s_goto_table[] = ", n);
+	_ints(out, t->tables.goto_table,
+		t->tables.state_count * t->tables.prod_count, 2);
+	fprintf(out, "/**\n * @brief Initializer of the fields of a t_lr_grammar."
+		"\n */\n# define %s_TABLES\t.packed_table = %s_action_table, "
+		"\\\n\t.goto_table = %s_goto_table, ", opts->upper, n, n);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Emit the tables as a C header.
+ *
+ * The header defines the token and production enumerations, the size of
+ * every production, the tables as static const data (or a direct-coded
+ * engine) and a NAME_TABLES initializer for the fields of a
+ * t_lr_grammar.
+ *
+ * @param out Output stream.
+ * @param opts Generator options.
+ * @param g Grammar.
+ * @param t Tables.
+ */
+void	mpg_emit(
+			FILE *out,
+			const t_mpg_opts *opts,
+			const t_mpg_grammar *g,
+			const t_mpg_tables *t
+			)
+{
+	const char	*p = opts->upper;
+
+	fprintf(out, "/* Generated by mp-gen from %s, do not edit. */\n\n"
+		"#ifndef %s_TABLES_H\n# define %s_TABLES_H\n\n# include \"lr_parser.h\""
+		"\n\n", opts->input, p, p);
+	_enums(out, opts, g);
+	_macros(out, opts, g, t);
+	if (!opts->direct)
+		_defaults(out, opts, t);
+	if (opts->direct)
+		mpg_emit_direct(out, opts, g, t);
+	else if (opts->dense)
+		_dense(out, opts, t);
+	else
+		_combs(out, opts, t);
+	if (!opts->direct)
+		fprintf(out, "\\\n\t.default_reduce = %s_default_reduce, ",
+			opts->prefix);
+	if (!opts->direct && t->tables.token_map != NULL)
+		fprintf(out, "\\\n\t.token_map = %s_token_map, .column_count = %zu, ",
+			opts->prefix, t->tables.column_count);
+	fprintf(out, "\\\n\t.state_count = %s_STATE_COUNT, .token_count = "
+		"%s_TOKEN_COUNT, \\\n\t.prod_count = %s_PROD_COUNT\n\n", p, p, p);
+	fprintf(out, "/**\n * @brief Initializer of the t_lr_prod_cb of a "
+		"production.\n */\n# define %s_PROD(name, cb, free_cb)\t\\\n\t"
+		"[%s_PROD_ ## name] = {cb, %s_PROD_ ## name ## _SIZE, free_cb}\n\n",
+		p, p, p);
+	fprintf(out, "# undef %s_SHIFT\n# undef %s_REDUCE\n# undef %s_ERROR\n"
+		"# undef %s_ACCEPT\n\n#endif\n", p, p, p, p);
+}
+
+/**
+ * @brief Print a name in upper case.
+ *
+ * @param out Output stream.
+ * @param name Name to print.
+ */
+void	mpg_put_upper(
+			FILE *out,
+			const char *name
+			)
+{
+	while (*name != '\0')
+		fputc(toupper((unsigned char)*name++), out);
+}
+
+/**
+ * @brief Print an array element, wrapping lines before 80 columns.
+ *
+ * @param out Output stream.
+ * @param text Element text.
+ * @param col Current column, 0 before the first element.
+ */
+void	mpg_put_elem(
+			FILE *out,
+			const char *text,
+			size_t *col
+			)
+{
+	const size_t	len = strlen(text) + 2;
+
+	if (*col == 0)
+		fputc('\t', out);
+	else if (*col + len > 78)
+	{
+		fputs(",\n\t", out);
+		*col = 0;
+	}
+	else
+		fputs(", ", out);
+	fputs(text, out);
+	*col += len + 4 * (*col == 0);
+}
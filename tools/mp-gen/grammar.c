@@ -0,0 +1,631 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   grammar.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 12:19:50 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 12:19:50 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file grammar.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Grammar file reader.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *
+ * A grammar file holds declarations followed by rules:
+ *
+ * @code
+ * # Comments run from '#' or '//' to the end of the line.
+ * %token NUM PLUS STAR LPAREN RPAREN
+ * %start expr
+ * expr   : expr PLUS term | term ;
+ * term   : term STAR factor | factor ;
+ * factor : LPAREN expr RPAREN | NUM ;
+ * @endcode
+ *
+ * Every symbol not declared with %token must be the left hand side of a
+ * rule. The start symbol defaults to the first rule. An empty alternative,
+ * optionally written %empty, is allowed. A "%%" line is accepted and
+ * ignored so yacc-like layouts read naturally.
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mp_gen.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private structure.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Lexical unit of a grammar file.
+ */
+typedef enum e_mpg_lex
+{
+	LEX_IDENT,
+	LEX_COLON,
+	LEX_PIPE,
+	LEX_SEMI,
+	LEX_TOKEN,
+	LEX_START,
+	LEX_EMPTY,
+	LEX_SKIP,
+	LEX_EOF,
+	LEX_BAD,
+}	t_mpg_lex;
+
+/**
+ * @brief Grammar file reader state.
+ */
+typedef struct s_mpg_reader
+{
+	const char	*path;	/**< File path, for diagnostics. */
+	char		*src;	/**< File content. */
+	size_t		pos;	/**< Read position. */
+	int			line;	/**< Current line. */
+	t_mpg_lex	lex;	/**< Current lexical unit. */
+	char		*text;	/**< Current identifier. */
+	int			pass;	/**< 0 while collecting symbols, 1 while building. */
+	char		*start;	/**< Name of the %start symbol or NULL. */
+}	t_mpg_reader;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Lexer.                                                                 * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Skip blanks and comments.
+ */
+static void	_skip(
+				t_mpg_reader *r
+				)
+{
+	while (r->src[r->pos] != '\0')
+	{
+		if (r->src[r->pos] == '\n')
+			++r->line;
+		if (r->src[r->pos] == '#' || (r->src[r->pos] == '/'
+				&& r->src[r->pos + 1] == '/'))
+		{
+			while (r->src[r->pos] != '\0' && r->src[r->pos] != '\n')
+				++r->pos;
+			continue ;
+		}
+		if (!isspace((unsigned char)r->src[r->pos]))
+			return ;
+		++r->pos;
+	}
+}
+
+/**
+ * @brief Read an identifier or a directive word into r->text.
+ */
+static void	_word(
+				t_mpg_reader *r
+				)
+{
+	size_t	len;
+
+	len = 0;
+	while (isalnum((unsigned char)r->src[r->pos + len])
+		|| r->src[r->pos + len] == '_')
+		++len;
+	free(r->text);
+	r->text = mpg_xcalloc(len + 1);
+	memcpy(r->text, r->src + r->pos, len);
+	r->pos += len;
+}
+
+/**
+ * @brief Read a directive starting with '%'.
+ */
+static t_mpg_lex	_directive(
+						t_mpg_reader *r
+						)
+{
+	++r->pos;
+	if (r->src[r->pos] == '%')
+	{
+		++r->pos;
+		return (LEX_SKIP);
+	}
+	_word(r);
+	if (strcmp(r->text, "token") == 0)
+		return (LEX_TOKEN);
+	if (strcmp(r->text, "start") == 0)
+		return (LEX_START);
+	if (strcmp(r->text, "empty") == 0)
+		return (LEX_EMPTY);
+	return (LEX_BAD);
+}
+
+/**
+ * @brief Read the next lexical unit.
+ */
+static void	_next(
+				t_mpg_reader *r
+				)
+{
+	char	c;
+
+	r->lex = LEX_SKIP;
+	while (r->lex == LEX_SKIP)
+	{
+		_skip(r);
+		c = r->src[r->pos];
+		r->lex = LEX_BAD;
+		if (c == '\0')
+			r->lex = LEX_EOF;
+		else if (c == '%')
+			r->lex = _directive(r);
+		else if (isalpha((unsigned char)c) || c == '_')
+		{
+			_word(r);
+			r->lex = LEX_IDENT;
+		}
+		else if (c == ':')
+			r->lex = LEX_COLON;
+		else if (c == '|')
+			r->lex = LEX_PIPE;
+		else if (c == ';')
+			r->lex = LEX_SEMI;
+		if (c != '\0' && (c == ':' || c == '|' || c == ';'
+				|| r->lex == LEX_BAD))
+			++r->pos;
+	}
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Symbols.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Find a symbol by name, -1 if unknown.
+ */
+static int	_find(
+				const t_mpg_grammar *g,
+				const char *name
+				)
+{
+	size_t	k;
+
+	k = 0;
+	while (k < g->sym_count)
+	{
+		if (strcmp(g->syms[k].name, name) == 0)
+			return ((int)k);
+		++k;
+	}
+	return (-1);
+}
+
+/**
+ * @brief Add a symbol if it does not exist yet.
+ */
+static int	_add(
+				t_mpg_grammar *g,
+				const char *name,
+				int is_token,
+				int line
+				)
+{
+	int	k;
+
+	k = _find(g, name);
+	if (k >= 0)
+		return (k);
+	g->syms = realloc(g->syms, (g->sym_count + 1) * sizeof(*g->syms));
+	if (g->syms == NULL)
+		exit(EXIT_FAILURE);
+	g->syms[g->sym_count] = (t_mpg_symbol){.name = strdup(name),
+		.is_token = is_token, .line = line};
+	return ((int)g->sym_count++);
+}
+
+/**
+ * @brief Report an error at the current line.
+ */
+static int	_error(
+				const t_mpg_reader *r,
+				const char *msg,
+				const char *arg
+				)
+{
+	fprintf(stderr, "%s:%d: %s%s%s\n", r->path, r->line, msg,
+		arg != NULL ? " " : "", arg != NULL ? arg : "");
+	return (-1);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Parser.                                                                * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Append a production (second pass only).
+ */
+static void	_prod_add(
+				t_mpg_grammar *g,
+				int lhs,
+				int line
+				)
+{
+	size_t	k;
+	int		alt;
+
+	alt = 0;
+	k = 0;
+	while (k < g->prod_count)
+		alt += (g->prods[k++].lhs == lhs);
+	g->prods = realloc(g->prods, (g->prod_count + 2) * sizeof(*g->prods));
+	if (g->prods == NULL)
+		exit(EXIT_FAILURE);
+	g->prods[g->prod_count++] = (t_mpg_prod){.lhs = lhs, .rhs = NULL,
+		.len = 0, .alt = alt, .line = line};
+	g->prods[g->prod_count] = (t_mpg_prod){0};
+}
+
+/**
+ * @brief Append a symbol to the last production (second pass only).
+ */
+static int	_prod_push(
+				t_mpg_reader *r,
+				t_mpg_grammar *g
+				)
+{
+	t_mpg_prod	*p;
+	int			sym;
+
+	sym = _find(g, r->text);
+	if (sym < 0)
+		return (_error(r, "undefined symbol", r->text));
+	p = g->prods + g->prod_count - 1;
+	p->rhs = realloc(p->rhs, (p->len + 1) * sizeof(*p->rhs));
+	if (p->rhs == NULL)
+		exit(EXIT_FAILURE);
+	p->rhs[p->len++] = sym;
+	return (0);
+}
+
+/**
+ * @brief Parse one rule, "lhs : alt | alt ;".
+ */
+static int	_rule(
+				t_mpg_reader *r,
+				t_mpg_grammar *g
+				)
+{
+	int	lhs;
+
+	lhs = _find(g, r->text);
+	if (r->pass == 0 && strcmp(r->text, "END") == 0)
+		return (_error(r, "reserved symbol name:", r->text));
+	if (r->pass == 0 && lhs >= 0 && g->syms[lhs].is_token)
+		return (_error(r, "token used as rule name:", r->text));
+	if (r->pass == 0)
+		lhs = _add(g, r->text, 0, r->line);
+	_next(r);
+	if (r->lex != LEX_COLON)
+		return (_error(r, "expected ':' after rule name", NULL));
+	r->lex = LEX_PIPE;
+	while (r->lex == LEX_PIPE)
+	{
+		if (r->pass == 1)
+			_prod_add(g, lhs, r->line);
+		_next(r);
+		if (r->lex == LEX_EMPTY)
+			_next(r);
+		while (r->lex == LEX_IDENT)
+		{
+			if (r->pass == 1 && _prod_push(r, g) < 0)
+				return (-1);
+			_next(r);
+		}
+	}
+	if (r->lex != LEX_SEMI)
+		return (_error(r, "expected ';' at the end of the rule", NULL));
+	return (0);
+}
+
+/**
+ * @brief Parse a %token or %start declaration, names on the same line.
+ */
+static int	_decl(
+				t_mpg_reader *r,
+				t_mpg_grammar *g
+				)
+{
+	const t_mpg_lex	kind = r->lex;
+	const int		line = r->line;
+
+	_next(r);
+	while (r->lex == LEX_IDENT && r->line == line)
+	{
+		if (kind == LEX_START)
+		{
+			free(r->start);
+			r->start = strdup(r->text);
+		}
+		else if (r->pass == 0 && (_find(g, r->text) >= 0
+				|| strcmp(r->text, "END") == 0))
+			return (_error(r, "symbol declared twice or reserved:", r->text));
+		else if (r->pass == 0)
+			_add(g, r->text, 1, r->line);
+		_next(r);
+	}
+	return (0);
+}
+
+/**
+ * @brief Run one pass over the grammar file.
+ */
+static int	_pass(
+				t_mpg_reader *r,
+				t_mpg_grammar *g
+				)
+{
+	r->pos = 0;
+	r->line = 1;
+	_next(r);
+	while (r->lex != LEX_EOF)
+	{
+		if (r->lex == LEX_TOKEN || r->lex == LEX_START)
+		{
+			if (_decl(r, g) < 0)
+				return (-1);
+			continue ;
+		}
+		if (r->lex != LEX_IDENT)
+			return (_error(r, "expected a rule or a declaration", NULL));
+		if (_rule(r, g) < 0)
+			return (-1);
+		_next(r);
+	}
+	return (0);
+}
+
+/**
+ * @brief Renumber symbols: terminals, end of input, nonterminals, accept.
+ */
+static void	_renumber(
+				t_mpg_grammar *g
+				)
+{
+	t_mpg_symbol	*syms;
+	size_t			n;
+	size_t			k;
+	int				tokens;
+
+	syms = mpg_xcalloc((g->sym_count + 2) * sizeof(*syms));
+	n = 0;
+	tokens = 1;
+	while (tokens >= 0)
+	{
+		k = 0;
+		while (k < g->sym_count)
+		{
+			if (g->syms[k].is_token == tokens)
+				syms[n++] = g->syms[k];
+			++k;
+		}
+		if (tokens)
+			syms[n++] = (t_mpg_symbol){.name = strdup("END"), .is_token = 1};
+		--tokens;
+	}
+	g->token_count = 0;
+	while (syms[g->token_count].is_token)
+		++g->token_count;
+	syms[n++] = (t_mpg_symbol){.name = strdup("$accept"), .is_token = 0};
+	free(g->syms);
+	g->syms = syms;
+	g->sym_count = n;
+}
+
+/**
+ * @brief Resolve the start symbol and append the augmented production.
+ */
+static int	_augment(
+				t_mpg_reader *r,
+				t_mpg_grammar *g
+				)
+{
+	t_mpg_prod	*p;
+
+	if (g->prod_count == 0)
+		return (_error(r, "grammar has no rule", NULL));
+	g->start = g->prods[0].lhs;
+	if (r->start != NULL)
+		g->start = _find(g, r->start);
+	if (g->start < 0 || g->syms[g->start].is_token)
+		return (_error(r, "bad start symbol", r->start));
+	p = g->prods + g->prod_count;
+	*p = (t_mpg_prod){.lhs = (int)g->sym_count - 1, .len = 1, .alt = 0,
+		.rhs = mpg_xcalloc(sizeof(int))};
+	p->rhs[0] = g->start;
+	return (0);
+}
+
+/**
+ * @brief Compute nullable flags and FIRST sets by fixpoint iteration.
+ */
+static void	_first(
+				t_mpg_grammar *g
+				)
+{
+	const t_mpg_prod	*p;
+	size_t				k;
+	size_t				i;
+	int					changed;
+
+	g->words = (g->token_count + 63) / 64;
+	g->first = mpg_xcalloc(g->sym_count * g->words * sizeof(*g->first));
+	g->nullable = mpg_xcalloc(g->sym_count);
+	k = 0;
+	while (k < g->token_count)
+	{
+		MPG_BIT_SET(g->first + k * g->words, k);
+		++k;
+	}
+	changed = 1;
+	while (changed)
+	{
+		changed = 0;
+		k = 0;
+		while (k <= g->prod_count)
+		{
+			p = g->prods + k++;
+			i = 0;
+			while (i < p->len && (i == 0 || g->nullable[p->rhs[i - 1]]))
+				changed |= mpg_bits_or(g->first + p->lhs * g->words,
+						g->first + p->rhs[i++] * g->words, g->words);
+			if (i == p->len && (i == 0 || g->nullable[p->rhs[i - 1]])
+				&& !g->nullable[p->lhs])
+				changed = g->nullable[p->lhs] = 1;
+		}
+	}
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Read a whole file into a NUL terminated buffer.
+ */
+static char	*_slurp(
+				const char *path
+				)
+{
+	FILE	*f;
+	char	*buf;
+	long	len;
+
+	f = fopen(path, "rb");
+	if (f == NULL)
+		return (NULL);
+	buf = NULL;
+	if (fseek(f, 0, SEEK_END) == 0)
+	{
+		len = ftell(f);
+		rewind(f);
+		if (len >= 0)
+			buf = mpg_xcalloc(len + 1);
+		if (buf != NULL && fread(buf, 1, len, f) != (size_t)len)
+		{
+			free(buf);
+			buf = NULL;
+		}
+	}
+	fclose(f);
+	return (buf);
+}
+
+/**
+ * @brief Load a grammar file and compute its FIRST sets.
+ *
+ * @param g Grammar to fill.
+ * @param path Path of the grammar file.
+ * @return 0 on success, -1 on error (reported on stderr).
+ */
+int	mpg_grammar_load(
+		t_mpg_grammar *g,
+		const char *path
+		)
+{
+	t_mpg_reader	r;
+	int				err;
+
+	*g = (t_mpg_grammar){0};
+	r = (t_mpg_reader){.path = path, .src = _slurp(path)};
+	if (r.src == NULL)
+	{
+		perror(path);
+		return (-1);
+	}
+	err = _pass(&r, g);
+	if (err == 0)
+	{
+		_renumber(g);
+		r.pass = 1;
+		err = _pass(&r, g);
+	}
+	if (err == 0)
+		err = _augment(&r, g);
+	if (err == 0)
+		_first(g);
+	free(r.src);
+	free(r.text);
+	free(r.start);
+	if (err != 0)
+		mpg_grammar_free(g);
+	return (err);
+}
+
+/**
+ * @brief Free a grammar.
+ *
+ * @param g Grammar to free.
+ */
+void	mpg_grammar_free(
+			t_mpg_grammar *g
+			)
+{
+	size_t	k;
+
+	k = 0;
+	while (k < g->sym_count)
+		free(g->syms[k++].name);
+	k = 0;
+	while (g->prods != NULL && k <= g->prod_count)
+		free(g->prods[k++].rhs);
+	free(g->syms);
+	free(g->prods);
+	free(g->first);
+	free(g->nullable);
+	*g = (t_mpg_grammar){0};
+}
+
+/**
+ * @brief Build production callbacks holding only the production sizes.
+ *
+ * @param g Grammar.
+ * @return The callbacks, to free, never NULL.
+ */
+t_lr_prod_cb	*mpg_prod_sizes(
+					const t_mpg_grammar *g
+					)
+{
+	t_lr_prod_cb	*prod_cb;
+	size_t			k;
+
+	prod_cb = mpg_xcalloc(g->prod_count * sizeof(*prod_cb));
+	k = 0;
+	while (k < g->prod_count)
+	{
+		prod_cb[k].size = g->prods[k].len;
+		++k;
+	}
+	return (prod_cb);
+}
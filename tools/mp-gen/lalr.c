@@ -0,0 +1,478 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lalr.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 12:58:12 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 12:58:12 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file lalr.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief LALR(1) and canonical LR(1) automaton construction.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mp_gen.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Defines.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Number of buckets of the state hash table (power of two).
+ */
+#define MPG_BUCKETS	16384
+
+/**
+ * @brief Closure item sorted by the symbol after its dot.
+ */
+typedef struct s_mpg_goto_item
+{
+	int					sym;	/**< Symbol after the dot. */
+	t_mpg_item			item;	/**< Item. */
+	const t_mpg_word	*la;	/**< Lookahead set of the item. */
+}	t_mpg_goto_item;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * States.                                                                * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Hash a kernel, its lookaheads included for canonical LR(1).
+ */
+static unsigned long	_hash(
+							const t_mpg_lr *lr,
+							const t_mpg_item *kernel,
+							const t_mpg_word *la,
+							size_t n
+							)
+{
+	unsigned long	h;
+	size_t			k;
+
+	h = 5381;
+	k = 0;
+	while (k < n)
+	{
+		h = h * 33 + (unsigned long)kernel[k].prod * 131 + kernel[k].dot;
+		++k;
+	}
+	k = 0;
+	while (lr->canonical && k < n * lr->g->words)
+		h = h * 33 + (unsigned long)(la[k++] * 0x9e3779b97f4a7c15ULL >> 32);
+	return (h);
+}
+
+/**
+ * @brief Find the state with the given kernel, -1 if none.
+ */
+static int	_find(
+				const t_mpg_lr *lr,
+				const t_mpg_item *kernel,
+				const t_mpg_word *la,
+				size_t n
+				)
+{
+	const unsigned long	h = _hash(lr, kernel, la, n);
+	const t_mpg_state	*s;
+	int					k;
+
+	k = lr->buckets[h % MPG_BUCKETS];
+	while (k >= 0)
+	{
+		s = lr->states + k;
+		if (s->hash == h && s->nkernel == n
+			&& memcmp(s->kernel, kernel, n * sizeof(*kernel)) == 0
+			&& (!lr->canonical || memcmp(s->la, la,
+					n * lr->g->words * sizeof(*la)) == 0))
+			return (k);
+		k = s->hnext;
+	}
+	return (-1);
+}
+
+/**
+ * @brief Add a state, taking ownership of kernel and la.
+ */
+static int	_add(
+				t_mpg_lr *lr,
+				t_mpg_item *kernel,
+				t_mpg_word *la,
+				size_t n
+				)
+{
+	t_mpg_state	*s;
+	size_t		k;
+
+	if (lr->count == lr->alloced)
+	{
+		lr->alloced = 2 * lr->alloced + 16;
+		lr->states = realloc(lr->states, lr->alloced * sizeof(*lr->states));
+		if (lr->states == NULL)
+			exit(EXIT_FAILURE);
+	}
+	s = lr->states + lr->count;
+	*s = (t_mpg_state){.kernel = kernel, .la = la, .nkernel = n,
+		.hash = _hash(lr, kernel, la, n), .dirty = 1};
+	s->trans = mpg_xcalloc(lr->g->sym_count * sizeof(*s->trans));
+	k = 0;
+	while (k < lr->g->sym_count)
+		s->trans[k++] = -1;
+	s->hnext = lr->buckets[s->hash % MPG_BUCKETS];
+	lr->buckets[s->hash % MPG_BUCKETS] = (int)lr->count;
+	return ((int)lr->count++);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Closure.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Spread the lookaheads of an item to the productions after its dot.
+ *
+ * @return Non zero if the closure grew.
+ */
+static int	_propagate(
+				t_mpg_lr *lr,
+				t_mpg_item item,
+				const t_mpg_word *la
+				)
+{
+	const t_mpg_grammar	*g = lr->g;
+	const t_mpg_prod	*p = g->prods + item.prod;
+	int					nullable;
+	int					changed;
+	int					q;
+
+	if ((size_t)item.dot >= p->len || g->syms[p->rhs[item.dot]].is_token)
+		return (0);
+	memset(lr->scratch, 0, g->words * sizeof(*lr->scratch));
+	nullable = 1;
+	q = item.dot + 1;
+	while (nullable && (size_t)q < p->len)
+	{
+		mpg_bits_or(lr->scratch, g->first + p->rhs[q] * g->words, g->words);
+		nullable = g->nullable[p->rhs[q++]];
+	}
+	if (nullable)
+		mpg_bits_or(lr->scratch, la, g->words);
+	changed = 0;
+	q = lr->phead[p->rhs[item.dot]];
+	while (q >= 0)
+	{
+		changed |= !lr->cl_in[q];
+		lr->cl_in[q] = 1;
+		changed |= mpg_bits_or(lr->cl_la + q * g->words, lr->scratch,
+				g->words);
+		q = lr->pnext[q];
+	}
+	return (changed);
+}
+
+/**
+ * @brief Compute the closure of a state into the automaton scratch sets.
+ *
+ * cl_in flags the productions whose dot 0 item is in the closure and
+ * cl_la holds their lookaheads; the kernel items stay in the state.
+ *
+ * @param lr Automaton.
+ * @param s State.
+ */
+void	mpg_lr_closure(
+			t_mpg_lr *lr,
+			const t_mpg_state *s
+			)
+{
+	const size_t	prods = lr->g->prod_count + 1;
+	size_t			k;
+	int				changed;
+
+	memset(lr->cl_in, 0, prods);
+	memset(lr->cl_la, 0, prods * lr->g->words * sizeof(*lr->cl_la));
+	changed = 1;
+	while (changed)
+	{
+		changed = 0;
+		k = 0;
+		while (k < s->nkernel)
+		{
+			changed |= _propagate(lr, s->kernel[k], s->la + k * lr->g->words);
+			++k;
+		}
+		k = 0;
+		while (k < prods)
+		{
+			if (lr->cl_in[k])
+				changed |= _propagate(lr, (t_mpg_item){(int)k, 0},
+						lr->cl_la + k * lr->g->words);
+			++k;
+		}
+	}
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Gotos.                                                                 * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Order closure items by symbol after the dot, then by item.
+ */
+static int	_goto_cmp(
+				const void *a,
+				const void *b
+				)
+{
+	const t_mpg_goto_item	*x = a;
+	const t_mpg_goto_item	*y = b;
+
+	if (x->sym != y->sym)
+		return ((x->sym > y->sym) - (x->sym < y->sym));
+	if (x->item.prod != y->item.prod)
+		return ((x->item.prod > y->item.prod) - (x->item.prod < y->item.prod));
+	return ((x->item.dot > y->item.dot) - (x->item.dot < y->item.dot));
+}
+
+/**
+ * @brief Collect the closure items of a state that have a symbol after the
+ * dot, sorted by that symbol.
+ */
+static size_t	_goto_items(
+					t_mpg_lr *lr,
+					const t_mpg_state *s,
+					t_mpg_goto_item *out
+					)
+{
+	const t_mpg_grammar	*g = lr->g;
+	size_t				n;
+	size_t				k;
+
+	n = 0;
+	k = 0;
+	while (k < s->nkernel)
+	{
+		if ((size_t)s->kernel[k].dot < g->prods[s->kernel[k].prod].len)
+			out[n++] = (t_mpg_goto_item){g->prods[s->kernel[k].prod]
+				.rhs[s->kernel[k].dot], s->kernel[k], s->la + k * g->words};
+		++k;
+	}
+	k = 0;
+	while (k <= g->prod_count)
+	{
+		if (lr->cl_in[k] && g->prods[k].len > 0)
+			out[n++] = (t_mpg_goto_item){g->prods[k].rhs[0],
+				(t_mpg_item){(int)k, 0}, lr->cl_la + k * g->words};
+		++k;
+	}
+	qsort(out, n, sizeof(*out), _goto_cmp);
+	return (n);
+}
+
+/**
+ * @brief Create or update the target of the goto on items[0..n).
+ *
+ * @return Target state.
+ */
+static int	_goto(
+				t_mpg_lr *lr,
+				const t_mpg_goto_item *items,
+				size_t n
+				)
+{
+	const size_t	words = lr->g->words;
+	t_mpg_item		*kernel;
+	t_mpg_word		*la;
+	size_t			k;
+	int				target;
+
+	kernel = mpg_xcalloc(n * sizeof(*kernel));
+	la = mpg_xcalloc(n * words * sizeof(*la));
+	k = 0;
+	while (k < n)
+	{
+		kernel[k] = (t_mpg_item){items[k].item.prod, items[k].item.dot + 1};
+		memcpy(la + k * words, items[k].la, words * sizeof(*la));
+		++k;
+	}
+	target = _find(lr, kernel, la, n);
+	if (target < 0)
+		return (_add(lr, kernel, la, n));
+	k = 0;
+	while (k < n * words)
+	{
+		if ((lr->states[target].la[k] | la[k]) != lr->states[target].la[k])
+			lr->states[target].dirty = 1;
+		lr->states[target].la[k] |= la[k];
+		++k;
+	}
+	free(kernel);
+	free(la);
+	return (target);
+}
+
+/**
+ * @brief Compute every goto of a state.
+ */
+static void	_process(
+				t_mpg_lr *lr,
+				int state,
+				t_mpg_goto_item *items
+				)
+{
+	size_t	n;
+	size_t	k;
+	size_t	end;
+	int		target;
+
+	mpg_lr_closure(lr, lr->states + state);
+	n = _goto_items(lr, lr->states + state, items);
+	k = 0;
+	while (k < n)
+	{
+		end = k;
+		while (end < n && items[end].sym == items[k].sym)
+			++end;
+		target = _goto(lr, items + k, end - k);
+		lr->states[state].trans[items[k].sym] = target;
+		k = end;
+	}
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Link the productions of each left hand side.
+ */
+static void	_index_prods(
+				t_mpg_lr *lr
+				)
+{
+	const t_mpg_grammar	*g = lr->g;
+	int					k;
+
+	lr->phead = mpg_xcalloc(g->sym_count * sizeof(*lr->phead));
+	lr->pnext = mpg_xcalloc((g->prod_count + 1) * sizeof(*lr->pnext));
+	k = 0;
+	while ((size_t)k < g->sym_count)
+		lr->phead[k++] = -1;
+	k = (int)g->prod_count;
+	while (k >= 0)
+	{
+		lr->pnext[k] = lr->phead[g->prods[k].lhs];
+		lr->phead[g->prods[k].lhs] = k;
+		--k;
+	}
+}
+
+/**
+ * @brief Build the LALR(1) or canonical LR(1) automaton of a grammar.
+ *
+ * States are processed in creation order, then again while a merge grows
+ * the lookaheads of an already processed state.
+ *
+ * @param lr Automaton to fill.
+ * @param g Grammar.
+ * @param canonical Non zero to keep LR(1) states with different lookaheads.
+ */
+void	mpg_lr_build(
+			t_mpg_lr *lr,
+			const t_mpg_grammar *g,
+			int canonical
+			)
+{
+	t_mpg_goto_item	*items;
+	t_mpg_item		*kernel;
+	t_mpg_word		*la;
+	size_t			k;
+	int				progress;
+
+	*lr = (t_mpg_lr){.g = g, .canonical = canonical};
+	lr->buckets = mpg_xcalloc(MPG_BUCKETS * sizeof(*lr->buckets));
+	memset(lr->buckets, 0xff, MPG_BUCKETS * sizeof(*lr->buckets));
+	lr->cl_la = mpg_xcalloc((g->prod_count + 1) * g->words
+			* sizeof(*lr->cl_la));
+	lr->cl_in = mpg_xcalloc(g->prod_count + 1);
+	lr->scratch = mpg_xcalloc(g->words * sizeof(*lr->scratch));
+	k = 0;
+	progress = 0;
+	while (k <= g->prod_count)
+		progress += g->prods[k++].len + 1;
+	items = mpg_xcalloc(progress * sizeof(*items));
+	_index_prods(lr);
+	kernel = mpg_xcalloc(sizeof(*kernel));
+	la = mpg_xcalloc(g->words * sizeof(*la));
+	*kernel = (t_mpg_item){(int)g->prod_count, 0};
+	MPG_BIT_SET(la, g->token_count - 1);
+	_add(lr, kernel, la, 1);
+	progress = 1;
+	while (progress)
+	{
+		progress = 0;
+		k = 0;
+		while (k < lr->count)
+		{
+			if (lr->states[k].dirty)
+			{
+				lr->states[k].dirty = 0;
+				_process(lr, (int)k, items);
+				progress = 1;
+			}
+			++k;
+		}
+	}
+	free(items);
+}
+
+/**
+ * @brief Free an automaton.
+ *
+ * @param lr Automaton to free.
+ */
+void	mpg_lr_free(
+			t_mpg_lr *lr
+			)
+{
+	size_t	k;
+
+	k = 0;
+	while (k < lr->count)
+	{
+		free(lr->states[k].kernel);
+		free(lr->states[k].la);
+		free(lr->states[k++].trans);
+	}
+	free(lr->states);
+	free(lr->buckets);
+	free(lr->phead);
+	free(lr->pnext);
+	free(lr->cl_la);
+	free(lr->cl_in);
+	free(lr->scratch);
+	*lr = (t_mpg_lr){0};
+}
@@ -0,0 +1,412 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   main.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:52:38 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 14:52:38 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file main.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief mp-gen entry point.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mp_gen.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Helpers.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Merge a bitset into another.
+ *
+ * @param dst Destination set.
+ * @param src Source set.
+ * @param words Number of words.
+ * @return Non zero if dst grew.
+ */
+int	mpg_bits_or(
+		t_mpg_word *dst,
+		const t_mpg_word *src,
+		size_t words
+		)
+{
+	t_mpg_word	grown;
+
+	grown = 0;
+	while (words-- != 0)
+	{
+		grown |= src[words] & ~dst[words];
+		dst[words] |= src[words];
+	}
+	return (grown != 0);
+}
+
+/**
+ * @brief Allocate or die.
+ *
+ * @param size Size in bytes, zero filled.
+ * @return The block, never NULL.
+ */
+void	*mpg_xcalloc(
+			size_t size
+			)
+{
+	void	*p;
+
+	p = calloc(1, size + (size == 0));
+	if (p == NULL)
+	{
+		perror("mp-gen");
+		exit(EXIT_FAILURE);
+	}
+	return (p);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Options.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Print the usage and exit.
+ */
+static void	_usage(
+				int status
+				)
+{
+	fprintf(stderr,
+		"Usage: mp-gen [OPTION]... GRAMMAR\n"
+		"Generate microparser tables from a grammar file.\n"
+		"  -o FILE   write the C header to FILE (default: stdout)\n"
+		"  -p NAME   prefix of generated identifiers (default: grammar name)\n"
+		"  -b FILE   also write the tables to a binary grammar file\n"
+		"  -s FILE   report the reductions per token of a sample corpus\n"
+		"  --profile FILE  write the table hits of the sample to FILE\n"
+		"  --hot     renumber states and token columns by the sample hits\n"
+		"  --classes share one action column between tokens that behave "
+		"the same\n"
+		"  --lr1     build canonical LR(1) tables instead of LALR(1)\n"
+		"  --dense   emit dense tables instead of comb vectors\n"
+		"  --direct  emit a direct-coded engine instead of tables\n"
+		"  --replay TRACE  print the parser trace TRACE as a folded flame "
+		"graph\n"
+		"  -v        print statistics on stderr\n");
+	exit(status);
+}
+
+/**
+ * @brief Derive the default prefix from the grammar file name.
+ */
+static char	*_prefix(
+				const char *path
+				)
+{
+	const char	*base;
+	char		*prefix;
+	size_t		k;
+
+	base = strrchr(path, '/');
+	if (base == NULL)
+		base = path;
+	else
+		++base;
+	prefix = strdup(base);
+	if (prefix == NULL)
+		exit(EXIT_FAILURE);
+	if (strchr(prefix, '.') != NULL)
+		*strchr(prefix, '.') = '\0';
+	k = 0;
+	while (prefix[k] != '\0')
+	{
+		if (!isalnum((unsigned char)prefix[k]))
+			prefix[k] = '_';
+		++k;
+	}
+	return (prefix);
+}
+
+/**
+ * @brief Duplicate a prefix in upper case.
+ */
+static char	*_upper_dup(
+				const char *prefix
+				)
+{
+	char	*upper;
+	size_t	k;
+
+	upper = strdup(prefix);
+	if (upper == NULL)
+		exit(EXIT_FAILURE);
+	k = 0;
+	while (upper[k] != '\0')
+	{
+		upper[k] = toupper((unsigned char)upper[k]);
+		++k;
+	}
+	return (upper);
+}
+
+/**
+ * @brief Parse the command line.
+ */
+static void	_opts(
+				t_mpg_opts *opts,
+				int argc,
+				char **argv
+				)
+{
+	int	k;
+
+	k = 1;
+	while (k < argc)
+	{
+		if (strcmp(argv[k], "-o") == 0 && k + 1 < argc)
+			opts->output = argv[++k];
+		else if (strcmp(argv[k], "-p") == 0 && k + 1 < argc)
+			opts->prefix = argv[++k];
+		else if (strcmp(argv[k], "-b") == 0 && k + 1 < argc)
+			opts->binary = argv[++k];
+		else if (strcmp(argv[k], "-s") == 0 && k + 1 < argc)
+			opts->sample = argv[++k];
+		else if (strcmp(argv[k], "--profile") == 0 && k + 1 < argc)
+			opts->profile = argv[++k];
+		else if (strcmp(argv[k], "--replay") == 0 && k + 1 < argc)
+			opts->replay = argv[++k];
+		else if (strcmp(argv[k], "--hot") == 0)
+			opts->hot = 1;
+		else if (strcmp(argv[k], "--classes") == 0)
+			opts->classes = 1;
+		else if (strcmp(argv[k], "--lr1") == 0)
+			opts->canonical = 1;
+		else if (strcmp(argv[k], "--dense") == 0)
+			opts->dense = 1;
+		else if (strcmp(argv[k], "--direct") == 0)
+			opts->direct = 1;
+		else if (strcmp(argv[k], "-v") == 0)
+			opts->verbose = 1;
+		else if (strcmp(argv[k], "-h") == 0 || strcmp(argv[k], "--help") == 0)
+			_usage(EXIT_SUCCESS);
+		else if (argv[k][0] == '-' || opts->input != NULL)
+			_usage(EXIT_FAILURE);
+		else
+			opts->input = argv[k];
+		++k;
+	}
+	if (opts->input == NULL || ((opts->hot || opts->profile != NULL)
+			&& opts->sample == NULL)
+		|| ((opts->hot || opts->classes) && opts->direct))
+		_usage(EXIT_FAILURE);
+}
+
+/**
+ * @brief Print table statistics on stderr.
+ */
+static void	_stats(
+				const t_mpg_tables *t
+				)
+{
+	const t_lr_grammar		*c = &t->tables;
+	const size_t			dense = c->state_count * (lr_grammar_columns(c)
+			* sizeof(t_lr_packed_action) + c->prod_count
+			* sizeof(t_lr_state_id));
+	const size_t			comb = c->state_count * (sizeof(size_t)
+			+ sizeof(t_lr_packed_action)) + c->action_comb->size
+		* (sizeof(t_lr_packed_action) + sizeof(t_lr_token_id))
+		+ c->prod_count * (sizeof(size_t) + sizeof(t_lr_state_id))
+		+ c->goto_comb->size * 2 * sizeof(t_lr_state_id);
+	size_t					defaults;
+	size_t					k;
+
+	defaults = 0;
+	k = 0;
+	while (k < c->state_count)
+		defaults += c->default_reduce[k++] != LR_PROD_NONE;
+	fprintf(stderr, "mp-gen: %zu tokens in %zu action columns, %zu productions,"
+		" %zu states\nmp-gen: %zu shift/reduce, %zu reduce/reduce conflicts\n"
+		"mp-gen: dense tables %zu bytes, comb tables %zu bytes\n"
+		"mp-gen: %zu states with a default reduction\n",
+		c->token_count, lr_grammar_columns(c), c->prod_count, c->state_count,
+		t->sr_conflicts,
+		t->rr_conflicts, dense, comb, defaults);
+}
+
+/**
+ * @brief Write the tables to the binary grammar file of the options.
+ *
+ * The file holds this build's ID widths, so only programs built with the
+ * same widths can map it.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+static int	_save(
+				const t_mpg_opts *opts,
+				const t_mpg_grammar *g,
+				const t_mpg_tables *t
+				)
+{
+	t_lr_grammar	tables;
+	t_lr_prod_cb	*prod_cb;
+	t_lr_error		err;
+
+	prod_cb = mpg_prod_sizes(g);
+	tables = t->tables;
+	tables.prod_cb = prod_cb;
+	if (opts->dense)
+	{
+		tables.action_comb = NULL;
+		tables.goto_comb = NULL;
+	}
+	err = lr_grammar_save(&tables, opts->binary);
+	free(prod_cb);
+	if (err == LR_OK)
+		return (0);
+	fprintf(stderr, "mp-gen: %s: cannot write the grammar file\n",
+		opts->binary);
+	return (-1);
+}
+
+/**
+ * @brief Profile the tables on the sample, then write or apply the hits.
+ *
+ * @return 0 on success, -1 on failure (reported on stderr).
+ */
+static int	_profile(
+				const t_mpg_opts *opts,
+				const t_mpg_grammar *g,
+				t_mpg_tables *t
+				)
+{
+	t_mpg_profile	p;
+	int				ret;
+
+	if (opts->profile == NULL && !opts->hot)
+		return (0);
+	if (mpg_profile(&p, g, t, opts->sample) < 0)
+		return (-1);
+	ret = 0;
+	if (opts->profile != NULL)
+		ret = mpg_profile_write(&p, g, t, opts->profile);
+	if (ret == 0 && opts->hot && mpg_tables_renumber(t, &p) < 0)
+	{
+		fprintf(stderr, "mp-gen: tables do not fit\n");
+		ret = -1;
+	}
+	mpg_profile_free(&p);
+	return (ret);
+}
+
+/**
+ * @brief Print the tables, or the folded flame graph of the trace to replay.
+ *
+ * @return EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int	_output(
+				FILE *out,
+				const t_mpg_opts *opts,
+				const t_mpg_grammar *g,
+				const t_mpg_tables *t
+				)
+{
+	if (opts->replay == NULL)
+		mpg_emit(out, opts, g, t);
+	else if (mpg_replay(out, g, t, opts->replay) < 0)
+		return (EXIT_FAILURE);
+	return (EXIT_SUCCESS);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Entry point.                                                           * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Load, build and emit the tables described by opts.
+ *
+ * @return EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int	_run(
+				t_mpg_opts *opts
+				)
+{
+	t_mpg_grammar	g;
+	t_mpg_lr		lr;
+	t_mpg_tables	t;
+	FILE			*out;
+	int				ret;
+
+	if (mpg_grammar_load(&g, opts->input) < 0)
+		return (EXIT_FAILURE);
+	mpg_lr_build(&lr, &g, opts->canonical);
+	ret = EXIT_FAILURE;
+	out = NULL;
+	if (mpg_tables_build(&t, &lr) < 0)
+		fprintf(stderr, "mp-gen: tables do not fit\n");
+	else if (_profile(opts, &g, &t) < 0
+		|| (opts->classes && mpg_tables_classes(&t) < 0))
+		mpg_tables_free(&t);
+	else
+	{
+		if (opts->verbose || t.sr_conflicts != 0 || t.rr_conflicts != 0)
+			_stats(&t);
+		out = stdout;
+		if (opts->output != NULL)
+			out = fopen(opts->output, "w");
+		if (out == NULL)
+			perror(opts->output);
+		else if ((opts->sample == NULL || mpg_sample(&g, &t, opts->sample) == 0)
+			&& (opts->binary == NULL || _save(opts, &g, &t) == 0))
+			ret = _output(out, opts, &g, &t);
+		mpg_tables_free(&t);
+	}
+	if (out != NULL && out != stdout)
+		fclose(out);
+	mpg_lr_free(&lr);
+	mpg_grammar_free(&g);
+	return (ret);
+}
+
+int	main(
+		int argc,
+		char **argv
+		)
+{
+	t_mpg_opts		opts;
+	char			*prefix;
+	int				ret;
+
+	opts = (t_mpg_opts){0};
+	_opts(&opts, argc, argv);
+	prefix = NULL;
+	if (opts.prefix == NULL)
+		prefix = _prefix(opts.input);
+	if (opts.prefix == NULL)
+		opts.prefix = prefix;
+	opts.upper = _upper_dup(opts.prefix);
+	ret = _run(&opts);
+	free(opts.upper);
+	free(prefix);
+	return (ret);
+}
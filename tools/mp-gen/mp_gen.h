@@ -0,0 +1,469 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mp_gen.h                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 12:04:33 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 12:04:33 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file mp_gen.h
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief The LALR(1) / LR(1) table generator definition.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef MP_GEN_H
+# define MP_GEN_H
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+# include <stddef.h>
+# include <stdint.h>
+# include <stdio.h>
+
+# include "lr_parser.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Word of a terminal bitset.
+ */
+typedef uint64_t	t_mpg_word;
+
+/**
+ * @brief Grammar symbol.
+ *
+ * Terminals are numbered first, in declaration order, followed by the
+ * implicit end of input terminal, the nonterminals in definition order and
+ * the augmented start symbol.
+ */
+typedef struct s_mpg_symbol
+{
+	char	*name;		/**< Symbol name. */
+	int		is_token;	/**< Non zero for terminals. */
+	int		line;		/**< Line of the declaration or first use. */
+}	t_mpg_symbol;
+
+/**
+ * @brief Grammar production.
+ */
+typedef struct s_mpg_prod
+{
+	int		lhs;	/**< Left hand side nonterminal. */
+	int		*rhs;	/**< Right hand side symbols. */
+	size_t	len;	/**< Number of right hand side symbols. */
+	int		alt;	/**< Index among the productions of the same lhs. */
+	int		line;	/**< Line of the production in the grammar file. */
+}	t_mpg_prod;
+
+/**
+ * @brief Grammar loaded from a grammar file, with its FIRST sets.
+ */
+typedef struct s_mpg_grammar
+{
+	t_mpg_symbol	*syms;			/**< Symbols, terminals first. */
+	size_t			sym_count;		/**< Number of symbols. */
+	size_t			token_count;	/**< Terminals, end of input included. */
+	t_mpg_prod		*prods;			/**< Productions, augmented one last. */
+	size_t			prod_count;		/**< Productions, augmented one excluded. */
+	int				start;			/**< Start nonterminal. */
+	size_t			words;			/**< Words in a terminal bitset. */
+	t_mpg_word		*first;			/**< FIRST set of each symbol. */
+	char			*nullable;		/**< Nullable flag of each symbol. */
+}	t_mpg_grammar;
+
+/**
+ * @brief LR(0) item, a production with a dot position.
+ */
+typedef struct s_mpg_item
+{
+	int	prod;	/**< Production. */
+	int	dot;	/**< Number of right hand side symbols before the dot. */
+}	t_mpg_item;
+
+/**
+ * @brief Automaton state, a kernel of LR(1) items.
+ */
+typedef struct s_mpg_state
+{
+	t_mpg_item		*kernel;	/**< Kernel items sorted by prod and dot. */
+	t_mpg_word		*la;		/**< Lookahead set of each kernel item. */
+	size_t			nkernel;	/**< Number of kernel items. */
+	unsigned long	hash;		/**< Hash of the state key. */
+	int				*trans;		/**< Target state per symbol, -1 if none. */
+	int				dirty;		/**< Non zero while its gotos are stale. */
+	int				hnext;		/**< Next state in the same hash bucket. */
+}	t_mpg_state;
+
+/**
+ * @brief LR automaton under construction.
+ */
+typedef struct s_mpg_lr
+{
+	const t_mpg_grammar	*g;			/**< Grammar. */
+	int					canonical;	/**< Non zero for canonical LR(1). */
+	t_mpg_state			*states;	/**< States. */
+	size_t				count;		/**< Number of states. */
+	size_t				alloced;	/**< Capacity of states. */
+	int					*buckets;	/**< Hash buckets heads. */
+	int					*phead;		/**< First production of each symbol. */
+	int					*pnext;		/**< Next production of the same lhs. */
+	t_mpg_word			*cl_la;		/**< Closure lookaheads per prod. */
+	char				*cl_in;		/**< Closure membership per prod. */
+	t_mpg_word			*scratch;	/**< One scratch terminal set. */
+}	t_mpg_lr;
+
+/**
+ * @brief Generated parse tables.
+ */
+typedef struct s_mpg_tables
+{
+	t_lr_grammar	tables;			/**< Dense and compressed tables. */
+	size_t			sr_conflicts;	/**< Shift/reduce conflicts. */
+	size_t			rr_conflicts;	/**< Reduce/reduce conflicts. */
+}	t_mpg_tables;
+
+/**
+ * @brief Lookup hits of the tables over a sample corpus.
+ */
+typedef struct s_mpg_profile
+{
+	size_t	*state_token;	/**< Action lookups per state and token. */
+	size_t	*state_prod;	/**< Goto lookups per state and production. */
+}	t_mpg_profile;
+
+/**
+ * @brief Generator options.
+ */
+typedef struct s_mpg_opts
+{
+	const char	*input;		/**< Grammar file. */
+	const char	*output;	/**< Output file, NULL for stdout. */
+	const char	*prefix;	/**< Prefix of the generated identifiers. */
+	const char	*binary;	/**< Grammar file to write, or NULL. */
+	const char	*sample;	/**< Sample corpus to report on, or NULL. */
+	const char	*profile;	/**< Profile of the sample to write, or NULL. */
+	const char	*replay;	/**< Trace to replay instead of emitting, or NULL. */
+	char		*upper;		/**< Prefix in upper case, for macros. */
+	int			canonical;	/**< Build canonical LR(1) tables. */
+	int			dense;		/**< Emit dense tables instead of combs. */
+	int			direct;		/**< Emit a direct-coded engine. */
+	int			hot;		/**< Renumber by the hits of the sample. */
+	int			classes;	/**< Merge tokens with the same actions. */
+	int			verbose;	/**< Print statistics on stderr. */
+}	t_mpg_opts;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Function prototypes.                                                   * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Load a grammar file and compute its FIRST sets.
+ *
+ * @param g Grammar to fill.
+ * @param path Path of the grammar file.
+ * @return 0 on success, -1 on error (reported on stderr).
+ */
+int		mpg_grammar_load(
+			t_mpg_grammar *g,
+			const char *path
+			);
+
+/**
+ * @brief Free a grammar.
+ *
+ * @param g Grammar to free.
+ */
+void	mpg_grammar_free(
+			t_mpg_grammar *g
+			);
+
+/**
+ * @brief Build production callbacks holding only the production sizes.
+ *
+ * @param g Grammar.
+ * @return The callbacks, to free, never NULL.
+ */
+t_lr_prod_cb	*mpg_prod_sizes(
+					const t_mpg_grammar *g
+					);
+
+/**
+ * @brief Build the LALR(1) or canonical LR(1) automaton of a grammar.
+ *
+ * LALR(1) states are merged on the fly: a goto whose core matches an
+ * existing state adds its lookaheads to it, and the state is processed
+ * again until no lookahead set grows.
+ *
+ * @param lr Automaton to fill.
+ * @param g Grammar.
+ * @param canonical Non zero to keep LR(1) states with different lookaheads.
+ */
+void	mpg_lr_build(
+			t_mpg_lr *lr,
+			const t_mpg_grammar *g,
+			int canonical
+			);
+
+/**
+ * @brief Compute the closure of a state into the automaton scratch sets.
+ *
+ * @param lr Automaton.
+ * @param s State.
+ */
+void	mpg_lr_closure(
+			t_mpg_lr *lr,
+			const t_mpg_state *s
+			);
+
+/**
+ * @brief Free an automaton.
+ *
+ * @param lr Automaton to free.
+ */
+void	mpg_lr_free(
+			t_mpg_lr *lr
+			);
+
+/**
+ * @brief Build the action and goto tables of an automaton.
+ *
+ * Conflicts are reported on stderr and resolved like yacc: shift wins over
+ * reduce, the earlier production wins between reductions.
+ *
+ * @param t Tables to fill.
+ * @param lr Automaton.
+ * @return 0 on success, -1 on allocation failure.
+ */
+int		mpg_tables_build(
+			t_mpg_tables *t,
+			t_mpg_lr *lr
+			);
+
+/**
+ * @brief Renumber the states and tokens of the tables by their hits.
+ *
+ * State 0 stays first, the other states are sorted by action and goto hits
+ * and the token columns by action hits, hottest first, so the rows and
+ * columns a parse reads most share cache lines. Token IDs are kept: the
+ * tables get a token_map from each ID to its column.
+ *
+ * @param t Tables, with their dense tables.
+ * @param p Hits counted on these tables.
+ * @return 0 on success, -1 if the tables cannot be compressed.
+ */
+int		mpg_tables_renumber(
+			t_mpg_tables *t,
+			const t_mpg_profile *p
+			);
+
+/**
+ * @brief Merge the token columns that hold the same actions in every state.
+ *
+ * Tokens of a class share an action column, token_map giving the column of
+ * each token ID, which callers keep.
+ *
+ * @param t Tables, with their dense tables.
+ * @return 0 on success, -1 if the tables cannot be compressed.
+ */
+int		mpg_tables_classes(
+			t_mpg_tables *t
+			);
+
+/**
+ * @brief Free generated tables.
+ *
+ * @param t Tables to free.
+ */
+void	mpg_tables_free(
+			t_mpg_tables *t
+			);
+
+/**
+ * @brief Emit the tables as a C header.
+ *
+ * @param out Output stream.
+ * @param opts Generator options.
+ * @param g Grammar.
+ * @param t Tables.
+ */
+void	mpg_emit(
+			FILE *out,
+			const t_mpg_opts *opts,
+			const t_mpg_grammar *g,
+			const t_mpg_tables *t
+			);
+
+/**
+ * @brief Emit a direct-coded engine and its NAME_TABLES initializer.
+ *
+ * @param out Output stream.
+ * @param opts Generator options.
+ * @param g Grammar.
+ * @param t Tables.
+ */
+void	mpg_emit_direct(
+			FILE *out,
+			const t_mpg_opts *opts,
+			const t_mpg_grammar *g,
+			const t_mpg_tables *t
+			);
+
+/**
+ * @brief Report the reductions per token of a sample corpus on stderr.
+ *
+ * Compares the generated tables with the ones lr_units_build rewrites when
+ * no unit production has a callback, keeping what callbacks see, and with
+ * LR_UNITS_BYPASS_ALL.
+ *
+ * @param g Grammar.
+ * @param t Tables.
+ * @param path Corpus, a sentence of token names per line.
+ * @return 0 on success, -1 on error (reported on stderr).
+ */
+int		mpg_sample(
+			const t_mpg_grammar *g,
+			const t_mpg_tables *t,
+			const char *path
+			);
+
+/**
+ * @brief Count the action and goto lookups of the tables over a corpus.
+ *
+ * @param p Profile to fill, freed with mpg_profile_free.
+ * @param g Grammar.
+ * @param t Tables.
+ * @param path Corpus, as for mpg_sample.
+ * @return 0 on success, -1 on error (reported on stderr).
+ */
+int		mpg_profile(
+			t_mpg_profile *p,
+			const t_mpg_grammar *g,
+			const t_mpg_tables *t,
+			const char *path
+			);
+
+/**
+ * @brief Write the non-zero hits of a profile as text.
+ *
+ * @param p Profile.
+ * @param g Grammar.
+ * @param t Tables the profile was counted on.
+ * @param path Output file.
+ * @return 0 on success, -1 on error (reported on stderr).
+ */
+int		mpg_profile_write(
+			const t_mpg_profile *p,
+			const t_mpg_grammar *g,
+			const t_mpg_tables *t,
+			const char *path
+			);
+
+/**
+ * @brief Free a profile.
+ *
+ * @param p Profile.
+ */
+void	mpg_profile_free(
+			t_mpg_profile *p
+			);
+
+/**
+ * @brief Replay a parser trace against the tables as a folded flame graph.
+ *
+ * @param out Output stream.
+ * @param g Grammar.
+ * @param t Tables the trace was recorded with.
+ * @param path Trace saved by lr_trace_save.
+ * @return 0 on success, -1 on error (reported on stderr).
+ */
+int		mpg_replay(
+			FILE *out,
+			const t_mpg_grammar *g,
+			const t_mpg_tables *t,
+			const char *path
+			);
+
+/**
+ * @brief Print a name in upper case.
+ *
+ * @param out Output stream.
+ * @param name Name to print.
+ */
+void	mpg_put_upper(
+			FILE *out,
+			const char *name
+			);
+
+/**
+ * @brief Print an array element, wrapping lines before 80 columns.
+ *
+ * @param out Output stream.
+ * @param text Element text.
+ * @param col Current column, 0 before the first element.
+ */
+void	mpg_put_elem(
+			FILE *out,
+			const char *text,
+			size_t *col
+			);
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Bitset helpers.                                                        * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Test a bit of a terminal bitset.
+ */
+# define MPG_BIT_TEST(set, bit)	\
+	(((set)[(bit) / 64] >> ((bit) % 64)) & 1)
+
+/**
+ * @brief Set a bit of a terminal bitset.
+ */
+# define MPG_BIT_SET(set, bit)	\
+	((set)[(bit) / 64] |= (t_mpg_word)1 << ((bit) % 64))
+
+/**
+ * @brief Merge a bitset into another.
+ *
+ * @param dst Destination set.
+ * @param src Source set.
+ * @param words Number of words.
+ * @return Non zero if dst grew.
+ */
+int		mpg_bits_or(
+			t_mpg_word *dst,
+			const t_mpg_word *src,
+			size_t words
+			);
+
+/**
+ * @brief Allocate or die.
+ *
+ * @param size Size in bytes, zero filled.
+ * @return The block, never NULL.
+ */
+void	*mpg_xcalloc(
+			size_t size
+			);
+
+#endif
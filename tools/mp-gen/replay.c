@@ -0,0 +1,480 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   replay.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:24:51 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/18 00:24:51 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file replay.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Trace replay into a folded flame graph.
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mp_gen.h"
+
+#include "lr_io.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Defines.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Symbol of the frame of an accept record.
+ */
+#define MPG_ACCEPT	-1
+
+/**
+ * @brief Symbol of the frame of a syntax error record.
+ */
+#define MPG_ERROR	-2
+
+/**
+ * @brief Frame of the parse being replayed, a shifted token or a reduction.
+ */
+typedef struct s_mpg_frame
+{
+	int			sym;	/**< Symbol, MPG_ACCEPT or MPG_ERROR. */
+	int			parent;	/**< Frame of the reduction that popped it, or -1. */
+	int			path;	/**< Path of the frame, set when flushed. */
+	uint64_t	cost;	/**< Cost of its record. */
+}	t_mpg_frame;
+
+/**
+ * @brief Node of the path trie, a frame symbol under its parent path.
+ */
+typedef struct s_mpg_path
+{
+	int			sym;	/**< Symbol of the last frame. */
+	int			parent;	/**< Parent path, -1 for a root. */
+	uint64_t	cost;	/**< Self cost of the frames on this path. */
+}	t_mpg_path;
+
+/**
+ * @brief Replay of a trace.
+ */
+typedef struct s_mpg_replay
+{
+	const t_mpg_grammar	*g;				/**< Grammar. */
+	const t_lr_grammar	*tables;		/**< Tables to check the trace on. */
+	const char			*where;			/**< Trace file, for the messages. */
+	t_mpg_frame			*frames;		/**< Frames of the current parse. */
+	size_t				count;			/**< Number of frames. */
+	size_t				alloced;		/**< Capacity of frames. */
+	int					*stack;			/**< Frames on the parse stack. */
+	size_t				used;			/**< Depth of the parse stack. */
+	size_t				salloced;		/**< Capacity of stack. */
+	t_mpg_path			*paths;			/**< Path trie. */
+	size_t				path_count;		/**< Number of paths. */
+	size_t				path_alloced;	/**< Capacity of paths. */
+	int					*buckets;		/**< Path hash table, -1 if empty. */
+	size_t				mask;			/**< Number of buckets minus one. */
+	size_t				parses;			/**< Accept records. */
+	size_t				errors;			/**< Syntax error records. */
+	size_t				mismatches;		/**< Records the tables disagree with. */
+}	t_mpg_replay;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Paths.                                                                 * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Double the capacity of an array.
+ */
+static void	_grow(
+				void **array,
+				size_t *alloced,
+				size_t size
+				)
+{
+	void	*grown;
+
+	grown = mpg_xcalloc(*alloced * 2 * size);
+	memcpy(grown, *array, *alloced * size);
+	free(*array);
+	*array = grown;
+	*alloced *= 2;
+}
+
+/**
+ * @brief First bucket of a path.
+ */
+static size_t	_hash(
+					const t_mpg_replay *r,
+					int parent,
+					int sym
+					)
+{
+	uint64_t	h;
+
+	h = ((uint64_t)(uint32_t)parent << 32 | (uint32_t)sym)
+		* 0x9e3779b97f4a7c15u;
+	return ((size_t)(h >> 32) & r->mask);
+}
+
+/**
+ * @brief Double the path hash table.
+ */
+static void	_rehash(
+				t_mpg_replay *r
+				)
+{
+	size_t	h;
+	size_t	k;
+
+	free(r->buckets);
+	r->mask = r->mask << 1 | 1;
+	r->buckets = mpg_xcalloc((r->mask + 1) * sizeof(*r->buckets));
+	memset(r->buckets, -1, (r->mask + 1) * sizeof(*r->buckets));
+	k = 0;
+	while (k < r->path_count)
+	{
+		h = _hash(r, r->paths[k].parent, r->paths[k].sym);
+		while (r->buckets[h] >= 0)
+			h = (h + 1) & r->mask;
+		r->buckets[h] = k++;
+	}
+}
+
+/**
+ * @brief Find or add the path of a symbol under a parent path.
+ */
+static int	_path(
+				t_mpg_replay *r,
+				int parent,
+				int sym
+				)
+{
+	size_t	h;
+	int		path;
+
+	h = _hash(r, parent, sym);
+	while (r->buckets[h] >= 0 && (r->paths[r->buckets[h]].parent != parent
+			|| r->paths[r->buckets[h]].sym != sym))
+		h = (h + 1) & r->mask;
+	if (r->buckets[h] >= 0)
+		return (r->buckets[h]);
+	if (r->path_count == r->path_alloced)
+		_grow((void **)&r->paths, &r->path_alloced, sizeof(*r->paths));
+	path = r->path_count++;
+	r->paths[path] = (t_mpg_path){.sym = sym, .parent = parent};
+	r->buckets[h] = path;
+	if (r->path_count * 2 > r->mask + 1)
+		_rehash(r);
+	return (path);
+}
+
+/**
+ * @brief Add the frames of the current parse to the paths.
+ *
+ * A frame is always reduced by a later frame, so walking them backwards
+ * meets every parent before its children. A frame with the symbol of its
+ * parent shares its path, which folds the direct recursions of the grammar.
+ */
+static void	_flush(
+				t_mpg_replay *r
+				)
+{
+	t_mpg_frame	*frame;
+	int			parent;
+	size_t		k;
+
+	k = r->count;
+	while (k-- > 0)
+	{
+		frame = r->frames + k;
+		parent = -1;
+		if (frame->parent >= 0)
+			parent = r->frames[frame->parent].path;
+		if (parent >= 0 && r->paths[parent].sym == frame->sym)
+			frame->path = parent;
+		else
+			frame->path = _path(r, parent, frame->sym);
+		r->paths[frame->path].cost += frame->cost;
+	}
+	r->count = 0;
+	r->used = 0;
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Records.                                                               * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Push a new frame on the parse stack.
+ */
+static void	_frame(
+				t_mpg_replay *r,
+				int sym,
+				uint64_t cost
+				)
+{
+	if (r->count == r->alloced)
+		_grow((void **)&r->frames, &r->alloced, sizeof(*r->frames));
+	if (r->used == r->salloced)
+		_grow((void **)&r->stack, &r->salloced, sizeof(*r->stack));
+	r->frames[r->count] = (t_mpg_frame){.sym = sym, .parent = -1,
+		.cost = cost};
+	r->stack[r->used++] = r->count++;
+}
+
+/**
+ * @brief Check a record against the tables.
+ *
+ * A reduction must be the action of its state on some token, the other
+ * records the action of their state on their token, the end of input for
+ * an accept. A direct-coded engine rejects a token before the default
+ * reduction of its state, which the tables take first.
+ *
+ * @return 0 if the tables agree, -1 otherwise.
+ */
+static int	_check(
+				const t_mpg_replay *r,
+				t_lr_trace_record record
+				)
+{
+	static const t_lr_action_type	expected[] = {ACTION_SHIFT,
+		ACTION_REDUCE, ACTION_ACCEPT, ACTION_ERROR};
+	const t_lr_grammar				*t = r->tables;
+	t_lr_action						action;
+	uint32_t						id;
+	size_t							k;
+
+	id = LR_TRACE_ID(record);
+	if (record.state >= t->state_count)
+		return (-1);
+	if (LR_TRACE_TYPE(record) == LR_TRACE_REDUCE)
+	{
+		k = 0;
+		while (id < t->prod_count && k < t->token_count)
+		{
+			action = lr_grammar_action(t, record.state, k++);
+			if (action.type == ACTION_REDUCE && action.data.reduce_id == id)
+				return (0);
+		}
+		return (-1);
+	}
+	if (LR_TRACE_TYPE(record) == LR_TRACE_ACCEPT)
+		id = t->token_count - 1;
+	if (id >= t->token_count)
+		return (-1);
+	if (LR_TRACE_TYPE(record) == LR_TRACE_ERROR && t->default_reduce != NULL
+		&& t->default_reduce[record.state] != LR_PROD_NONE)
+		return (0);
+	action = lr_grammar_action(t, record.state, id);
+	return (-(action.type != expected[LR_TRACE_TYPE(record)]));
+}
+
+/**
+ * @brief Report the first record the tables disagree with.
+ */
+static void	_mismatch(
+				t_mpg_replay *r,
+				t_lr_trace_record record,
+				size_t k
+				)
+{
+	static const char	*types[] = {"shift", "reduce", "accept", "error"};
+
+	if (r->mismatches++ != 0)
+		return ;
+	fprintf(stderr, "mp-gen: %s: record %zu: %s %u in state %u does not "
+		"match the tables\n", r->where, k, types[LR_TRACE_TYPE(record)],
+		(unsigned)LR_TRACE_ID(record), (unsigned)record.state);
+}
+
+/**
+ * @brief Replay a record on the frames of the current parse.
+ *
+ * A shift pushes a frame for its token, a reduction pops the frames of its
+ * right hand side under a frame for its left hand side, an accept or an
+ * error ends the parse. A trace cut by the ring starts in the middle of a
+ * parse, so a reduction pops what is left. Out of range IDs are skipped.
+ */
+static void	_record(
+				t_mpg_replay *r,
+				t_lr_trace_record record,
+				uint64_t cost
+				)
+{
+	const uint32_t	id = LR_TRACE_ID(record);
+	size_t			len;
+
+	if (LR_TRACE_TYPE(record) == LR_TRACE_REDUCE && id < r->g->prod_count)
+	{
+		len = r->g->prods[id].len;
+		while (len-- > 0 && r->used > 0)
+			r->frames[r->stack[--r->used]].parent = r->count;
+		_frame(r, r->g->prods[id].lhs, cost);
+	}
+	else if (LR_TRACE_TYPE(record) == LR_TRACE_SHIFT
+		&& id < r->g->token_count)
+		_frame(r, id, cost);
+	else if (LR_TRACE_TYPE(record) == LR_TRACE_ACCEPT)
+	{
+		++r->parses;
+		_frame(r, MPG_ACCEPT, cost);
+		_flush(r);
+	}
+	else if (LR_TRACE_TYPE(record) == LR_TRACE_ERROR)
+	{
+		++r->errors;
+		_frame(r, MPG_ERROR, cost);
+		_flush(r);
+	}
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Output.                                                                * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Print a path, its root first.
+ */
+static void	_put_path(
+				FILE *out,
+				const t_mpg_replay *r,
+				int path
+				)
+{
+	const int	sym = r->paths[path].sym;
+
+	if (r->paths[path].parent >= 0)
+	{
+		_put_path(out, r, r->paths[path].parent);
+		fputc(';', out);
+	}
+	if (sym == MPG_ACCEPT)
+		fputs("[accept]", out);
+	else if (sym == MPG_ERROR)
+		fputs("[error]", out);
+	else
+		fputs(r->g->syms[sym].name, out);
+}
+
+/**
+ * @brief Replay every record of a trace, then print the folded paths.
+ */
+static void	_replay(
+				FILE *out,
+				t_mpg_replay *r,
+				const t_lr_trace_view *view
+				)
+{
+	uint64_t	cost;
+	size_t		k;
+	int			first;
+
+	first = 1;
+	k = 0;
+	while (k < view->count)
+	{
+		cost = 1;
+		if (view->tsc != NULL)
+			cost = 0;
+		if (view->tsc != NULL && !first && view->tsc[k] > view->tsc[k - 1])
+			cost = view->tsc[k] - view->tsc[k - 1];
+		first = LR_TRACE_TYPE(view->records[k]) == LR_TRACE_ACCEPT
+			|| LR_TRACE_TYPE(view->records[k]) == LR_TRACE_ERROR;
+		if (_check(r, view->records[k]) < 0)
+			_mismatch(r, view->records[k], k);
+		_record(r, view->records[k++], cost);
+	}
+	_flush(r);
+	k = 0;
+	while (k < r->path_count)
+	{
+		if (r->paths[k].cost != 0)
+		{
+			_put_path(out, r, k);
+			fprintf(out, " %llu\n", (unsigned long long)r->paths[k].cost);
+		}
+		++k;
+	}
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header function.                                                       * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Replay a parser trace against the tables as a folded flame graph.
+ *
+ * Every parse of the trace becomes a tree: shifted tokens are its leaves,
+ * each reduction a node named after its left hand side over the nodes of
+ * its right hand side. With LR_TRACE_TSC a record costs the ticks since
+ * the previous record of its parse, leaving out the time between parses,
+ * otherwise it costs one. The cost of every node is printed as a
+ * "root;...;node cost" line, merged by path. Records are also checked
+ * against the tables, which only hold for a trace of the same grammar
+ * built with the same options, and the mismatches reported on stderr.
+ *
+ * @param out Output stream.
+ * @param g Grammar.
+ * @param t Tables.
+ * @param path Path of the trace saved by lr_trace_save.
+ * @return 0 on success, -1 on error (reported on stderr).
+ */
+int	mpg_replay(
+		FILE *out,
+		const t_mpg_grammar *g,
+		const t_mpg_tables *t,
+		const char *path
+		)
+{
+	t_mpg_replay	r;
+	t_lr_trace_view	view;
+	void			*data;
+	size_t			size;
+
+	size = 0;
+	data = lr_io_map(path, &size);
+	if (data == NULL || lr_trace_view(&view, data, size) != LR_OK)
+	{
+		fprintf(stderr, "mp-gen: %s: not a parser trace\n", path);
+		return (lr_io_unmap(data, size), -1);
+	}
+	r = (t_mpg_replay){.g = g, .tables = &t->tables, .where = path,
+		.alloced = 64, .salloced = 64, .path_alloced = 64, .mask = 127};
+	r.frames = mpg_xcalloc(r.alloced * sizeof(*r.frames));
+	r.stack = mpg_xcalloc(r.salloced * sizeof(*r.stack));
+	r.paths = mpg_xcalloc(r.path_alloced * sizeof(*r.paths));
+	r.buckets = mpg_xcalloc((r.mask + 1) * sizeof(*r.buckets));
+	memset(r.buckets, -1, (r.mask + 1) * sizeof(*r.buckets));
+	_replay(out, &r, &view);
+	fprintf(stderr, "mp-gen: replay: %zu records, %llu dropped, %zu accepted,"
+		" %zu rejected, %zu not matching the tables\n", view.count,
+		(unsigned long long)view.dropped, r.parses, r.errors, r.mismatches);
+	free(r.frames);
+	free(r.stack);
+	free(r.paths);
+	free(r.buckets);
+	lr_io_unmap(data, size);
+	return (0);
+}
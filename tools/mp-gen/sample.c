@@ -0,0 +1,424 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sample.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 21:03:44 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 21:03:44 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file sample.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Sample corpus runs: reduction counts and hit profiles.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mp_gen.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Counters of the sentences of a corpus.
+ */
+typedef struct s_mpg_sample
+{
+	size_t	sentences;	/**< Lines holding tokens. */
+	size_t	rejected;	/**< Sentences rejected by the first tables. */
+	size_t	tokens;		/**< Tokens, end of input excluded. */
+}	t_mpg_sample;
+
+/**
+ * @brief Tables run over a corpus and their counters.
+ */
+typedef struct s_mpg_run
+{
+	const t_lr_grammar	*tables;		/**< Tables to run. */
+	size_t				reductions;		/**< Reductions performed. */
+	t_mpg_profile		*profile;		/**< Hits to count, or NULL. */
+}	t_mpg_run;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Push a state on a growing state stack.
+ */
+static void	_push(
+				t_lr_state_id **stack,
+				size_t *used,
+				size_t *alloced,
+				t_lr_state_id state_id
+				)
+{
+	t_lr_state_id	*grown;
+
+	if (*used == *alloced)
+	{
+		grown = mpg_xcalloc(*alloced * 2 * sizeof(*grown));
+		memcpy(grown, *stack, *used * sizeof(*grown));
+		free(*stack);
+		*stack = grown;
+		*alloced *= 2;
+	}
+	(*stack)[(*used)++] = state_id;
+}
+
+/**
+ * @brief Look up an action, counting the hit.
+ */
+static t_lr_action	_action(
+						t_mpg_run *run,
+						t_lr_state_id state_id,
+						int token_id
+						)
+{
+	if (run->profile != NULL)
+		++run->profile->state_token[state_id * run->tables->token_count
+			+ token_id];
+	return (lr_grammar_action(run->tables, state_id, token_id));
+}
+
+/**
+ * @brief Look up a goto, counting the hit.
+ */
+static t_lr_state_id	_goto(
+							t_mpg_run *run,
+							t_lr_state_id state_id,
+							t_lr_prod_id prod_id
+							)
+{
+	if (run->profile != NULL)
+		++run->profile->state_prod[state_id * run->tables->prod_count
+			+ prod_id];
+	return (lr_grammar_goto(run->tables, state_id, prod_id));
+}
+
+/**
+ * @brief Run the automaton on a sentence, counting its reductions.
+ *
+ * @return 0 if the sentence is accepted, -1 otherwise.
+ */
+static int	_simulate(
+				t_mpg_run *run,
+				const int *tokens,
+				size_t count
+				)
+{
+	const t_lr_prod_cb	*prod_cb = run->tables->prod_cb;
+	t_lr_state_id		*stack;
+	t_lr_action			action;
+	size_t				used;
+	size_t				alloced;
+	size_t				k;
+
+	alloced = 16;
+	stack = mpg_xcalloc(alloced * sizeof(*stack));
+	used = 0;
+	_push(&stack, &used, &alloced, 0);
+	k = 0;
+	action = _action(run, 0, tokens[0]);
+	while ((action.type == ACTION_SHIFT && k < count)
+		|| (action.type == ACTION_REDUCE
+			&& prod_cb[action.data.reduce_id].size < used))
+	{
+		if (action.type == ACTION_SHIFT)
+			_push(&stack, &used, &alloced, action.data.shift_id);
+		if (action.type == ACTION_SHIFT)
+			++k;
+		else
+		{
+			used -= prod_cb[action.data.reduce_id].size;
+			_push(&stack, &used, &alloced, _goto(run, stack[used - 1],
+					action.data.reduce_id));
+			++run->reductions;
+		}
+		action = _action(run, stack[used - 1], tokens[k]);
+	}
+	free(stack);
+	return (-(action.type != ACTION_ACCEPT));
+}
+
+/**
+ * @brief Translate the token names of a line into token IDs.
+ *
+ * @return Number of tokens before the appended end of input, or -1 on an
+ *         unknown name (reported on stderr).
+ */
+static long	_tokens(
+				const t_mpg_grammar *g,
+				char *line,
+				int *tokens,
+				const char *where
+				)
+{
+	char	*name;
+	long	count;
+	size_t	k;
+
+	count = 0;
+	name = strtok(line, " \t\r\n");
+	while (name != NULL)
+	{
+		k = 0;
+		while (k < g->token_count && strcmp(g->syms[k].name, name) != 0)
+			++k;
+		if (k == g->token_count)
+		{
+			fprintf(stderr, "mp-gen: %s: unknown token %s\n", where, name);
+			return (-1);
+		}
+		tokens[count++] = k;
+		name = strtok(NULL, " \t\r\n");
+	}
+	tokens[count] = g->token_count - 1;
+	return (count);
+}
+
+/**
+ * @brief Run tables on every sentence of a corpus.
+ *
+ * Only the first tables count the rejected sentences.
+ *
+ * @return 0 on success, -1 on error (reported on stderr).
+ */
+static int	_corpus(
+				t_mpg_sample *s,
+				const t_mpg_grammar *g,
+				t_mpg_run *runs,
+				size_t run_count,
+				const char *path
+				)
+{
+	char	where[4096];
+	char	*line;
+	size_t	len;
+	int		*tokens;
+	long	count;
+	size_t	lineno;
+	size_t	k;
+	FILE	*in;
+
+	in = fopen(path, "r");
+	if (in == NULL)
+		return (perror(path), -1);
+	line = NULL;
+	len = 0;
+	lineno = 0;
+	count = 0;
+	while (count >= 0 && getline(&line, &len, in) >= 0)
+	{
+		snprintf(where, sizeof(where), "%s:%zu", path, ++lineno);
+		tokens = mpg_xcalloc((strlen(line) / 2 + 2) * sizeof(*tokens));
+		count = _tokens(g, line, tokens, where);
+		if (count > 0)
+		{
+			++s->sentences;
+			s->tokens += count;
+			s->rejected += _simulate(runs, tokens, count) < 0;
+			k = 1;
+			while (k < run_count)
+				_simulate(runs + k++, tokens, count);
+		}
+		free(tokens);
+	}
+	free(line);
+	fclose(in);
+	return (-(count < 0));
+}
+
+/**
+ * @brief Print the name of a production, the lhs and its alternative.
+ */
+static void	_prod_name(
+				FILE *out,
+				const t_mpg_grammar *g,
+				size_t prod
+				)
+{
+	fprintf(out, "%s_%d", g->syms[g->prods[prod].lhs].name,
+		g->prods[prod].alt);
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Report the reductions per token of a sample corpus on stderr.
+ *
+ * The corpus holds a sentence per line, as token names separated by
+ * spaces, without the end of input. Its sentences are parsed with the
+ * generated tables, then with the tables lr_units_build rewrites when no
+ * unit production has a callback, which bounds what it saves at run time:
+ * by default, keeping what callbacks see, then with LR_UNITS_BYPASS_ALL.
+ *
+ * @param g Grammar.
+ * @param t Tables.
+ * @param path Path of the corpus.
+ * @return 0 on success, -1 on error (reported on stderr).
+ */
+int	mpg_sample(
+		const t_mpg_grammar *g,
+		const t_mpg_tables *t,
+		const char *path
+		)
+{
+	t_mpg_sample	s;
+	t_mpg_run		runs[3];
+	t_lr_grammar	tables;
+	t_lr_grammar	units;
+	t_lr_grammar	all;
+	int				ret;
+
+	tables = t->tables;
+	tables.prod_cb = mpg_prod_sizes(g);
+	units = tables;
+	if (lr_units_build(&units, 0) != LR_OK)
+		return (perror("mp-gen"), free((void *)tables.prod_cb), -1);
+	all = tables;
+	if (lr_units_build(&all, LR_UNITS_BYPASS_ALL) != LR_OK)
+		return (perror("mp-gen"), lr_units_destroy(&units),
+			free((void *)tables.prod_cb), -1);
+	runs[0] = (t_mpg_run){.tables = &tables};
+	runs[1] = (t_mpg_run){.tables = &units};
+	runs[2] = (t_mpg_run){.tables = &all};
+	s = (t_mpg_sample){0};
+	ret = _corpus(&s, g, runs, 3, path);
+	if (ret == 0 && s.tokens != 0)
+		fprintf(stderr, "mp-gen: sample: %zu sentences, %zu tokens, "
+			"%zu rejected\nmp-gen: sample: %.3f reductions per token, %.3f "
+			"with unit productions bypassed (%.3f saved), %.3f bypassing "
+			"all (%.3f saved)\n", s.sentences, s.tokens, s.rejected,
+			(double)runs[0].reductions / s.tokens,
+			(double)runs[1].reductions / s.tokens,
+			(double)(runs[0].reductions - runs[1].reductions) / s.tokens,
+			(double)runs[2].reductions / s.tokens,
+			(double)(runs[0].reductions - runs[2].reductions) / s.tokens);
+	lr_units_destroy(&units);
+	lr_units_destroy(&all);
+	free((void *)tables.prod_cb);
+	return (ret);
+}
+
+/**
+ * @brief Count the action and goto lookups of the tables over a corpus.
+ *
+ * @param p Profile to fill, freed with mpg_profile_free.
+ * @param g Grammar.
+ * @param t Tables.
+ * @param path Path of the corpus, as for mpg_sample.
+ * @return 0 on success, -1 on error (reported on stderr).
+ */
+int	mpg_profile(
+		t_mpg_profile *p,
+		const t_mpg_grammar *g,
+		const t_mpg_tables *t,
+		const char *path
+		)
+{
+	t_mpg_sample	s;
+	t_mpg_run		run;
+	t_lr_grammar	tables;
+	int				ret;
+
+	*p = (t_mpg_profile){
+		.state_token = mpg_xcalloc(t->tables.state_count
+			* t->tables.token_count * sizeof(*p->state_token)),
+		.state_prod = mpg_xcalloc(t->tables.state_count
+			* t->tables.prod_count * sizeof(*p->state_prod))};
+	tables = t->tables;
+	tables.prod_cb = mpg_prod_sizes(g);
+	run = (t_mpg_run){.tables = &tables, .profile = p};
+	s = (t_mpg_sample){0};
+	ret = _corpus(&s, g, &run, 1, path);
+	free((void *)tables.prod_cb);
+	if (ret < 0)
+		mpg_profile_free(p);
+	return (ret);
+}
+
+/**
+ * @brief Write the non-zero hits of a profile, in state order.
+ *
+ * Each line reads "action STATE TOKEN HITS" or "goto STATE PROD HITS",
+ * PROD being the left hand side and the alternative of the production.
+ *
+ * @param p Profile.
+ * @param g Grammar.
+ * @param t Tables the profile was counted on.
+ * @param path Output file.
+ * @return 0 on success, -1 on error (reported on stderr).
+ */
+int	mpg_profile_write(
+		const t_mpg_profile *p,
+		const t_mpg_grammar *g,
+		const t_mpg_tables *t,
+		const char *path
+		)
+{
+	FILE	*out;
+	size_t	k;
+
+	out = fopen(path, "w");
+	if (out == NULL)
+		return (perror(path), -1);
+	k = 0;
+	while (k < t->tables.state_count * t->tables.token_count)
+	{
+		if (p->state_token[k] != 0)
+			fprintf(out, "action %zu %s %zu\n", k / t->tables.token_count,
+				g->syms[k % t->tables.token_count].name, p->state_token[k]);
+		++k;
+	}
+	k = 0;
+	while (k < t->tables.state_count * t->tables.prod_count)
+	{
+		if (p->state_prod[k] != 0)
+		{
+			fprintf(out, "goto %zu ", k / t->tables.prod_count);
+			_prod_name(out, g, k % t->tables.prod_count);
+			fprintf(out, " %zu\n", p->state_prod[k]);
+		}
+		++k;
+	}
+	if (fclose(out) != 0)
+		return (perror(path), -1);
+	return (0);
+}
+
+/**
+ * @brief Free a profile.
+ *
+ * @param p Profile.
+ */
+void	mpg_profile_free(
+			t_mpg_profile *p
+			)
+{
+	free(p->state_token);
+	free(p->state_prod);
+	*p = (t_mpg_profile){0};
+}
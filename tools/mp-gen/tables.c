@@ -0,0 +1,400 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tables.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ale-boud <ale-boud@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:40:26 by ale-boud          #+#    #+#             */
+/*   Updated: 2026/10/17 13:40:26 by ale-boud         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file tables.c
+ * @author ale-boud (ale-boud@student.42.fr)
+ * @brief Action and goto tables construction.
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ */
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Includes.                                                              * //
+// *                                                                        * //
+// ************************************************************************** //
+
+#include <stdlib.h>
+
+#include "mp_gen.h"
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Structure definition.                                                  * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Hits of a state or token, to sort them by.
+ */
+typedef struct s_mpg_heat
+{
+	size_t	hits;	/**< Lookups of its row or column. */
+	size_t	id;		/**< Its ID in the generated tables. */
+}	t_mpg_heat;
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Private functions.                                                     * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Store a reduction, resolving conflicts like yacc.
+ */
+static void	_reduce(
+				t_mpg_tables *t,
+				const t_mpg_grammar *g,
+				size_t cell,
+				int prod
+				)
+{
+	t_lr_action *const	action = (t_lr_action *)t->tables.action_table + cell;
+	const size_t		state = cell / g->token_count;
+	const char			*tok = g->syms[cell % g->token_count].name;
+
+	if (prod == (int)g->prod_count)
+		*action = (t_lr_action){.type = ACTION_ACCEPT};
+	else if (action->type == ACTION_SHIFT)
+	{
+		++t->sr_conflicts;
+		fprintf(stderr, "mp-gen: state %zu: shift/reduce conflict on %s "
+			"(rule line %d), shift kept\n", state, tok, g->prods[prod].line);
+	}
+	else if (action->type == ACTION_REDUCE)
+	{
+		++t->rr_conflicts;
+		fprintf(stderr, "mp-gen: state %zu: reduce/reduce conflict on %s "
+			"(rules line %d and %d), first kept\n", state, tok,
+			g->prods[action->data.reduce_id].line, g->prods[prod].line);
+	}
+	else
+		*action = (t_lr_action){.type = ACTION_REDUCE,
+			.data.reduce_id = prod};
+}
+
+/**
+ * @brief Store the reductions of an item on each of its lookaheads.
+ */
+static void	_reduce_item(
+				t_mpg_tables *t,
+				const t_mpg_grammar *g,
+				size_t state,
+				int prod,
+				const t_mpg_word *la
+				)
+{
+	size_t	tok;
+
+	tok = 0;
+	while (tok < g->token_count)
+	{
+		if (MPG_BIT_TEST(la, tok))
+			_reduce(t, g, state * g->token_count + tok, prod);
+		++tok;
+	}
+}
+
+/**
+ * @brief Fill the shifts, gotos and reductions of a state.
+ */
+static void	_fill_state(
+				t_mpg_tables *t,
+				t_mpg_lr *lr,
+				size_t state
+				)
+{
+	const t_mpg_grammar	*g = lr->g;
+	const t_mpg_state	*s = lr->states + state;
+	t_lr_action *const	action = (t_lr_action *)t->tables.action_table;
+	t_lr_state_id *const	gt = (t_lr_state_id *)t->tables.goto_table;
+	size_t				k;
+
+	k = 0;
+	while (k < g->token_count)
+	{
+		if (s->trans[k] >= 0)
+			action[state * g->token_count + k] = (t_lr_action){
+				.type = ACTION_SHIFT, .data.shift_id = s->trans[k]};
+		++k;
+	}
+	k = 0;
+	while (k < g->prod_count)
+	{
+		if (s->trans[g->prods[k].lhs] >= 0)
+			gt[state * g->prod_count + k] = s->trans[g->prods[k].lhs];
+		++k;
+	}
+	mpg_lr_closure(lr, s);
+	k = 0;
+	while (k < s->nkernel)
+	{
+		if ((size_t)s->kernel[k].dot == g->prods[s->kernel[k].prod].len)
+			_reduce_item(t, g, state, s->kernel[k].prod, s->la + k * g->words);
+		++k;
+	}
+	k = 0;
+	while (k < g->prod_count)
+	{
+		if (lr->cl_in[k] && g->prods[k].len == 0)
+			_reduce_item(t, g, state, (int)k, lr->cl_la + k * g->words);
+		++k;
+	}
+}
+
+/**
+ * @brief Build the default reductions, compressed and packed tables.
+ */
+static int	_derive(
+				t_mpg_tables *t
+				)
+{
+	if (lr_defaults_build(&t->tables) != LR_OK
+		|| lr_comb_build(&t->tables) != LR_OK
+		|| lr_pack_build(&t->tables) != LR_OK)
+		return (-1);
+	return (0);
+}
+
+/**
+ * @brief Compare two heats, hottest first then by ID.
+ */
+static int	_heat_cmp(
+				const void *a,
+				const void *b
+				)
+{
+	const t_mpg_heat	*x = a;
+	const t_mpg_heat	*y = b;
+
+	if (x->hits != y->hits)
+		return ((x->hits < y->hits) - (x->hits > y->hits));
+	return ((x->id > y->id) - (x->id < y->id));
+}
+
+/**
+ * @brief Sort IDs by heat, keeping the first fixed ones in place.
+ *
+ * @return The new ID of each ID, to free.
+ */
+static size_t	*_order(
+					t_mpg_heat *heat,
+					size_t count,
+					size_t fixed
+					)
+{
+	size_t	*renum;
+	size_t	k;
+
+	renum = mpg_xcalloc(count * sizeof(*renum));
+	qsort(heat + fixed, count - fixed, sizeof(*heat), _heat_cmp);
+	k = 0;
+	while (k < count)
+	{
+		renum[heat[k].id] = k;
+		++k;
+	}
+	return (renum);
+}
+
+/**
+ * @brief Move the rows and columns of the dense tables to their new IDs.
+ */
+static void	_permute(
+				t_mpg_tables *t,
+				const size_t *state,
+				const size_t *column
+				)
+{
+	const t_lr_grammar	*c = &t->tables;
+	t_lr_action			*action;
+	t_lr_state_id		*gt;
+	t_lr_action			cell;
+	size_t				k;
+
+	action = mpg_xcalloc(c->state_count * c->token_count * sizeof(*action));
+	gt = mpg_xcalloc(c->state_count * c->prod_count * sizeof(*gt) + 1);
+	k = 0;
+	while (k < c->state_count * c->token_count)
+	{
+		cell = c->action_table[k];
+		if (cell.type == ACTION_SHIFT)
+			cell.data.shift_id = state[cell.data.shift_id];
+		action[state[k / c->token_count] * c->token_count
+			+ column[k % c->token_count]] = cell;
+		++k;
+	}
+	k = 0;
+	while (k < c->state_count * c->prod_count)
+	{
+		gt[state[k / c->prod_count] * c->prod_count + k % c->prod_count]
+			= state[c->goto_table[k]];
+		++k;
+	}
+	free((void *)t->tables.action_table);
+	free((void *)t->tables.goto_table);
+	t->tables.action_table = action;
+	t->tables.goto_table = gt;
+}
+
+// ************************************************************************** //
+// *                                                                        * //
+// * Header functions.                                                      * //
+// *                                                                        * //
+// ************************************************************************** //
+
+/**
+ * @brief Build the action and goto tables of an automaton.
+ *
+ * Gotos that the automaton never takes are left to state 0, which no goto
+ * enters: lr_comb_build skips them, so they read as the default goto of
+ * their production. The default reductions of the consistent states are
+ * built along the compressed and packed tables.
+ *
+ * @param t Tables to fill.
+ * @param lr Automaton.
+ * @return 0 on success, -1 if the tables cannot be compressed.
+ */
+int	mpg_tables_build(
+		t_mpg_tables *t,
+		t_mpg_lr *lr
+		)
+{
+	const t_mpg_grammar	*g = lr->g;
+	t_lr_action			*action;
+	size_t				k;
+
+	*t = (t_mpg_tables){0};
+	t->tables.state_count = lr->count;
+	t->tables.token_count = g->token_count;
+	t->tables.prod_count = g->prod_count;
+	action = mpg_xcalloc(lr->count * g->token_count * sizeof(*action));
+	t->tables.goto_table = mpg_xcalloc(lr->count * g->prod_count
+			* sizeof(*t->tables.goto_table) + 1);
+	k = 0;
+	while (k < lr->count * g->token_count)
+		action[k++] = (t_lr_action){.type = ACTION_ERROR};
+	t->tables.action_table = action;
+	k = 0;
+	while (k < lr->count)
+		_fill_state(t, lr, k++);
+	return (_derive(t));
+}
+
+/**
+ * @brief Renumber the states and tokens of the tables by their hits.
+ *
+ * The compressed tables and default reductions are built again from the
+ * renumbered dense tables.
+ *
+ * @param t Tables, with their dense tables.
+ * @param p Hits counted on these tables.
+ * @return 0 on success, -1 if the tables cannot be compressed.
+ */
+int	mpg_tables_renumber(
+		t_mpg_tables *t,
+		const t_mpg_profile *p
+		)
+{
+	const t_lr_grammar	*c = &t->tables;
+	t_mpg_heat			*heat;
+	size_t				*state;
+	size_t				*column;
+	t_lr_token_id		*map;
+	size_t				k;
+
+	heat = mpg_xcalloc((c->state_count + c->token_count) * sizeof(*heat));
+	k = 0;
+	while (k < c->state_count + c->token_count)
+	{
+		heat[k].id = k - c->state_count * (k >= c->state_count);
+		++k;
+	}
+	k = 0;
+	while (k < c->state_count * c->token_count)
+	{
+		heat[k / c->token_count].hits += p->state_token[k];
+		heat[c->state_count + k % c->token_count].hits += p->state_token[k];
+		++k;
+	}
+	k = 0;
+	while (k < c->state_count * c->prod_count)
+	{
+		heat[k / c->prod_count].hits += p->state_prod[k];
+		++k;
+	}
+	state = _order(heat, c->state_count, 1);
+	column = _order(heat + c->state_count, c->token_count, 0);
+	map = mpg_xcalloc(c->token_count * sizeof(*map));
+	k = 0;
+	while (k < c->token_count)
+	{
+		map[k] = column[k];
+		++k;
+	}
+	lr_comb_destroy(&t->tables);
+	lr_pack_destroy(&t->tables);
+	lr_defaults_destroy(&t->tables);
+	_permute(t, state, column);
+	t->tables.token_map = map;
+	t->tables.column_count = c->token_count;
+	free(heat);
+	free(state);
+	free(column);
+	return (_derive(t));
+}
+
+/**
+ * @brief Merge the token columns that hold the same actions in every state.
+ *
+ * Each class keeps the position of its first column, so a renumbering by
+ * hits is preserved. The compressed tables and default reductions are
+ * built again from the narrower dense table.
+ *
+ * @param t Tables, with their dense tables.
+ * @return 0 on success, -1 if the tables cannot be compressed.
+ */
+int	mpg_tables_classes(
+		t_mpg_tables *t
+		)
+{
+	const t_lr_action	*action = t->tables.action_table;
+	const t_lr_token_id	*map = t->tables.token_map;
+
+	lr_comb_destroy(&t->tables);
+	lr_pack_destroy(&t->tables);
+	lr_defaults_destroy(&t->tables);
+	if (lr_classes_build(&t->tables) != LR_OK)
+		return (-1);
+	free((void *)action);
+	free((void *)map);
+	return (_derive(t));
+}
+
+/**
+ * @brief Free generated tables.
+ *
+ * @param t Tables to free.
+ */
+void	mpg_tables_free(
+			t_mpg_tables *t
+			)
+{
+	lr_comb_destroy(&t->tables);
+	lr_pack_destroy(&t->tables);
+	lr_defaults_destroy(&t->tables);
+	free((void *)t->tables.action_table);
+	free((void *)t->tables.goto_table);
+	free((void *)t->tables.token_map);
+	*t = (t_mpg_tables){0};
+}